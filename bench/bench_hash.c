@@ -0,0 +1,214 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <math.h>
+#include <time.h>
+#include "hash.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define BENCH_CYCLES 1
+#else
+#define BENCH_CYCLES 0
+#endif
+
+#define BENCH_BYTES (64 * 1024 * 1024)
+#define BENCH_KEYS 4096
+#define AVALANCHE_KEYS 20000
+#define AVALANCHE_LENGTH 16
+#define BUCKET_BITS 16
+#define SEQUENTIAL_KEYS 1000000
+#define SEQUENTIAL_LENGTH 8
+
+// Every hash is measured through the same signature. OAAT reads up to a NUL
+// rather than taking a length, so every key is made of non-zero bytes and is
+// followed by a NUL, which the length-taking hashes never look at.
+struct Hash {
+    const char* name;
+    int bits;
+    uint64_t (*hash)(const uint8_t* key, size_t length);
+};
+
+uint64_t seed0;
+uint64_t seed1;
+
+uint64_t hash_oaat(const uint8_t* key, size_t length) {
+    (void) length;
+    return OAAT((const char*) key);
+}
+
+uint64_t hash_sip64(const uint8_t* key, size_t length) {
+    return SIP64(key, length, seed0, seed1);
+}
+
+struct Hash hashes[] = {
+    {"OAAT", 32, hash_oaat},
+    {"SIP64", 64, hash_sip64},
+};
+
+volatile uint64_t sink;
+
+static double seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t cycles(void) {
+#if BENCH_CYCLES
+    return __rdtsc();
+#else
+    return 0;
+#endif
+}
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Fills a key with random non-zero bytes and terminates it.
+static void random_key(uint8_t* key, size_t length, uint64_t* state) {
+    for (size_t i = 0; i < length; i++) {key[i] = 1 + next_random(state) % 255;}
+    key[length] = '\0';
+}
+
+// Writes an integer as a key of non-zero bytes, seven bits to a byte with the low bits first,
+// so consecutive integers give keys which differ in as few bits as possible.
+static void integer_key(uint8_t* key, uint64_t value) {
+    for (int i = 0; i < SEQUENTIAL_LENGTH; i++) {
+        key[i] = 1 + ((value >> (7 * i)) & 0x7f);
+    }
+    key[SEQUENTIAL_LENGTH] = '\0';
+}
+
+// Hashes a pool of keys of one length over and over, for bytes per second and cycles per hash.
+static void throughput(struct Hash* h, size_t length) {
+
+    uint8_t* keys = malloc(BENCH_KEYS * (length + 1));
+    uint64_t state = length;
+    for (int i = 0; i < BENCH_KEYS; i++) {random_key(keys + i * (length + 1), length, &state);}
+
+    long rounds = BENCH_BYTES / (BENCH_KEYS * length) + 1;
+    uint64_t result = 0;
+    double start = seconds();
+    uint64_t start_cycles = cycles();
+    for (long r = 0; r < rounds; r++) {
+        for (int i = 0; i < BENCH_KEYS; i++) {result ^= h->hash(keys + i * (length + 1), length);}
+    }
+    uint64_t elapsed_cycles = cycles() - start_cycles;
+    double elapsed = seconds() - start;
+    sink = result;
+
+    double count = (double) rounds * BENCH_KEYS;
+    printf("  %-8s %6zu B %10.1f MB/s %9.1f ns/hash", h->name, length, count * length / elapsed / 1e6, elapsed / count * 1e9);
+    if (BENCH_CYCLES) {printf(" %9.1f cycles/hash", elapsed_cycles / count);}
+    printf("\n");
+
+    free(keys);
+
+}
+
+// Flips every input bit of random keys and counts how often each output bit flips with it.
+// A good hash flips each output bit half the time, the worst bias is the furthest any pair strays from that.
+static void avalanche(struct Hash* h) {
+
+    uint8_t key[AVALANCHE_LENGTH + 1];
+    uint64_t state = 1;
+    long* flips = calloc(8 * AVALANCHE_LENGTH * h->bits, sizeof(long));
+    long trials = 0;
+
+    for (int k = 0; k < AVALANCHE_KEYS; k++) {
+        random_key(key, AVALANCHE_LENGTH, &state);
+
+        // With the top and bottom bits set, no single flip can turn a byte into the terminator.
+        for (int i = 0; i < AVALANCHE_LENGTH; i++) {key[i] |= 0x81;}
+        uint64_t base = h->hash(key, AVALANCHE_LENGTH);
+        for (int bit = 0; bit < 8 * AVALANCHE_LENGTH; bit++) {
+            key[bit / 8] ^= 1 << (bit % 8);
+            uint64_t diff = base ^ h->hash(key, AVALANCHE_LENGTH);
+            for (int out = 0; out < h->bits; out++) {flips[bit * h->bits + out] += (diff >> out) & 1;}
+            key[bit / 8] ^= 1 << (bit % 8);
+        }
+        trials++;
+    }
+
+    double worst = 0;
+    double total = 0;
+    for (int i = 0; i < 8 * AVALANCHE_LENGTH * h->bits; i++) {
+        double bias = fabs((double) flips[i] / trials - 0.5);
+        if (bias > worst) {worst = bias;}
+        total += bias;
+    }
+
+    printf("  %-8s worst bias %.4f, mean bias %.4f over %d input and %d output bits\n",
+        h->name, worst, total / (8 * AVALANCHE_LENGTH * h->bits), 8 * AVALANCHE_LENGTH, h->bits);
+
+    free(flips);
+
+}
+
+static int compare_hashes(const void* a, const void* b) {
+    uint64_t x = *(const uint64_t*) a;
+    uint64_t y = *(const uint64_t*) b;
+    return (x > y) - (x < y);
+}
+
+// Hashes sequential integers, then checks how evenly the low bits spread them over power of two buckets,
+// as the tables use them, and how many share a whole hash with another.
+static void distribution(struct Hash* h) {
+
+    size_t buckets = (size_t) 1 << BUCKET_BITS;
+    long* counts = calloc(buckets, sizeof(long));
+    uint64_t* results = malloc(SEQUENTIAL_KEYS * sizeof(uint64_t));
+    uint8_t key[SEQUENTIAL_LENGTH + 1];
+
+    for (uint64_t i = 0; i < SEQUENTIAL_KEYS; i++) {
+        integer_key(key, i);
+        results[i] = h->hash(key, SEQUENTIAL_LENGTH);
+        counts[results[i] & (buckets - 1)]++;
+    }
+
+    // Chi-square against a uniform spread, reported as standard deviations from its expected value.
+    double expected = (double) SEQUENTIAL_KEYS / buckets;
+    double chi = 0;
+    for (size_t b = 0; b < buckets; b++) {chi += (counts[b] - expected) * (counts[b] - expected) / expected;}
+    double z = (chi - (buckets - 1)) / sqrt(2.0 * (buckets - 1));
+
+    qsort(results, SEQUENTIAL_KEYS, sizeof(uint64_t), compare_hashes);
+    long collisions = 0;
+    for (int i = 1; i < SEQUENTIAL_KEYS; i++) {collisions += results[i] == results[i-1];}
+    double random = (double) SEQUENTIAL_KEYS * (SEQUENTIAL_KEYS - 1) / 2 / pow(2, h->bits);
+
+    printf("  %-8s chi-square z %+8.2f over %zu buckets, %ld collisions (%.2f expected at random)\n",
+        h->name, z, buckets, collisions, random);
+
+    free(counts);
+    free(results);
+
+}
+
+int main() {
+
+    SEED64_Pin(1);
+    seed0 = SEED64();
+    seed1 = SEED64();
+
+    size_t lengths[] = {4, 8, 16, 32, 64, 256, 1024};
+    int num_hashes = sizeof(hashes) / sizeof(hashes[0]);
+
+    printf("Throughput\n");
+    for (int i = 0; i < num_hashes; i++) {
+        for (int j = 0; j < (int) (sizeof(lengths) / sizeof(lengths[0])); j++) {throughput(&hashes[i], lengths[j]);}
+    }
+
+    printf("Avalanche\n");
+    for (int i = 0; i < num_hashes; i++) {avalanche(&hashes[i]);}
+
+    printf("Sequential integers\n");
+    for (int i = 0; i < num_hashes; i++) {distribution(&hashes[i]);}
+
+    return 0;
+}
@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "hashmap.h"
+#include "hash.h"
+
+#define BENCH_SIZES 3
+#define BENCH_LOOKUPS 2000000
+#define BENCH_CHURN 2000000
+
+struct Engine {
+    const char* name;
+    HashMapEngine engine;
+};
+
+struct Engine engines[] = {
+    {"cuckoo", HASHMAP_CUCKOO},
+    {"swiss", HASHMAP_SWISS},
+};
+
+volatile uint64_t sink;
+
+static double seconds(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+static uint64_t next_random(uint64_t* state) {
+    uint64_t z = (*state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+// Puts random keys into an empty map, then gets keys which are there and keys which are not, and finally
+// keeps the size steady while putting new keys and removing the oldest, as a write-heavy map would.
+static void workload(struct Engine* e, int size) {
+
+    uint64_t* keys = malloc(2 * (size_t) size * sizeof(uint64_t));
+    uint64_t state = size;
+    for (int i = 0; i < 2 * size; i++) {keys[i] = next_random(&state);}
+
+    HashMap h;
+    HashMap_InitEngine(&h, sizeof(uint64_t), sizeof(uint64_t), e->engine);
+
+    double start = seconds();
+    for (int i = 0; i < size; i++) {HashMap_Put(&h, &keys[i], &keys[i]);}
+    double put = (seconds() - start) / size;
+
+    uint64_t value;
+    uint64_t found = 0;
+    start = seconds();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {found += HashMap_Get(&h, &keys[i % size], &value);}
+    double hit = (seconds() - start) / BENCH_LOOKUPS;
+
+    start = seconds();
+    for (int i = 0; i < BENCH_LOOKUPS; i++) {found += HashMap_Get(&h, &keys[size + i % size], &value);}
+    double miss = (seconds() - start) / BENCH_LOOKUPS;
+    sink = found;
+
+    // The ring of keys is refilled with new random ones as they are put.
+    start = seconds();
+    for (int i = 0; i < BENCH_CHURN; i++) {
+        int slot = i % size;
+        HashMap_Remove(&h, &keys[slot]);
+        keys[slot] = next_random(&state);
+        HashMap_Put(&h, &keys[slot], &keys[slot]);
+    }
+    double churn = (seconds() - start) / BENCH_CHURN;
+
+    printf("  %-8s %9d %9.1f %9.1f %9.1f %9.1f\n", e->name, size, put * 1e9, hit * 1e9, miss * 1e9, churn * 1e9);
+
+    HashMap_Free(&h);
+    free(keys);
+
+}
+
+int main() {
+
+    SEED64_Pin(1);
+
+    int sizes[BENCH_SIZES] = {1000, 100000, 1000000};
+    int num_engines = sizeof(engines) / sizeof(engines[0]);
+
+    printf("Nanoseconds per operation\n");
+    printf("  %-8s %9s %9s %9s %9s %9s\n", "engine", "size", "put", "get hit", "get miss", "churn");
+    for (int i = 0; i < BENCH_SIZES; i++) {
+        for (int j = 0; j < num_engines; j++) {workload(&engines[j], sizes[i]);}
+    }
+
+    return 0;
+}
@@ -0,0 +1,658 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef BITSET_H
+#define BITSET_H
+
+#define COMPRESSEDBITSET_ARRAY_LIMIT 4096
+
+// The bits are kept in 64 bit words, with as many words as the highest set bit has needed.
+struct Bitset {
+    uint64_t* words;
+    size_t length;
+};
+typedef struct Bitset Bitset;
+
+struct BitsetIterator {
+    Bitset* bitset;
+    size_t word;
+    uint64_t bits;
+};
+typedef struct BitsetIterator BitsetIterator;
+
+// Every value with the same top 16 bits shares a container, which holds its low 16 bits either as a
+// sorted array, while there are at most 4096 of them, or as a 65536 bit bitmap.
+struct CompressedBitsetContainer {
+    uint16_t key;
+    bool bitmap;
+    int count;
+    int size;
+    void* values;
+};
+typedef struct CompressedBitsetContainer CompressedBitsetContainer;
+
+struct CompressedBitset {
+    CompressedBitsetContainer* containers;
+    int length;
+    int size;
+};
+typedef struct CompressedBitset CompressedBitset;
+
+struct CompressedBitsetIterator {
+    CompressedBitset* bitset;
+    int container;
+    int index;
+};
+typedef struct CompressedBitsetIterator CompressedBitsetIterator;
+
+/*
+Initialises the memory of a Bitset structure, a set of non-negative integers stored one bit each.
+It suits dense sets of ids, where it takes a bit per possible id instead of a block per id in a HashMap.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates an empty set.
+
+    Bitset* b = malloc(sizeof(Bitset));
+    Bitset_Init(b);
+
+*/
+void Bitset_Init(Bitset* b);
+
+/*
+Adds an integer to the set, growing it to cover the integer if needed.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+ - size_t index: the integer to add.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This adds 1024 to the set
+
+    Bitset_Set(b, 1024);
+
+*/
+void Bitset_Set(Bitset* b, size_t index);
+
+/*
+Removes an integer from the set.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+ - size_t index: the integer to remove.
+
+Time Complexity: O(1)
+
+Example:
+ - This removes 1024 from the set
+
+    Bitset_Unset(b, 1024);
+
+*/
+void Bitset_Unset(Bitset* b, size_t index);
+
+/*
+Checks whether an integer is in the set.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+ - size_t index: the integer to look for.
+
+Outputs:
+ - 0: if the integer is not in the set.
+ - 1: if the integer is in the set.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks for 1024
+
+    bool found = Bitset_Get(b, 1024);
+
+*/
+bool Bitset_Get(Bitset* b, size_t index);
+
+/*
+Counts the integers in the set, a word or two at a time.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+
+Outputs:
+ - size_t: the number of integers in the set.
+
+Time Complexity: O(n / 64), where n is the largest integer ever added.
+
+Example:
+ - This counts the set
+
+    size_t count = Bitset_Count(b);
+
+*/
+size_t Bitset_Count(Bitset* b);
+
+/*
+Counts the integers in the set which are less than the given one.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+ - size_t index: the integer to count up to.
+
+Outputs:
+ - size_t: the number of integers in the set less than index.
+
+Time Complexity: O(index / 64)
+
+Example:
+ - This finds the position of 1024 among the sorted integers of the set
+
+    size_t position = Bitset_Rank(b, 1024);
+
+*/
+size_t Bitset_Rank(Bitset* b, size_t index);
+
+/*
+Finds the integer of the set with a given rank, the inverse of Bitset_Rank.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+ - size_t rank: the number of smaller integers in the set, 0 for the smallest.
+ - size_t* index: the memory address which receives the integer.
+
+Outputs:
+ - 0: if the set holds no more than rank integers, which leaves index unchanged.
+ - 1: if the integer was found.
+
+Time Complexity: O(n / 64)
+
+Example:
+ - This finds the median of the set
+
+    size_t median;
+    Bitset_Select(b, Bitset_Count(b) / 2, &median);
+
+*/
+bool Bitset_Select(Bitset* b, size_t rank, size_t* index);
+
+/*
+Keeps only the integers which are also in another set.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure to change.
+ - Bitset* other: the memory address of the Bitset structure to intersect with.
+
+Time Complexity: O(n / 64)
+
+Example:
+ - This intersects two sets
+
+    Bitset_And(b, other);
+
+*/
+void Bitset_And(Bitset* b, Bitset* other);
+
+/*
+Adds every integer of another set.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure to change.
+ - Bitset* other: the memory address of the Bitset structure to add.
+
+Time Complexity: O(n / 64)
+
+Example:
+ - This takes the union of two sets
+
+    Bitset_Or(b, other);
+
+*/
+void Bitset_Or(Bitset* b, Bitset* other);
+
+/*
+Keeps the integers which are in exactly one of the two sets.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure to change.
+ - Bitset* other: the memory address of the other Bitset structure.
+
+Time Complexity: O(n / 64)
+
+Example:
+ - This takes the symmetric difference of two sets
+
+    Bitset_Xor(b, other);
+
+*/
+void Bitset_Xor(Bitset* b, Bitset* other);
+
+/*
+Removes every integer of another set.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure to change.
+ - Bitset* other: the memory address of the Bitset structure to remove.
+
+Time Complexity: O(n / 64)
+
+Example:
+ - This takes the difference of two sets
+
+    Bitset_AndNot(b, other);
+
+*/
+void Bitset_AndNot(Bitset* b, Bitset* other);
+
+/*
+Returns an iterator at the smallest integer of the set, which then visits them in order.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+
+Outputs:
+ - BitsetIterator: an iterator which is not valid if the set is empty.
+
+Time Complexity: O(n / 64) to visit every integer.
+
+Example:
+ - This visits every integer
+
+    for (BitsetIterator it = Bitset_First(b); BitsetIterator_Valid(&it); BitsetIterator_Next(&it)) {
+        size_t index = BitsetIterator_Index(&it);
+    }
+
+*/
+BitsetIterator Bitset_First(Bitset* b);
+
+/*
+Checks whether an iterator points at an integer. Iterators are invalidated by any change to the set.
+
+Inputs:
+ - BitsetIterator* it: the memory address of the iterator.
+
+Outputs:
+ - 0: if the iterator has run off the end of the set.
+ - 1: if the iterator points at an integer.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks an iterator
+
+    BitsetIterator_Valid(&it);
+
+*/
+bool BitsetIterator_Valid(BitsetIterator* it);
+
+/*
+Moves an iterator to the next integer of the set, skipping empty words.
+
+Inputs:
+ - BitsetIterator* it: the memory address of a valid iterator.
+
+Time Complexity: Amortised O(1) for dense sets.
+
+Example:
+ - This advances an iterator
+
+    BitsetIterator_Next(&it);
+
+*/
+void BitsetIterator_Next(BitsetIterator* it);
+
+/*
+Returns the integer an iterator points at.
+
+Inputs:
+ - BitsetIterator* it: the memory address of a valid iterator.
+
+Outputs:
+ - size_t: the current integer.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads the current integer
+
+    size_t index = BitsetIterator_Index(&it);
+
+*/
+size_t BitsetIterator_Index(BitsetIterator* it);
+
+/*
+Clears all integers from a given Bitset structure, keeping its memory.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+
+Time Complexity: O(n / 64)
+
+Example:
+ - This clears a set.
+
+    Bitset_Clear(b);
+
+*/
+void Bitset_Clear(Bitset* b);
+
+/*
+Frees all memory associated with an initialised Bitset structure.
+
+Inputs:
+ - Bitset* b: the memory address of the Bitset structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    Bitset_Free(b);
+
+*/
+void Bitset_Free(Bitset* b);
+
+/*
+Initialises the memory of a CompressedBitset structure, a set of 32 bit integers split into containers of 65536.
+Sparse containers are kept as sorted arrays and dense ones as bitmaps, so sets with sparse ranges take little memory.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates an empty set.
+
+    CompressedBitset* c = malloc(sizeof(CompressedBitset));
+    CompressedBitset_Init(c);
+
+*/
+void CompressedBitset_Init(CompressedBitset* c);
+
+/*
+Adds an integer to the set.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+ - uint32_t value: the integer to add.
+
+Outputs:
+ - 0: if the integer was already in the set.
+ - 1: if the integer was added.
+
+Time Complexity: O(log n + 4096) worst case, for an insertion into a full array.
+
+Example:
+ - This adds 1024 to the set
+
+    CompressedBitset_Add(c, 1024);
+
+*/
+bool CompressedBitset_Add(CompressedBitset* c, uint32_t value);
+
+/*
+Removes an integer from the set.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+ - uint32_t value: the integer to remove.
+
+Outputs:
+ - 0: if the integer was not in the set.
+ - 1: if the integer was removed.
+
+Time Complexity: O(log n + 4096) worst case.
+
+Example:
+ - This removes 1024 from the set
+
+    CompressedBitset_Remove(c, 1024);
+
+*/
+bool CompressedBitset_Remove(CompressedBitset* c, uint32_t value);
+
+/*
+Checks whether an integer is in the set.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+ - uint32_t value: the integer to look for.
+
+Outputs:
+ - 0: if the integer is not in the set.
+ - 1: if the integer is in the set.
+
+Time Complexity: O(log n)
+
+Example:
+ - This checks for 1024
+
+    bool found = CompressedBitset_Contains(c, 1024);
+
+*/
+bool CompressedBitset_Contains(CompressedBitset* c, uint32_t value);
+
+/*
+Counts the integers in the set.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+
+Outputs:
+ - size_t: the number of integers in the set.
+
+Time Complexity: O(n / 65536)
+
+Example:
+ - This counts the set
+
+    size_t count = CompressedBitset_Count(c);
+
+*/
+size_t CompressedBitset_Count(CompressedBitset* c);
+
+/*
+Returns the number of bytes of memory the CompressedBitset is using.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+
+Outputs:
+ - size_t: the number of bytes allocated for the containers and their values.
+
+Time Complexity: O(n / 65536)
+
+Example:
+ - This gets the average number of bytes used by an integer
+
+    double average = (double) CompressedBitset_Bytes(c) / CompressedBitset_Count(c);
+
+*/
+size_t CompressedBitset_Bytes(CompressedBitset* c);
+
+/*
+Keeps only the integers which are also in another set. Pairs of bitmaps are combined with the same word
+operations as a Bitset, and pairs of arrays are merged.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure to change.
+ - CompressedBitset* other: the memory address of the CompressedBitset structure to intersect with.
+
+Time Complexity: O(n + m) in containers, each costing at most 1024 words or its two arrays.
+
+Example:
+ - This intersects two sets
+
+    CompressedBitset_And(c, other);
+
+*/
+void CompressedBitset_And(CompressedBitset* c, CompressedBitset* other);
+
+/*
+Adds every integer of another set.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure to change.
+ - CompressedBitset* other: the memory address of the CompressedBitset structure to add.
+
+Time Complexity: O(n + m) in containers.
+
+Example:
+ - This takes the union of two sets
+
+    CompressedBitset_Or(c, other);
+
+*/
+void CompressedBitset_Or(CompressedBitset* c, CompressedBitset* other);
+
+/*
+Keeps the integers which are in exactly one of the two sets.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure to change.
+ - CompressedBitset* other: the memory address of the other CompressedBitset structure.
+
+Time Complexity: O(n + m) in containers.
+
+Example:
+ - This takes the symmetric difference of two sets
+
+    CompressedBitset_Xor(c, other);
+
+*/
+void CompressedBitset_Xor(CompressedBitset* c, CompressedBitset* other);
+
+/*
+Removes every integer of another set.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure to change.
+ - CompressedBitset* other: the memory address of the CompressedBitset structure to remove.
+
+Time Complexity: O(n + m) in containers.
+
+Example:
+ - This takes the difference of two sets
+
+    CompressedBitset_AndNot(c, other);
+
+*/
+void CompressedBitset_AndNot(CompressedBitset* c, CompressedBitset* other);
+
+/*
+Returns an iterator at the smallest integer of the set, which then visits them in order.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+
+Outputs:
+ - CompressedBitsetIterator: an iterator which is not valid if the set is empty.
+
+Time Complexity: O(1)
+
+Example:
+ - This visits every integer
+
+    CompressedBitsetIterator it = CompressedBitset_First(c);
+    while (CompressedBitsetIterator_Valid(&it)) {
+        uint32_t value = CompressedBitsetIterator_Value(&it);
+        CompressedBitsetIterator_Next(&it);
+    }
+
+*/
+CompressedBitsetIterator CompressedBitset_First(CompressedBitset* c);
+
+/*
+Checks whether an iterator points at an integer. Iterators are invalidated by any change to the set.
+
+Inputs:
+ - CompressedBitsetIterator* it: the memory address of the iterator.
+
+Outputs:
+ - 0: if the iterator has run off the end of the set.
+ - 1: if the iterator points at an integer.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks an iterator
+
+    CompressedBitsetIterator_Valid(&it);
+
+*/
+bool CompressedBitsetIterator_Valid(CompressedBitsetIterator* it);
+
+/*
+Moves an iterator to the next integer of the set.
+
+Inputs:
+ - CompressedBitsetIterator* it: the memory address of a valid iterator.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This advances an iterator
+
+    CompressedBitsetIterator_Next(&it);
+
+*/
+void CompressedBitsetIterator_Next(CompressedBitsetIterator* it);
+
+/*
+Returns the integer an iterator points at.
+
+Inputs:
+ - CompressedBitsetIterator* it: the memory address of a valid iterator.
+
+Outputs:
+ - uint32_t: the current integer.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads the current integer
+
+    uint32_t value = CompressedBitsetIterator_Value(&it);
+
+*/
+uint32_t CompressedBitsetIterator_Value(CompressedBitsetIterator* it);
+
+/*
+Clears all integers from a given CompressedBitset structure.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+
+Time Complexity: O(n / 65536)
+
+Example:
+ - This clears a set.
+
+    CompressedBitset_Clear(c);
+
+*/
+void CompressedBitset_Clear(CompressedBitset* c);
+
+/*
+Frees all memory associated with an initialised CompressedBitset structure.
+
+Inputs:
+ - CompressedBitset* c: the memory address of the CompressedBitset structure.
+
+Time Complexity: O(n / 65536)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    CompressedBitset_Free(c);
+
+*/
+void CompressedBitset_Free(CompressedBitset* c);
+
+#endif
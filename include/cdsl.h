@@ -1,4 +1,22 @@
-
-#include "hashmap.h"
-#include "list.h"
+
+#include "hashmap.h"
+#include "hashset.h"
+#include "filter.h"
+#include "frozenhashmap.h"
+#include "mappedhashmap.h"
+#include "multimap.h"
+#include "countmap.h"
+#include "treemap.h"
+#include "radixtree.h"
+#include "list.h"
+#include "compressedlist.h"
+#include "columnlist.h"
+#include "bitset.h"
+#include "rope.h"
+#include "queue.h"
+#include "priorityqueue.h"
+#include "threadpool.h"
+#include "pages.h"
+#include "epoch.h"
+#include "trace.h"
 #include "hash.h"
\ No newline at end of file
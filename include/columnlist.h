@@ -0,0 +1,233 @@
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef COLUMNLIST_H
+#define COLUMNLIST_H
+
+// A field of the record type, usually given with offsetof and sizeof.
+struct ColumnField {
+    size_t offset;
+    size_t size;
+};
+typedef struct ColumnField ColumnField;
+
+// Each field is stored in its own array, so column i holds field i of every record in order.
+struct ColumnList {
+
+    size_t record_size;
+    int num_fields;
+    ColumnField* fields;
+
+    uint8_t** columns;
+    int size;
+    int length;
+
+};
+typedef struct ColumnList ColumnList;
+
+/*
+Initialises the memory of a ColumnList structure, which stores records field by field rather than record by record.
+A loop over one field of every record then reads one contiguous array, instead of every whole record.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - size_t record_size: the size in bytes of the record datatype.
+ - ColumnField* fields: the offset and size of each field of the record to store, which are copied.
+ - int num_fields: the number of fields.
+
+Time Complexity: O(f)
+
+Example:
+ - This creates a list of trades.
+
+    struct Trade {double price; int volume; char symbol[8];};
+    ColumnField fields[] = {
+        {offsetof(struct Trade, price), sizeof(double)},
+        {offsetof(struct Trade, volume), sizeof(int)},
+        {offsetof(struct Trade, symbol), 8}
+    };
+
+    ColumnList* c = malloc(sizeof(ColumnList));
+    ColumnList_Init(c, sizeof(struct Trade), fields, 3);
+
+*/
+void ColumnList_Init(ColumnList* c, size_t record_size, ColumnField* fields, int num_fields);
+
+/*
+Returns the number of records that are stored in the ColumnList.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+
+Outputs:
+ - int: the number of records.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the length of the list
+
+    int length = ColumnList_Length(c);
+
+*/
+int ColumnList_Length(ColumnList* c);
+
+/*
+Appends a record to the end of the list, copying each of its fields into its column.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - void* record: the memory address of the record.
+
+Time Complexity: Amortised O(f)
+
+Example:
+ - This appends a trade
+
+    struct Trade trade = {101.5, 300, "ACME"};
+    ColumnList_Push(c, &trade);
+
+*/
+void ColumnList_Push(ColumnList* c, void* record);
+
+/*
+Appends an array of records to the end of the list.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - void* records: the memory address of the first record of the array.
+ - int count: the number of records.
+
+Time Complexity: O(f * count)
+
+Example:
+ - This appends a day of trades
+
+    ColumnList_Extend(c, trades, num_trades);
+
+*/
+void ColumnList_Extend(ColumnList* c, void* records, int count);
+
+/*
+Gathers the fields of a record into a buffer. Bytes of the buffer which belong to no field are left unchanged.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - int index: the index of the record.
+ - void* record: a memory address of at least record_size bytes which receives the record.
+
+Outputs:
+ - 0: if the index is out of range, which leaves the buffer unchanged.
+ - 1: if the record was copied.
+
+Time Complexity: O(f)
+
+Example:
+ - This gets the first trade
+
+    struct Trade trade;
+    ColumnList_Get(c, 0, &trade);
+
+*/
+bool ColumnList_Get(ColumnList* c, int index, void* record);
+
+/*
+Replaces the fields of a record.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - int index: the index of the record.
+ - void* record: the memory address of the new record.
+
+Outputs:
+ - 0: if the index is out of range.
+ - 1: if the record was replaced.
+
+Time Complexity: O(f)
+
+Example:
+ - This replaces the first trade
+
+    ColumnList_Set(c, 0, &trade);
+
+*/
+bool ColumnList_Set(ColumnList* c, int index, void* record);
+
+/*
+Removes the last record of the list, gathering it into a buffer.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - void* record: a memory address which receives the record, or NULL.
+
+Outputs:
+ - 0: if the list is empty.
+ - 1: if the record was removed.
+
+Time Complexity: O(f)
+
+Example:
+ - This removes the last trade
+
+    ColumnList_Pop(c, NULL);
+
+*/
+bool ColumnList_Pop(ColumnList* c, void* record);
+
+/*
+Returns the contiguous array holding one field of every record, in record order, which can be read and written in place.
+It stays valid until the list next grows, is cleared or is freed.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+ - int field: the index of the field, in the order given to ColumnList_Init.
+
+Outputs:
+ - void*: the address of the column, or NULL if the field is out of range or no record has been added since the list was initialised or cleared.
+
+Time Complexity: O(1)
+
+Example:
+ - This sums the volume of every trade
+
+    int* volumes = ColumnList_Column(c, 1);
+    long total = 0;
+    for (int i = 0; i < ColumnList_Length(c); i++) {total += volumes[i];}
+
+*/
+void* ColumnList_Column(ColumnList* c, int field);
+
+/*
+Clears all records from a given ColumnList structure, keeping its fields.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+
+Time Complexity: O(f)
+
+Example:
+ - This clears a list.
+
+    ColumnList_Clear(c);
+
+*/
+void ColumnList_Clear(ColumnList* c);
+
+/*
+Frees all memory associated with an initialised ColumnList structure.
+
+Inputs:
+ - ColumnList* c: the memory address of the ColumnList structure.
+
+Time Complexity: O(f)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    ColumnList_Free(c);
+
+*/
+void ColumnList_Free(ColumnList* c);
+
+#endif
@@ -0,0 +1,334 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "list.h"
+
+#ifndef COMPRESSEDLIST_H
+#define COMPRESSEDLIST_H
+
+#define COMPRESSEDLIST_BLOCK_LENGTH 128
+
+// Every full block of 128 values keeps its first value, and the gaps between its values packed with as few bits as the widest one needs.
+struct CompressedBlock {
+    uint64_t first;
+    size_t offset;
+    int bits;
+};
+typedef struct CompressedBlock CompressedBlock;
+
+// Values are appended to the tail, which is packed into a block once it is full.
+struct CompressedList {
+
+    size_t length;
+    uint64_t last;
+
+    CompressedBlock* blocks;
+    int num_blocks;
+    int blocks_size;
+
+    uint32_t* data;
+    size_t data_length;
+    size_t data_size;
+
+    uint64_t* tail;
+    int tail_length;
+
+};
+typedef struct CompressedList CompressedList;
+
+// An iterator decodes a whole block at a time into its own buffer.
+struct CompressedListIterator {
+    CompressedList* list;
+    int block;
+    int index;
+    int count;
+    uint64_t values[COMPRESSEDLIST_BLOCK_LENGTH];
+};
+typedef struct CompressedListIterator CompressedListIterator;
+
+/*
+Initialises the memory of a CompressedList structure, a sorted sequence of unsigned integers stored in compressed blocks.
+It suits lists of sorted ids, which take a byte or two per id instead of a pointer and a block each in a List.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a list of ids.
+
+    CompressedList* c = malloc(sizeof(CompressedList));
+    CompressedList_Init(c);
+
+*/
+void CompressedList_Init(CompressedList* c);
+
+/*
+Returns the number of values that are stored in the CompressedList.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+
+Outputs:
+ - size_t: the number of values.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the length of the list
+
+    size_t length = CompressedList_Length(c);
+
+*/
+size_t CompressedList_Length(CompressedList* c);
+
+/*
+Returns the number of bytes of memory the CompressedList is using.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+
+Outputs:
+ - size_t: the number of bytes allocated for the blocks and the tail.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the average number of bytes used by a value
+
+    double average = (double) CompressedList_Bytes(c) / CompressedList_Length(c);
+
+*/
+size_t CompressedList_Bytes(CompressedList* c);
+
+/*
+Appends a value to the end of the list. Values must be appended in order, equal values are allowed.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+ - uint64_t value: the value to append.
+
+Outputs:
+ - 0: if the value is less than the last value, which leaves the list unchanged.
+ - 1: if the value was appended.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This appends an id
+
+    CompressedList_Append(c, 1024);
+
+*/
+bool CompressedList_Append(CompressedList* c, uint64_t value);
+
+/*
+Returns an iterator at the first value of the list.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+
+Outputs:
+ - CompressedListIterator: an iterator which is not valid if the list is empty.
+
+Time Complexity: O(1)
+
+Example:
+ - This sums every value
+
+    uint64_t sum = 0;
+    CompressedListIterator it = CompressedList_First(c);
+    while (CompressedListIterator_Valid(&it)) {
+        sum += CompressedListIterator_Value(&it);
+        CompressedListIterator_Next(&it);
+    }
+
+*/
+CompressedListIterator CompressedList_First(CompressedList* c);
+
+/*
+Returns an iterator at the first value which is not less than the given value.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+ - uint64_t value: the value to look for.
+
+Outputs:
+ - CompressedListIterator: an iterator which is not valid if every value is less than the given value.
+
+Time Complexity: O(log n)
+
+Example:
+ - This checks whether the list holds 1024
+
+    CompressedListIterator it = CompressedList_LowerBound(c, 1024);
+    bool found = CompressedListIterator_Valid(&it) && CompressedListIterator_Value(&it) == 1024;
+
+*/
+CompressedListIterator CompressedList_LowerBound(CompressedList* c, uint64_t value);
+
+/*
+Checks whether an iterator points at a value. Iterators are invalidated by any change to the list.
+
+Inputs:
+ - CompressedListIterator* it: the memory address of the iterator.
+
+Outputs:
+ - 0: if the iterator has run off the end of the list.
+ - 1: if the iterator points at a value.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks an iterator
+
+    CompressedListIterator_Valid(&it);
+
+*/
+bool CompressedListIterator_Valid(CompressedListIterator* it);
+
+/*
+Moves an iterator to the next value.
+
+Inputs:
+ - CompressedListIterator* it: the memory address of a valid iterator.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This advances an iterator
+
+    CompressedListIterator_Next(&it);
+
+*/
+void CompressedListIterator_Next(CompressedListIterator* it);
+
+/*
+Moves an iterator forwards to the first value which is not less than the given value, skipping whole blocks
+without decoding them. An iterator already at such a value does not move.
+
+Inputs:
+ - CompressedListIterator* it: the memory address of a valid iterator.
+ - uint64_t value: the value to skip to.
+
+Time Complexity: O(log n)
+
+Example:
+ - This counts the values two lists have in common
+
+    int common = 0;
+    CompressedListIterator a = CompressedList_First(c);
+    CompressedListIterator b = CompressedList_First(d);
+    while (CompressedListIterator_Valid(&a) && CompressedListIterator_Valid(&b)) {
+        uint64_t x = CompressedListIterator_Value(&a);
+        uint64_t y = CompressedListIterator_Value(&b);
+        if (x < y) {CompressedListIterator_SkipTo(&a, y);}
+        else if (y < x) {CompressedListIterator_SkipTo(&b, x);}
+        else {
+            common++;
+            CompressedListIterator_Next(&a);
+            CompressedListIterator_Next(&b);
+        }
+    }
+
+*/
+void CompressedListIterator_SkipTo(CompressedListIterator* it, uint64_t value);
+
+/*
+Returns the value an iterator points at.
+
+Inputs:
+ - CompressedListIterator* it: the memory address of a valid iterator.
+
+Outputs:
+ - uint64_t: the current value.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads the current value
+
+    uint64_t value = CompressedListIterator_Value(&it);
+
+*/
+uint64_t CompressedListIterator_Value(CompressedListIterator* it);
+
+/*
+Initialises a CompressedList structure holding the elements of a List of sorted unsigned integers.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure to initialise.
+ - List* l: the memory address of a List whose elements are 4 or 8 byte unsigned integers, in order.
+
+Outputs:
+ - 0: if the elements are not 4 or 8 bytes, or not in order, which leaves c uninitialised.
+ - 1: if the list was compressed.
+
+Time Complexity: O(n)
+
+Example:
+ - This compresses a list of uint32_t ids
+
+    CompressedList* c = malloc(sizeof(CompressedList));
+    CompressedList_FromList(c, l);
+
+*/
+bool CompressedList_FromList(CompressedList* c, List* l);
+
+/*
+Initialises a List structure holding the values of a CompressedList.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+ - List* out: the memory address of an uninitialised List structure which receives the values.
+ - size_t element_size: 4 for uint32_t elements, which the values must fit in, or 8 for uint64_t elements.
+
+Outputs:
+ - 0: if the element size is not 4 or 8, which leaves out uninitialised.
+ - 1: if the list was made.
+
+Time Complexity: O(n)
+
+Example:
+ - This decompresses a list into uint64_t elements
+
+    List* l = malloc(sizeof(List));
+    CompressedList_ToList(c, l, sizeof(uint64_t));
+
+*/
+bool CompressedList_ToList(CompressedList* c, List* out, size_t element_size);
+
+/*
+Clears all values from a given CompressedList structure.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This clears a list.
+
+    CompressedList_Clear(c);
+
+*/
+void CompressedList_Clear(CompressedList* c);
+
+/*
+Frees all memory associated with an initialised CompressedList structure.
+
+Inputs:
+ - CompressedList* c: the memory address of the CompressedList structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    CompressedList_Free(c);
+
+*/
+void CompressedList_Free(CompressedList* c);
+
+#endif
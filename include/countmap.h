@@ -0,0 +1,203 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include "hashmap.h"
+
+#ifndef COUNTMAP_H
+#define COUNTMAP_H
+
+// A HashMap from each key to a 64 bit count, which is stored in place so it can be added to atomically.
+struct CountMap {
+
+    HashMap counts;
+
+};
+typedef struct CountMap CountMap;
+
+/*
+Initialises the memory of a CountMap structure, which counts how often each key occurs.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+ - size_t key_size: the size in bytes of the key datatype.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a map counting integers.
+
+    CountMap* c = malloc(sizeof(CountMap));
+    CountMap_Init(c, sizeof(int));
+
+*/
+void CountMap_Init(CountMap* c, size_t key_size);
+
+/*
+Returns the number of keys that are counted in the CountMap.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+
+Outputs:
+ - int: the number of keys.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the number of distinct keys
+
+    int size = CountMap_Size(c);
+
+*/
+int CountMap_Size(CountMap* c);
+
+/*
+Given a key, returns its count, or 0 if it has never been counted.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - int64_t: the count of the key.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets how often 7 was counted
+
+    int key = 7;
+
+    int64_t count = CountMap_Get(c, &key);
+
+*/
+int64_t CountMap_Get(CountMap* c, void* key);
+
+/*
+Adds to the count of a key, which starts at 0, and returns the new count.
+Keys stay in the map when their count returns to 0, use CountMap_Remove to drop them.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+ - void* key: a memory address which contains data about the key.
+ - int64_t delta: the amount to add, which may be negative.
+
+Outputs:
+ - int64_t: the count of the key after adding.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This counts one more 7
+
+    int key = 7;
+
+    CountMap_Add(c, &key, 1);
+
+*/
+int64_t CountMap_Add(CountMap* c, void* key, int64_t delta);
+
+/*
+Given a key, returns the address of its count, adding the key with a count of 0 if it is not there yet.
+The count stays at the same address until the key is removed or the map is cleared or freed, so threads
+can keep adding to it with atomic_fetch_add while one thread at a time changes the map.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - _Atomic int64_t*: the memory address of the count.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This hands the count of 7 to worker threads, which each add to it
+
+    int key = 7;
+
+    _Atomic int64_t* count = CountMap_Counter(c, &key);
+    atomic_fetch_add(count, 1);
+
+*/
+_Atomic int64_t* CountMap_Counter(CountMap* c, void* key);
+
+/*
+Removes a key and its count from the CountMap.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key was not in the map.
+ - 1: if the key was removed.
+
+Time Complexity: O(1)
+
+Example:
+ - This stops counting 7
+
+    int key = 7;
+
+    CountMap_Remove(c, &key);
+
+*/
+bool CountMap_Remove(CountMap* c, void* key);
+
+/*
+Returns a linked list of the keys in the CountMap, in the order they were first counted.
+The value of each element points at its count, an _Atomic int64_t.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+
+Outputs:
+ - KeyValue*: a pointer to the first key, or NULL if the map is empty.
+
+Time Complexity: O(1)
+
+Example:
+ - This prints every count
+
+    for (KeyValue* e = CountMap_Elements(c); e != NULL; e = e->next) {
+        printf("%d: %lld\n", *(int*) e->key, (long long) atomic_load((_Atomic int64_t*) e->value));
+    }
+
+*/
+KeyValue* CountMap_Elements(CountMap* c);
+
+/*
+Clears all keys and counts from a given CountMap structure.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This clears a countmap.
+
+    CountMap_Clear(c);
+
+*/
+void CountMap_Clear(CountMap* c);
+
+/*
+Frees all memory associated with an initialised CountMap structure.
+
+Inputs:
+ - CountMap* c: the memory address of the CountMap structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    CountMap_Free(c);
+
+*/
+void CountMap_Free(CountMap* c);
+
+#endif
@@ -0,0 +1,73 @@
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef EPOCH_H
+#define EPOCH_H
+
+/*
+Marks the start of a read of shared structures by the calling thread.
+Memory retired with Epoch_Retire is not freed while any thread which could still be reading it is inside a read.
+Entering only writes to a slot owned by the calling thread, so readers on different cores never contend.
+Reads may be nested, only the outermost Epoch_Exit ends them.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads from a map which another thread is writing to
+
+    Epoch_Enter();
+    HashMap_Get(h, &key, &buffer);
+    Epoch_Exit();
+
+*/
+void Epoch_Enter(void);
+
+/*
+Marks the end of a read started by Epoch_Enter.
+
+Time Complexity: O(1)
+
+Example:
+ - This ends a read
+
+    Epoch_Exit();
+
+*/
+void Epoch_Exit(void);
+
+/*
+Frees memory once no thread can still be reading it.
+The memory must already be unreachable for new readers. It is freed after every thread which was inside a
+read when it was retired has left that read, by the calling thread during a later call to Epoch_Retire or Epoch_Barrier.
+
+Inputs:
+ - void* memory: the memory address to free.
+ - size_t size: the size in bytes of the memory, passed on to the destroy function.
+ - void (*destroy)(void*, size_t): the function which frees the memory, or NULL to use free.
+
+Time Complexity: Amortised O(t), where t is the number of threads which have read.
+
+Example:
+ - This unlinks a node from a shared list and frees it safely
+
+    previous->next = node->next;
+    Epoch_Retire(node, sizeof(Node), NULL);
+
+*/
+void Epoch_Retire(void* memory, size_t size, void (*destroy)(void*, size_t));
+
+/*
+Waits until everything the calling thread has retired so far has been freed, along with anything
+left behind by threads which have exited. It must not be called from inside a read, which would wait forever.
+
+Time Complexity: O(t)
+
+Example:
+ - This frees all retired memory before the program exits
+
+    Epoch_Barrier();
+
+*/
+void Epoch_Barrier(void);
+
+#endif
@@ -0,0 +1,480 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef FILTER_H
+#define FILTER_H
+
+struct BloomFilter {
+
+    size_t key_size;
+    size_t blocks;
+    int hashes;
+
+    uint64_t* bits;
+
+    uint64_t seed_0;
+    uint64_t seed_1;
+
+};
+typedef struct BloomFilter BloomFilter;
+
+struct CuckooFilter {
+
+    size_t key_size;
+    size_t buckets;
+    size_t size;
+
+    uint16_t* fingerprints;
+    uint16_t victim;
+    size_t victim_bucket;
+
+    uint64_t seed_0;
+    uint64_t seed_1;
+    uint64_t state;
+
+};
+typedef struct CuckooFilter CuckooFilter;
+
+/*
+Initialises the memory of a BloomFilter structure.
+Every key only touches a single 64 byte block of the filter, so a query costs one cache line.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - size_t key_size: the size in bytes of the key datatype.
+ - size_t capacity: the number of keys the filter is expected to hold.
+ - size_t bits_per_key: the number of bits of filter per expected key, 10 gives roughly a 1% false positive rate.
+
+Time Complexity: O(m)
+
+Example:
+ - This creates a filter for a million integers.
+
+    BloomFilter* f = malloc(sizeof(BloomFilter));
+    BloomFilter_Init(f, sizeof(int), 1000000, 10);
+
+*/
+void BloomFilter_Init(BloomFilter* f, size_t key_size, size_t capacity, size_t bits_per_key);
+
+/*
+Adds a key to the BloomFilter.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - void* key: a memory address which contains data about the key.
+
+Time Complexity: O(1)
+
+Example:
+ - This adds 5 to the filter
+
+    int key = 5;
+    BloomFilter_Add(f, &key);
+
+*/
+void BloomFilter_Add(BloomFilter* f, void* key);
+
+/*
+Checks whether a key may have been added to the BloomFilter.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key was definitely never added.
+ - 1: if the key was probably added.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks if 5 may be in the filter
+
+    int key = 5;
+    BloomFilter_Contains(f, &key);
+
+*/
+bool BloomFilter_Contains(BloomFilter* f, void* key);
+
+/*
+Adds a contiguous array of keys to the BloomFilter.
+The keys are hashed first and their blocks prefetched, so the memory accesses overlap.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - void* keys: the memory address of count keys stored back to back.
+ - int count: the number of keys in the array.
+
+Time Complexity: O(k)
+
+Example:
+ - This adds three keys at once
+
+    int keys[3] = {1, 2, 3};
+    BloomFilter_AddMany(f, keys, 3);
+
+*/
+void BloomFilter_AddMany(BloomFilter* f, void* keys, int count);
+
+/*
+Checks a contiguous array of keys against the BloomFilter.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - void* keys: the memory address of count keys stored back to back.
+ - int count: the number of keys in the array.
+ - bool* results: an array of count booleans to write each result to, may be NULL.
+
+Outputs:
+ - int: the number of keys which may be in the filter.
+
+Time Complexity: O(k)
+
+Example:
+ - This checks three keys at once
+
+    int keys[3] = {1, 2, 3};
+    bool results[3];
+    BloomFilter_ContainsMany(f, keys, 3, results);
+
+*/
+int BloomFilter_ContainsMany(BloomFilter* f, void* keys, int count, bool* results);
+
+/*
+Returns the number of bytes needed to serialize the BloomFilter.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+
+Outputs:
+ - size_t: the size in bytes of the serialized filter.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of a buffer to serialize into
+
+    size_t length = BloomFilter_SerializedSize(f);
+
+*/
+size_t BloomFilter_SerializedSize(BloomFilter* f);
+
+/*
+Writes the BloomFilter, including its seeds, into a buffer.
+The format uses the byte order of the machine it was written on.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - void* buffer: a memory address with at least BloomFilter_SerializedSize bytes.
+
+Time Complexity: O(m)
+
+Example:
+ - This serializes a filter
+
+    void* buffer = malloc(BloomFilter_SerializedSize(f));
+    BloomFilter_Serialize(f, buffer);
+
+*/
+void BloomFilter_Serialize(BloomFilter* f, void* buffer);
+
+/*
+Initialises a BloomFilter structure from a buffer written by BloomFilter_Serialize.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+ - void* buffer: the memory address of the serialized filter.
+ - size_t length: the size in bytes of the buffer.
+
+Outputs:
+ - 0: if the buffer does not hold a valid filter, the structure is left uninitialised.
+ - 1: if the filter was successfully read.
+
+Time Complexity: O(m)
+
+Example:
+ - This reads a filter back
+
+    BloomFilter_Deserialize(f, buffer, length);
+
+*/
+bool BloomFilter_Deserialize(BloomFilter* f, void* buffer, size_t length);
+
+/*
+Clears all keys from a given BloomFilter structure.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+
+Time Complexity: O(m)
+
+Example:
+ - This clears a filter.
+
+    BloomFilter_Clear(f);
+
+*/
+void BloomFilter_Clear(BloomFilter* f);
+
+/*
+Frees all memory associated with an initialised BloomFilter structure.
+
+Inputs:
+ - BloomFilter* f: the memory address of the BloomFilter structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    BloomFilter_Free(f);
+
+*/
+void BloomFilter_Free(BloomFilter* f);
+
+/*
+Initialises the memory of a CuckooFilter structure.
+Each key is stored as a 16 bit fingerprint in one of two buckets of four, which allows keys to be removed.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - size_t key_size: the size in bytes of the key datatype.
+ - size_t capacity: the number of keys the filter must be able to hold.
+
+Time Complexity: O(m)
+
+Example:
+ - This creates a filter for a million integers.
+
+    CuckooFilter* f = malloc(sizeof(CuckooFilter));
+    CuckooFilter_Init(f, sizeof(int), 1000000);
+
+*/
+void CuckooFilter_Init(CuckooFilter* f, size_t key_size, size_t capacity);
+
+/*
+Returns the number of keys that are stored in the CuckooFilter.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+
+Outputs:
+ - int: the number of keys that are currently stored in the filter.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of the filter
+
+    int size = CuckooFilter_Size(f);
+
+*/
+int CuckooFilter_Size(CuckooFilter* f);
+
+/*
+Adds a key to the CuckooFilter.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the filter is full and the key could not be added.
+ - 1: if the key was added.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This adds 5 to the filter
+
+    int key = 5;
+    CuckooFilter_Add(f, &key);
+
+*/
+bool CuckooFilter_Add(CuckooFilter* f, void* key);
+
+/*
+Checks whether a key may have been added to the CuckooFilter.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key is definitely not in the filter.
+ - 1: if the key is probably in the filter.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks if 5 may be in the filter
+
+    int key = 5;
+    CuckooFilter_Contains(f, &key);
+
+*/
+bool CuckooFilter_Contains(CuckooFilter* f, void* key);
+
+/*
+Removes a key from the CuckooFilter.
+Only keys which were previously added should be removed, otherwise another key may be lost.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if no fingerprint of the key was found.
+ - 1: if a fingerprint of the key was removed.
+
+Time Complexity: O(1)
+
+Example:
+ - This removes 5 from the filter
+
+    int key = 5;
+    CuckooFilter_Remove(f, &key);
+
+*/
+bool CuckooFilter_Remove(CuckooFilter* f, void* key);
+
+/*
+Adds a contiguous array of keys to the CuckooFilter.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* keys: the memory address of count keys stored back to back.
+ - int count: the number of keys in the array.
+
+Outputs:
+ - int: the number of keys which were added before the filter became full.
+
+Time Complexity: O(k)
+
+Example:
+ - This adds three keys at once
+
+    int keys[3] = {1, 2, 3};
+    CuckooFilter_AddMany(f, keys, 3);
+
+*/
+int CuckooFilter_AddMany(CuckooFilter* f, void* keys, int count);
+
+/*
+Checks a contiguous array of keys against the CuckooFilter.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* keys: the memory address of count keys stored back to back.
+ - int count: the number of keys in the array.
+ - bool* results: an array of count booleans to write each result to, may be NULL.
+
+Outputs:
+ - int: the number of keys which may be in the filter.
+
+Time Complexity: O(k)
+
+Example:
+ - This checks three keys at once
+
+    int keys[3] = {1, 2, 3};
+    bool results[3];
+    CuckooFilter_ContainsMany(f, keys, 3, results);
+
+*/
+int CuckooFilter_ContainsMany(CuckooFilter* f, void* keys, int count, bool* results);
+
+/*
+Returns the number of bytes needed to serialize the CuckooFilter.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+
+Outputs:
+ - size_t: the size in bytes of the serialized filter.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of a buffer to serialize into
+
+    size_t length = CuckooFilter_SerializedSize(f);
+
+*/
+size_t CuckooFilter_SerializedSize(CuckooFilter* f);
+
+/*
+Writes the CuckooFilter, including its seeds, into a buffer.
+The format uses the byte order of the machine it was written on.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* buffer: a memory address with at least CuckooFilter_SerializedSize bytes.
+
+Time Complexity: O(m)
+
+Example:
+ - This serializes a filter
+
+    void* buffer = malloc(CuckooFilter_SerializedSize(f));
+    CuckooFilter_Serialize(f, buffer);
+
+*/
+void CuckooFilter_Serialize(CuckooFilter* f, void* buffer);
+
+/*
+Initialises a CuckooFilter structure from a buffer written by CuckooFilter_Serialize.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+ - void* buffer: the memory address of the serialized filter.
+ - size_t length: the size in bytes of the buffer.
+
+Outputs:
+ - 0: if the buffer does not hold a valid filter, the structure is left uninitialised.
+ - 1: if the filter was successfully read.
+
+Time Complexity: O(m)
+
+Example:
+ - This reads a filter back
+
+    CuckooFilter_Deserialize(f, buffer, length);
+
+*/
+bool CuckooFilter_Deserialize(CuckooFilter* f, void* buffer, size_t length);
+
+/*
+Clears all keys from a given CuckooFilter structure.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+
+Time Complexity: O(m)
+
+Example:
+ - This clears a filter.
+
+    CuckooFilter_Clear(f);
+
+*/
+void CuckooFilter_Clear(CuckooFilter* f);
+
+/*
+Frees all memory associated with an initialised CuckooFilter structure.
+
+Inputs:
+ - CuckooFilter* f: the memory address of the CuckooFilter structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    CuckooFilter_Free(f);
+
+*/
+void CuckooFilter_Free(CuckooFilter* f);
+
+#endif
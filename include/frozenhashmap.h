@@ -0,0 +1,106 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "hashmap.h"
+
+#ifndef FROZENHASHMAP_H
+#define FROZENHASHMAP_H
+
+struct FrozenHashMap {
+
+    size_t key_size;
+    size_t value_size;
+    size_t size;
+    size_t buckets;
+
+    uint32_t* pilots;
+    uint8_t* entries;
+
+    uint64_t seed_0;
+    uint64_t seed_1;
+
+};
+typedef struct FrozenHashMap FrozenHashMap;
+
+/*
+Builds an immutable copy of a HashMap using a minimal perfect hash.
+Keys and values are packed back to back with no empty slots, and every lookup probes exactly one entry.
+The HashMap is left unchanged and may be freed afterwards.
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure to copy.
+ - FrozenHashMap* f: the memory address of the FrozenHashMap structure to initialise.
+
+Time Complexity: Expected O(n log n)
+
+Example:
+ - This freezes a map once it has been populated.
+
+    FrozenHashMap* f = malloc(sizeof(FrozenHashMap));
+    HashMap_Freeze(h, f);
+    HashMap_Free(h);
+
+*/
+void HashMap_Freeze(HashMap* h, FrozenHashMap* f);
+
+/*
+Returns the number of elements that are stored in the FrozenHashMap.
+
+Inputs:
+ - FrozenHashMap* f: the memory address of the FrozenHashMap structure.
+
+Outputs:
+ - int: the number of elements that are stored in the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of the map
+
+    int size = FrozenHashMap_Size(f);
+
+*/
+int FrozenHashMap_Size(FrozenHashMap* f);
+
+/*
+Given a key, gets the associated value of the key in the FrozenHashMap.
+
+Inputs:
+ - FrozenHashMap* f: the memory address of the FrozenHashMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* buffer: a memory address where the value will be placed if found.
+
+Outputs:
+ - 0: if the object could not be found in the map.
+ - 1: if the object was successfully retrieved from the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the value stored at 1.0f in the map
+
+    float key = 1.0f;
+    int buffer;
+
+    FrozenHashMap_Get(f, &key, &buffer);
+
+*/
+bool FrozenHashMap_Get(FrozenHashMap* f, void* key, void* buffer);
+
+/*
+Frees all memory associated with an initialised FrozenHashMap structure.
+
+Inputs:
+ - FrozenHashMap* f: the memory address of the FrozenHashMap structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    FrozenHashMap_Free(f);
+
+*/
+void FrozenHashMap_Free(FrozenHashMap* f);
+
+#endif
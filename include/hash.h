@@ -3,7 +3,20 @@
 #ifndef HASH_H
 #define HASH_H
 
+// Jenkins' one-at-a-time hash of a NUL terminated string. It works in 32 bits, so the top half of the result is always 0.
 uint64_t OAAT(const char* in);
+
+// SipHash-2-4 of inlen bytes, keyed by two seeds. This is the hash the tables use.
 uint64_t SIP64(const uint8_t* in, const size_t inlen, uint64_t seed0, uint64_t seed1);
 
+// Returns a fresh 64 bit seed for keying the hash functions of a table or filter.
+// Seeds come from a per process random value expanded by a fast per thread generator.
+uint64_t SEED64(void);
+
+// Makes SEED64 repeat the same sequence on every run, for reproducible benchmarks.
+// Each thread gets its own sequence, numbered by the order in which threads first ask for a seed.
+// Call it before other threads create tables, and use SEED64_Unpin to go back to random seeds.
+void SEED64_Pin(uint64_t seed);
+void SEED64_Unpin(void);
+
 #endif
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdatomic.h>
+#include "list.h"
 
 #ifndef HASHMAP_H
 #define HASHMAP_H
@@ -12,6 +14,23 @@ struct KeyValue {
 };
 typedef struct KeyValue KeyValue;
 
+// The layout of the table behind a HashMap, chosen when it is initialised.
+enum HashMapEngine {
+
+    // Two tables with one slot for a key in each, so a get looks at two slots at most. A put may have
+    // to move other keys along to make room, and the tables are kept at most half full.
+    HASHMAP_CUCKOO,
+
+    // One open addressing table with a byte per slot holding 7 bits of the hash of its key. A get compares
+    // the bytes of 16 slots at once and only the keys whose byte matches, and the table is kept up to 7/8 full.
+    HASHMAP_SWISS
+
+};
+typedef enum HashMapEngine HashMapEngine;
+
+// While n is 0 the map is small: array holds at most 8 pairs, allocated on the first put and
+// searched linearly, and the seeds are unset. Growing past that builds the tables of the engine,
+// which are the left and right tables of n buckets each, or a swiss table of n slots.
 struct HashMap {
     
     size_t key_size;
@@ -28,6 +47,16 @@ struct HashMap {
     uint64_t right_seed_0;
     uint64_t right_seed_1;
 
+    // Swiss tables only use the left seeds, and count their deleted slots.
+    HashMapEngine engine;
+    size_t deleted;
+
+    atomic_uint_fast64_t version;
+    bool concurrent;
+
+    // Set once the map has been cloned, see HashMap_Clone.
+    struct _HashMapShare* share;
+
 };
 typedef struct HashMap HashMap;
 
@@ -50,6 +79,50 @@ Example:
 */
 void HashMap_Init(HashMap* h, size_t key_size, size_t value_size);
 
+/*
+Initialises the memory of a HashMap structure which uses the given engine, as HashMap_Init uses HASHMAP_CUCKOO.
+Both engines behave the same through every HashMap function, so the engine can be picked for the workload.
+Swiss tables suit maps with many puts and removes, which they make without moving other pairs and with less
+memory per pair, at the cost of gets comparing more keys. Swiss maps are copied outright by HashMap_Clone.
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure.
+ - size_t key_size: the size in bytes of the key datatype.
+ - size_t value_size: the size in bytes of the value datatype.
+ - HashMapEngine engine: HASHMAP_CUCKOO or HASHMAP_SWISS.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a swiss map with integer keys and values.
+
+    HashMap* h = malloc(sizeof(HashMap));
+    HashMap_InitEngine(h, sizeof(int), sizeof(int), HASHMAP_SWISS);
+
+*/
+void HashMap_InitEngine(HashMap* h, size_t key_size, size_t value_size, HashMapEngine engine);
+
+/*
+Lets threads read a HashMap with HashMap_Get while another thread writes to it, without any locks.
+There may be one writer at a time, calling HashMap_Put, HashMap_Remove and HashMap_Grow, and any number of readers.
+Readers never block the writer, and retry if the writer changed the map while they were looking.
+Keys, values and tables let go of by the writer are freed through Epoch_Retire once no reader can be using them.
+The other functions, including HashMap_Free, must not run while there are readers.
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure.
+ - bool concurrent: 1 to allow concurrent readers, 0 to go back to freeing memory straight away.
+
+Time Complexity: O(1)
+
+Example:
+ - This shares a map with reader threads
+
+    HashMap_SetConcurrent(h, 1);
+
+*/
+void HashMap_SetConcurrent(HashMap* h, bool concurrent);
+
 /*
 Returns the number of elements that are stored in the HashMap.
 
@@ -113,6 +186,31 @@ Example:
 */
 bool HashMap_Get(HashMap* h, void* key, void* buffer);
 
+/*
+Given a key, returns the address where its value is stored in the HashMap, so it can be read or changed in place.
+Values never move once put, so the address stays valid until the key is removed or the map is cleared or freed.
+After HashMap_Clone the value is shared with the clone again, until HashMap_Reference is called once more.
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - void*: the memory address of the value, or NULL if the key is not in the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This adds 1 to the integer value stored at 1.0f in the map
+
+    float key = 1.0f;
+
+    int* value = HashMap_Reference(h, &key);
+    if (value != NULL) {*value += 1;}
+
+*/
+void* HashMap_Reference(HashMap* h, void* key);
+
 /*
 Given a key, removes the associated key/value pair in the HashMap.
 
@@ -157,6 +255,99 @@ Example:
 */
 void HashMap_Put(HashMap* h, void* key, void* value);
 
+/*
+Initialises a HashMap structure holding the key/value pairs of two arrays.
+The table is sized once for the whole input, the keys are hashed and the pairs are copied on the threads
+of the ThreadPool, so this is much faster than putting each pair in turn. The result is a normal HashMap using
+the cuckoo engine.
+When a key appears more than once, it keeps the position of its first appearance and its last value.
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure.
+ - size_t key_size: the size in bytes of the key datatype being stored.
+ - size_t value_size: the size in bytes of the value datatype being stored.
+ - void* keys: the memory address of an array of count keys.
+ - void* values: the memory address of an array of count values.
+ - int count: the number of key/value pairs.
+ - int threads: the number of parts to split the work into, or 0 for one per thread of the ThreadPool.
+
+Time Complexity: O(n / p)
+
+Example:
+ - This builds a map from two arrays
+
+    float keys[3] = {1.0f, 2.0f, 3.0f};
+    int values[3] = {100, 200, 300};
+
+    HashMap* h = malloc(sizeof(HashMap));
+    HashMap_BuildFrom(h, sizeof(float), sizeof(int), keys, values, 3, 0);
+
+*/
+void HashMap_BuildFrom(HashMap* h, size_t key_size, size_t value_size, void* keys, void* values, int count, int threads);
+
+/*
+Copies the next batch of key/value pairs of an incremental scan into lists, and returns the cursor to continue from.
+A scan starts with cursor 0 and is finished when 0 is returned. The map keeps no state about the scan, so
+it can be put to, removed from and grown between calls, and the scan can be abandoned at any time.
+Every key which is in the map for the whole scan is returned at least once, some may be returned more than once.
+Keys put or removed during the scan may or may not be returned.
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure.
+ - uint64_t cursor: 0 to start a scan, or the value returned by the previous call.
+ - int count: the number of pairs to aim for, a batch may be a little larger or smaller.
+ - List* keys: a list of key sized elements which the keys are pushed to, or NULL.
+ - List* values: a list of value sized elements which the values are pushed to, or NULL.
+
+Outputs:
+ - uint64_t: the cursor for the next call, or 0 if the scan is finished.
+
+Time Complexity: O(count)
+
+Example:
+ - This removes every negative value from a map of int keys and values, a batch at a time
+
+    List keys, values;
+    List_Init(&keys, sizeof(int));
+    List_Init(&values, sizeof(int));
+
+    uint64_t cursor = 0;
+    do {
+        cursor = HashMap_Scan(h, cursor, 100, &keys, &values);
+        for (int i = 0; i < List_Length(&keys); i++) {
+            if (*(int*) List_Elements(&values)[i] < 0) {HashMap_Remove(h, List_Elements(&keys)[i]);}
+        }
+        List_Clear(&keys);
+        List_Clear(&values);
+    } while (cursor != 0);
+
+*/
+uint64_t HashMap_Scan(HashMap* h, uint64_t cursor, int count, List* keys, List* values);
+
+/*
+Initialises a HashMap structure holding the same key/value pairs as another, without copying them.
+The two maps share their table and their keys and values copy-on-write. The table is copied by whichever map
+writes to it first, and the keys and values a group of 1024 buckets at a time, when a pair in the group is
+put or removed, so a writer only copies what it touches. Growing a map copies everything it still shares.
+Either map may be cloned, written to and freed independently of the other, including from different threads.
+Values changed in place through HashMap_Elements are changed in every map sharing them.
+Small maps and maps using the swiss engine are copied outright instead, in O(n).
+
+Inputs:
+ - HashMap* h: the memory address of the HashMap structure to clone.
+ - HashMap* clone: the memory address of the HashMap structure to initialise.
+
+Time Complexity: O(n / 1024)
+
+Example:
+ - This takes a snapshot of a map for another thread to read
+
+    HashMap* snapshot = malloc(sizeof(HashMap));
+    HashMap_Clone(h, snapshot);
+
+*/
+void HashMap_Clone(HashMap* h, HashMap* clone);
+
 /*
 Clears all key-value pairs from a given HashMap structure.
 
@@ -0,0 +1,258 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef HASHSET_H
+#define HASHSET_H
+
+struct SetKey {
+    void* key;
+    struct SetKey* next;
+    struct SetKey* prev;
+};
+typedef struct SetKey SetKey;
+
+struct HashSet {
+
+    size_t key_size;
+    size_t size;
+    size_t n;
+
+    SetKey* array;
+    SetKey* head;
+    SetKey* tail;
+
+    uint64_t left_seed_0;
+    uint64_t left_seed_1;
+    uint64_t right_seed_0;
+    uint64_t right_seed_1;
+
+};
+typedef struct HashSet HashSet;
+
+/*
+Initialises the memory of a HashSet structure.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+ - size_t key_size: the size in bytes of the key datatype.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a set of integers.
+
+    HashSet* s = malloc(sizeof(HashSet));
+    HashSet_Init(s, sizeof(int));
+
+*/
+void HashSet_Init(HashSet* s, size_t key_size);
+
+/*
+Returns the number of keys that are stored in the HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+
+Outputs:
+ - int: the number of keys that are currently stored in the set.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of the set
+
+    int size = HashSet_Size(s);
+
+*/
+int HashSet_Size(HashSet* s);
+
+/*
+Returns a linked list of keys that are stored in the HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+
+Outputs:
+ - SetKey*: a pointer to the first key in the HashSet.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the keys of the set
+
+    SetKey* keys = HashSet_Elements(s);
+
+*/
+SetKey* HashSet_Elements(HashSet* s);
+
+/*
+Checks whether a key is stored in the HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key is not in the set.
+ - 1: if the key is in the set.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks if 5 is in the set
+
+    int key = 5;
+    HashSet_Contains(s, &key);
+
+*/
+bool HashSet_Contains(HashSet* s, void* key);
+
+/*
+Checks a contiguous array of keys against the HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+ - void* keys: the memory address of count keys stored back to back.
+ - int count: the number of keys in the array.
+ - bool* results: an array of count booleans to write each result to, may be NULL.
+
+Outputs:
+ - int: the number of keys which were found in the set.
+
+Time Complexity: O(k)
+
+Example:
+ - This checks three keys at once
+
+    int keys[3] = {1, 2, 3};
+    bool results[3];
+    int found = HashSet_ContainsMany(s, keys, 3, results);
+
+*/
+int HashSet_ContainsMany(HashSet* s, void* keys, int count, bool* results);
+
+/*
+Given a key, removes the key from the HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key could not be found in the set.
+ - 1: if the key was successfully removed from the set.
+
+Time Complexity: O(1)
+
+Example:
+ - This removes 5 from the set
+
+    int key = 5;
+    HashSet_Remove(s, &key);
+
+*/
+bool HashSet_Remove(HashSet* s, void* key);
+
+/*
+Adds a key to the HashSet. Adding a key that is already stored does nothing.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+ - void* key: a memory address which contains data about the key.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This adds 5 to the set
+
+    int key = 5;
+    HashSet_Add(s, &key);
+
+*/
+void HashSet_Add(HashSet* s, void* key);
+
+/*
+Adds every key of another HashSet to the HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure to add to.
+ - HashSet* other: the memory address of the HashSet to read from.
+
+Time Complexity: O(m)
+
+Example:
+ - This makes a the union of a and b
+
+    HashSet_Union(&a, &b);
+
+*/
+void HashSet_Union(HashSet* s, HashSet* other);
+
+/*
+Removes every key from the HashSet which is not stored in another HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure to remove from.
+ - HashSet* other: the memory address of the HashSet to read from.
+
+Time Complexity: O(n)
+
+Example:
+ - This makes a the intersection of a and b
+
+    HashSet_Intersection(&a, &b);
+
+*/
+void HashSet_Intersection(HashSet* s, HashSet* other);
+
+/*
+Removes every key from the HashSet which is stored in another HashSet.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure to remove from.
+ - HashSet* other: the memory address of the HashSet to read from.
+
+Time Complexity: O(min(n, m))
+
+Example:
+ - This makes a the difference of a and b
+
+    HashSet_Difference(&a, &b);
+
+*/
+void HashSet_Difference(HashSet* s, HashSet* other);
+
+/*
+Clears all keys from a given HashSet structure.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This clears a set.
+
+    HashSet_Clear(s);
+
+*/
+void HashSet_Clear(HashSet* s);
+
+/*
+Frees all memory associated with an initialised HashSet structure.
+
+Inputs:
+ - HashSet* s: the memory address of the HashSet structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    HashSet_Free(s);
+
+*/
+void HashSet_Free(HashSet* s);
+
+#endif
@@ -3,6 +3,7 @@
 #ifndef LIST_H
 #define LIST_H
 
+// The elements array is NULL until the first element is added.
 struct List {
 
     void** elements;
@@ -10,6 +11,9 @@ struct List {
     int size;
     int length;
 
+    // Set once the list has been cloned, see List_Clone.
+    struct _ListShare* share;
+
 };
 typedef struct List List;
 
@@ -57,7 +61,7 @@ Inputs:
  - List* l: the memory address of the List structure.
 
 Outputs:
- - void**: the address of the array of pointers where each element is stored.
+ - void**: the address of the array of pointers where each element is stored, NULL if nothing was ever added.
 
 Time Complexity: O(1)
 
@@ -217,6 +221,277 @@ Example:
 */
 bool List_Add(List* l, int index, void* element);
 
+/*
+Given an array of elements, adds them all to the end of the list.
+The list grows at most once, however many elements are added.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - void* elements: the memory address of an array of count elements.
+ - int count: the number of elements in the array.
+
+Time Complexity: O(k)
+
+Example:
+ - This adds three floats to the end of the list
+
+    float elements[3] = {1.0f, 2.0f, 3.0f};
+    List_Extend(l, elements, 3);
+
+*/
+void List_Extend(List* l, void* elements, int count);
+
+/*
+Given an index and an array of elements, adds them all to the list starting at the index.
+All proceeding elements are shifted up once, by the number of elements added.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - int index: the index the first added element will have.
+ - void* elements: the memory address of an array of count elements.
+ - int count: the number of elements in the array.
+
+Outputs:
+ - 0: if the index or count was out of range.
+ - 1: if the elements were added.
+
+Time Complexity: O(n + k)
+
+Example:
+ - This adds three floats starting at index 2 of the list
+
+    float elements[3] = {1.0f, 2.0f, 3.0f};
+    List_InsertRange(l, 2, elements, 3);
+
+*/
+bool List_InsertRange(List* l, int index, void* elements, int count);
+
+/*
+Given a range of indices, removes every element in the range from the list.
+All proceeding elements are shifted down once, by the number of elements removed.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - int start: the index of the first element to remove.
+ - int end: the index after the last element to remove.
+
+Outputs:
+ - 0: if the range was out of bounds.
+ - 1: if the elements were removed.
+
+Time Complexity: O(n)
+
+Example:
+ - This removes the elements at index 2, 3 and 4 from the list
+
+    List_RemoveRange(l, 2, 5);
+
+*/
+bool List_RemoveRange(List* l, int start, int end);
+
+/*
+Given a range of indices, initialises a new List structure with copies of the elements in the range.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - int start: the index of the first element to copy.
+ - int end: the index after the last element to copy.
+ - List* out: the memory address of an uninitialised List structure which receives the copies.
+
+Outputs:
+ - 0: if the range was out of bounds, out is left uninitialised.
+ - 1: if the slice was made.
+
+Time Complexity: O(k)
+
+Example:
+ - This copies the elements at index 2, 3 and 4 into a new list
+
+    List* slice = malloc(sizeof(List));
+    List_Slice(l, 2, 5, slice);
+
+*/
+bool List_Slice(List* l, int start, int end, List* out);
+
+/*
+Initialises a List structure holding the same elements as another, without copying them.
+The two lists share their pointer array and their elements copy-on-write. The pointer array is copied by whichever
+list changes first, and the elements a chunk of 1024 indices at a time, when an element in the chunk is added,
+removed or moved, so pushing and popping only copy the last chunk while inserting at the front copies them all.
+Either list may be cloned, changed and freed independently of the other, including from different threads.
+Elements changed in place through List_Elements are changed in every list sharing them.
+
+Inputs:
+ - List* l: the memory address of the List structure to clone.
+ - List* clone: the memory address of an uninitialised List structure.
+
+Time Complexity: O(n / 1024)
+
+Example:
+ - This takes a snapshot of a list for another thread to read
+
+    List* snapshot = malloc(sizeof(List));
+    List_Clone(l, snapshot);
+
+*/
+void List_Clone(List* l, List* clone);
+
+/*
+Removes every element of a List structure for which the remove function returns 1, keeping the order of the rest.
+The remaining elements are moved at most once. This is the opposite of List_Filter, which keeps the elements its
+function accepts. RemoveIf calls its function in order on the calling thread.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - bool (*remove)(const void*, void*): returns whether to remove an element, given the element and the argument.
+ - void* arg: an argument passed to every call.
+
+Outputs:
+ - int: the number of elements that were removed.
+
+Time Complexity: O(n)
+
+Example:
+ - This removes every negative float
+
+    bool negative(const void* element, void* arg) {return *(float*)element < 0.0f;}
+    List_RemoveIf(l, negative, NULL);
+
+*/
+int List_RemoveIf(List* l, bool (*remove)(const void*, void*), void* arg);
+
+/*
+Sorts the elements of a List structure in ascending order.
+The sort is a stable merge sort which is spread over the threads of the ThreadPool for long lists.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - int (*compare)(const void*, const void*): compares two elements like the comparator of qsort.
+
+Time Complexity: O(n log n / p)
+
+Example:
+ - This sorts a list of floats
+
+    int compare(const void* a, const void* b) {return (*(float*)a > *(float*)b) - (*(float*)a < *(float*)b);}
+    List_Sort(l, compare);
+
+*/
+void List_Sort(List* l, int (*compare)(const void*, const void*));
+
+/*
+Sorts the elements of a List structure of fixed width integers in ascending order.
+The sort is a stable least significant digit radix sort which does not call a comparator at all.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - bool is_signed: whether the elements are signed integers.
+
+Outputs:
+ - 0: if the elements are not 1, 2, 4 or 8 bytes wide.
+ - 1: if the list was sorted.
+
+Time Complexity: O(n / p)
+
+Example:
+ - This sorts a list of integers
+
+    List_SortIntegers(l, 1);
+
+*/
+bool List_SortIntegers(List* l, bool is_signed);
+
+/*
+Calls a function on every element of a List structure, which may change the element in place.
+The calls are spread over the threads of the ThreadPool, so the function must be safe to call at once.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - void (*function)(void*, void*): the function to call with each element and the argument.
+ - void* arg: an argument passed to every call.
+
+Time Complexity: O(n / p)
+
+Example:
+ - This doubles every float in the list
+
+    void twice(void* element, void* arg) {*(float*)element *= 2.0f;}
+    List_Map(l, twice, NULL);
+
+*/
+void List_Map(List* l, void (*function)(void*, void*), void* arg);
+
+/*
+Keeps only the elements of a List structure for which the keep function returns 1, in their original order.
+This is the opposite of List_RemoveIf, which removes the elements its function accepts. Filter calls its
+function on the threads of the ThreadPool, so the function must be safe to call at once.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - bool (*keep)(const void*, void*): returns whether to keep an element, given the element and the argument.
+ - void* arg: an argument passed to every call.
+
+Outputs:
+ - int: the number of elements that were removed.
+
+Time Complexity: O(n / p)
+
+Example:
+ - This keeps only the positive floats
+
+    bool positive(const void* element, void* arg) {return *(float*)element > 0.0f;}
+    List_Filter(l, positive, NULL);
+
+*/
+int List_Filter(List* l, bool (*keep)(const void*, void*), void* arg);
+
+/*
+Combines every element of a List structure into one value.
+The buffer must hold the identity of the combining function, and receives the result.
+Each thread combines a run of elements starting from the identity, then the runs are combined in order,
+so the function must be associative.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - void (*combine)(void*, const void*, void*): combines the element in the second argument into the value in the first.
+ - void* arg: an argument passed to every call.
+ - void* buffer: the memory address of the identity, where the result will be stored.
+
+Time Complexity: O(n / p)
+
+Example:
+ - This sums a list of floats
+
+    void add(void* total, const void* element, void* arg) {*(float*)total += *(float*)element;}
+
+    float sum = 0.0f;
+    List_Reduce(l, add, NULL, &sum);
+
+*/
+void List_Reduce(List* l, void (*combine)(void*, const void*, void*), void* arg, void* buffer);
+
+/*
+Given an element, finds it in a List structure that is sorted in ascending order.
+
+Inputs:
+ - List* l: the memory address of the List structure.
+ - void* element: the memory address where the element to find is stored.
+ - int (*compare)(const void*, const void*): the comparator the list is sorted by.
+
+Outputs:
+ - int: the index of the first matching element, or -1 if there is no match.
+
+Time Complexity: O(log n)
+
+Example:
+ - This finds a float in a sorted list
+
+    float element = 4.0f;
+    int index = List_BinarySearch(l, &element, compare);
+
+*/
+int List_BinarySearch(List* l, void* element, int (*compare)(const void*, const void*));
+
 /*
 Clears all elements from a given List structure.
 
@@ -0,0 +1,195 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef MAPPEDHASHMAP_H
+#define MAPPEDHASHMAP_H
+
+// The first bytes of the file. The two cuckoo tables of 2 * n slots follow it.
+struct MappedHashMapHeader {
+
+    char magic[8];
+    uint64_t key_size;
+    uint64_t value_size;
+    uint64_t size;
+    uint64_t n;
+
+    uint64_t left_seed_0;
+    uint64_t left_seed_1;
+    uint64_t right_seed_0;
+    uint64_t right_seed_1;
+
+};
+typedef struct MappedHashMapHeader MappedHashMapHeader;
+
+struct MappedHashMap {
+
+    int fd;
+    size_t length;
+    size_t stride;
+
+    MappedHashMapHeader* header;
+    uint8_t* slots;
+
+};
+typedef struct MappedHashMap MappedHashMap;
+
+/*
+Opens a HashMap stored in a file, creating the file if it does not exist.
+The file is mapped into memory, so the map may be larger than RAM and is still there after a restart.
+Keys and values are stored in the file by value, each slot being a used flag followed by the key and the value.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+ - const char* path: the path of the file.
+ - size_t key_size: the size in bytes of the key datatype.
+ - size_t value_size: the size in bytes of the value datatype.
+
+Outputs:
+ - 0: if the file could not be opened or mapped, or holds a map with different key or value sizes.
+ - 1: if the map was opened.
+
+Time Complexity: O(1)
+
+Example:
+ - This opens a map from integers to doubles stored in index.map
+
+    MappedHashMap m;
+    MappedHashMap_Open(&m, "index.map", sizeof(int), sizeof(double));
+
+*/
+bool MappedHashMap_Open(MappedHashMap* m, const char* path, size_t key_size, size_t value_size);
+
+/*
+Returns the number of elements that are stored in the MappedHashMap.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+
+Outputs:
+ - int: the number of elements that are stored in the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of the map
+
+    int size = MappedHashMap_Size(&m);
+
+*/
+int MappedHashMap_Size(MappedHashMap* m);
+
+/*
+Given a key, gets the associated value of the key in the MappedHashMap.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* buffer: a memory address where the value will be placed if found.
+
+Outputs:
+ - 0: if the object could not be found in the map.
+ - 1: if the object was successfully retrieved from the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the value stored at 1 in the map
+
+    int key = 1;
+    double buffer;
+
+    MappedHashMap_Get(&m, &key, &buffer);
+
+*/
+bool MappedHashMap_Get(MappedHashMap* m, void* key, void* buffer);
+
+/*
+Given a key/value pair, adds/updates the key/value pair in the MappedHashMap.
+The file is extended and mapped again when the tables need to grow. If it cannot be mapped again, the map is
+left as it was, though the file may stay extended when it cannot be shrunk back, with the extra space unused.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* value: a memory address which contains data about the value.
+
+Outputs:
+ - 0: if the file could not be extended, the map is left as it was.
+ - 1: if the key/value pair was stored.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This adds a key/value pair to the map.
+
+    int key = 1;
+    double value = 2.5;
+
+    MappedHashMap_Put(&m, &key, &value);
+
+*/
+bool MappedHashMap_Put(MappedHashMap* m, void* key, void* value);
+
+/*
+Given a key, removes the associated key/value pair in the MappedHashMap.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key could not be found in the map.
+ - 1: if the key/value pair was successfully removed from the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This removes the key/value pair associated with 1 in the map
+
+    int key = 1;
+
+    MappedHashMap_Remove(&m, &key);
+
+*/
+bool MappedHashMap_Remove(MappedHashMap* m, void* key);
+
+/*
+Writes every change made to the map back to the file, and waits for the writes to finish.
+Without it, changes reach the file whenever the operating system decides, and at the latest on close.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+
+Outputs:
+ - 0: if the changes could not be written.
+ - 1: if the file is up to date.
+
+Time Complexity: O(n)
+
+Example:
+ - This makes the map durable before acknowledging a write
+
+    MappedHashMap_Put(&m, &key, &value);
+    MappedHashMap_Sync(&m);
+
+*/
+bool MappedHashMap_Sync(MappedHashMap* m);
+
+/*
+Unmaps and closes the file of a MappedHashMap. The contents stay in the file.
+
+Inputs:
+ - MappedHashMap* m: the memory address of the MappedHashMap structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This closes the map.
+
+    MappedHashMap_Close(&m);
+
+*/
+void MappedHashMap_Close(MappedHashMap* m);
+
+#endif
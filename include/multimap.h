@@ -0,0 +1,251 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "hashmap.h"
+
+#ifndef MULTIMAP_H
+#define MULTIMAP_H
+
+// Each key maps to one run, a single block holding all of its values back to back.
+struct MultiMap {
+
+    size_t value_size;
+    size_t size;
+
+    HashMap runs;
+
+};
+typedef struct MultiMap MultiMap;
+
+/*
+Initialises the memory of a MultiMap structure, a map from each key to any number of values.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+ - size_t key_size: the size in bytes of the key datatype.
+ - size_t value_size: the size in bytes of the value datatype.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a map from integer terms to the integer ids of the documents they appear in.
+
+    MultiMap* m = malloc(sizeof(MultiMap));
+    MultiMap_Init(m, sizeof(int), sizeof(int));
+
+*/
+void MultiMap_Init(MultiMap* m, size_t key_size, size_t value_size);
+
+/*
+Returns the number of values that are stored in the MultiMap, across every key.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+
+Outputs:
+ - int: the number of values.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the number of values in the map
+
+    int size = MultiMap_Size(m);
+
+*/
+int MultiMap_Size(MultiMap* m);
+
+/*
+Returns the number of keys that have at least one value in the MultiMap.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+
+Outputs:
+ - int: the number of keys.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the number of keys in the map
+
+    int keys = MultiMap_Keys(m);
+
+*/
+int MultiMap_Keys(MultiMap* m);
+
+/*
+Adds a value to the end of the values of a key. A key may hold the same value more than once.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* value: a memory address which contains data about the value.
+
+Time Complexity: Amortised O(1)
+
+Example:
+ - This records that term 7 appears in document 100.
+
+    int term = 7;
+    int document = 100;
+
+    MultiMap_Put(m, &term, &document);
+
+*/
+void MultiMap_Put(MultiMap* m, void* key, void* value);
+
+/*
+Given a key, returns the address of its values, which are stored back to back in the order they were put.
+The address stays valid until the values of the key are next changed.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+ - void* key: a memory address which contains data about the key.
+ - int* count: a memory address where the number of values is placed, or NULL.
+
+Outputs:
+ - void*: the memory address of the first value, or NULL if the key has no values.
+
+Time Complexity: O(1)
+
+Example:
+ - This sums the documents which term 7 appears in
+
+    int term = 7;
+    int count;
+    int sum = 0;
+
+    int* documents = MultiMap_Get(m, &term, &count);
+    for (int i = 0; i < count; i++) {sum += documents[i];}
+
+*/
+void* MultiMap_Get(MultiMap* m, void* key, int* count);
+
+/*
+Removes the first value of a key which is equal to the given value, keeping the order of the others.
+The key is removed along with its last value.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* value: a memory address which contains data about the value.
+
+Outputs:
+ - 0: if the key does not hold the value.
+ - 1: if the value was removed.
+
+Time Complexity: O(k), where k is the number of values of the key.
+
+Example:
+ - This records that term 7 no longer appears in document 100
+
+    int term = 7;
+    int document = 100;
+
+    MultiMap_RemoveValue(m, &term, &document);
+
+*/
+bool MultiMap_RemoveValue(MultiMap* m, void* key, void* value);
+
+/*
+Removes a key along with all of its values.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key was not in the map.
+ - 1: if the key was removed.
+
+Time Complexity: O(1)
+
+Example:
+ - This forgets term 7
+
+    int term = 7;
+
+    MultiMap_Remove(m, &term);
+
+*/
+bool MultiMap_Remove(MultiMap* m, void* key);
+
+/*
+Returns a linked list of the keys in the MultiMap, in the order they were first put. The values of
+each element are found with MultiMap_Values.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+
+Outputs:
+ - KeyValue*: a pointer to the first key, or NULL if the map is empty.
+
+Time Complexity: O(1)
+
+Example:
+ - This counts the documents of every term
+
+    for (KeyValue* e = MultiMap_Elements(m); e != NULL; e = e->next) {
+        int count;
+        MultiMap_Values(e, &count);
+        printf("%d: %d\n", *(int*) e->key, count);
+    }
+
+*/
+KeyValue* MultiMap_Elements(MultiMap* m);
+
+/*
+Returns the values of an element of the list returned by MultiMap_Elements, in the same way as MultiMap_Get.
+
+Inputs:
+ - KeyValue* element: an element of the list of keys.
+ - int* count: a memory address where the number of values is placed, or NULL.
+
+Outputs:
+ - void*: the memory address of the first value.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the values of the first key
+
+    int count;
+    int* documents = MultiMap_Values(MultiMap_Elements(m), &count);
+
+*/
+void* MultiMap_Values(KeyValue* element, int* count);
+
+/*
+Clears all keys and values from a given MultiMap structure.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This clears a multimap.
+
+    MultiMap_Clear(m);
+
+*/
+void MultiMap_Clear(MultiMap* m);
+
+/*
+Frees all memory associated with an initialised MultiMap structure.
+
+Inputs:
+ - MultiMap* m: the memory address of the MultiMap structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    MultiMap_Free(m);
+
+*/
+void MultiMap_Free(MultiMap* m);
+
+#endif
@@ -0,0 +1,94 @@
+#include <stdbool.h>
+#include <stddef.h>
+
+#ifndef PAGES_H
+#define PAGES_H
+
+// Allocations of at least this many bytes are mapped directly rather than taken from malloc.
+#define PAGES_LARGE (2 * 1024 * 1024)
+
+// Options for the large allocations of the library, which can be combined.
+#define PAGES_HUGE 1
+#define PAGES_INTERLEAVE 2
+#define PAGES_BIND 4
+
+/*
+Sets how the library allocates large tables, such as the arrays of a HashMap or a List.
+With PAGES_HUGE they are backed by 2MB huge pages, from the reserved pool if there is one and otherwise
+by asking for transparent huge pages, which cuts the TLB misses of random probes into multi-GB tables.
+With PAGES_INTERLEAVE their pages are spread over every NUMA node, and with PAGES_BIND they are kept on one.
+Every option is a hint, allocations fall back to normal pages when it cannot be met. Small allocations are unaffected.
+
+Inputs:
+ - int options: PAGES_HUGE, PAGES_INTERLEAVE and PAGES_BIND combined with |, or 0 for normal pages.
+ - int node: the NUMA node used with PAGES_BIND, ignored otherwise.
+
+Time Complexity: O(1)
+
+Example:
+ - This puts large tables on huge pages spread over every node
+
+    Pages_SetOptions(PAGES_HUGE | PAGES_INTERLEAVE, 0);
+
+*/
+void Pages_SetOptions(int options, int node);
+
+/*
+Allocates memory for a table, following the options set by Pages_SetOptions when it is large.
+Large allocations start out zeroed.
+
+Inputs:
+ - size_t size: the number of bytes to allocate.
+
+Outputs:
+ - void*: the memory address of the allocation, or NULL if it failed.
+
+Time Complexity: O(1)
+
+Example:
+ - This allocates an array of a million pointers
+
+    void** array = Pages_Alloc(1000000 * sizeof(void*));
+
+*/
+void* Pages_Alloc(size_t size);
+
+/*
+Resizes memory allocated by Pages_Alloc, keeping its contents up to the smaller of the two sizes.
+
+Inputs:
+ - void* memory: the memory address of the allocation, or NULL.
+ - size_t old_size: the size in bytes which it was allocated with.
+ - size_t size: the new size in bytes.
+
+Outputs:
+ - void*: the memory address of the resized allocation, or NULL if it failed, leaving the old one in place.
+
+Time Complexity: O(n)
+
+Example:
+ - This doubles the array
+
+    array = Pages_Realloc(array, 1000000 * sizeof(void*), 2000000 * sizeof(void*));
+
+*/
+void* Pages_Realloc(void* memory, size_t old_size, size_t size);
+
+/*
+Frees memory allocated by Pages_Alloc.
+
+Inputs:
+ - void* memory: the memory address of the allocation, or NULL.
+ - size_t size: the size in bytes which it was allocated with.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees the array
+
+    Pages_Free(array, 2000000 * sizeof(void*));
+
+*/
+void Pages_Free(void* memory, size_t size);
+
+#endif
@@ -0,0 +1,260 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "list.h"
+
+#ifndef PRIORITYQUEUE_H
+#define PRIORITYQUEUE_H
+
+struct PriorityQueue {
+
+    size_t element_size;
+    int arity;
+    int length;
+    int size;
+
+    uint8_t* elements;
+    int* handles;
+
+    int* positions;
+    int handle_size;
+    int* free_handles;
+    int free_length;
+    int next_handle;
+
+    int (*compare)(const void*, const void*);
+    uint8_t* buffer;
+
+};
+typedef struct PriorityQueue PriorityQueue;
+
+/*
+Initialises the memory of a PriorityQueue structure.
+Elements are stored inline in a d-ary heap, and the element which compares lowest comes out first.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - size_t element_size: the size in bytes of the element datatype being stored.
+ - int arity: the number of children of each heap node, 4 keeps siblings in one cache line for small elements.
+ - int (*compare)(const void*, const void*): returns a negative, zero or positive number like the comparator of qsort.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a 4-ary min heap of integers
+
+    int compare(const void* a, const void* b) {return (*(int*)a > *(int*)b) - (*(int*)a < *(int*)b);}
+
+    PriorityQueue* pq = malloc(sizeof(PriorityQueue));
+    PriorityQueue_Init(pq, sizeof(int), 4, compare);
+
+*/
+void PriorityQueue_Init(PriorityQueue* pq, size_t element_size, int arity, int (*compare)(const void*, const void*));
+
+/*
+Returns the number of elements that are stored in the PriorityQueue.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+
+Outputs:
+ - int: the number of elements that are currently stored in the queue.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the length of the queue
+
+    int length = PriorityQueue_Length(pq);
+
+*/
+int PriorityQueue_Length(PriorityQueue* pq);
+
+/*
+Pushes an element into the PriorityQueue.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - void* element: the memory address where the element is stored.
+
+Outputs:
+ - int: a handle which refers to the element until it leaves the queue.
+
+Time Complexity: O(log n)
+
+Example:
+ - This pushes an element into the queue
+
+    int element = 3;
+    int handle = PriorityQueue_Push(pq, &element);
+
+*/
+int PriorityQueue_Push(PriorityQueue* pq, void* element);
+
+/*
+Stores the first element of the PriorityQueue in the buffer without removing it.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - void* buffer: a memory address where the element will be stored.
+
+Outputs:
+ - 0: if the queue is empty or the buffer is NULL.
+ - 1: if the element was returned.
+
+Time Complexity: O(1)
+
+Example:
+ - This looks at the first element
+
+    int buffer;
+    PriorityQueue_Peek(pq, &buffer);
+
+*/
+bool PriorityQueue_Peek(PriorityQueue* pq, void* buffer);
+
+/*
+Stores the first element of the PriorityQueue in the buffer, then removes it from the queue.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - void* buffer: a memory address where the element will be stored, may be NULL.
+
+Outputs:
+ - 0: if the queue is empty.
+ - 1: if the element was removed.
+
+Time Complexity: O(log n)
+
+Example:
+ - This pops the first element
+
+    int buffer;
+    PriorityQueue_Pop(pq, &buffer);
+
+*/
+bool PriorityQueue_Pop(PriorityQueue* pq, void* buffer);
+
+/*
+Given a handle, gets the element it refers to.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - int handle: a handle returned by PriorityQueue_Push.
+ - void* buffer: a memory address where the element will be stored.
+
+Outputs:
+ - 0: if the handle does not refer to an element in the queue, or the buffer is NULL.
+ - 1: if the element was returned.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads an element by its handle
+
+    int buffer;
+    PriorityQueue_Get(pq, handle, &buffer);
+
+*/
+bool PriorityQueue_Get(PriorityQueue* pq, int handle, void* buffer);
+
+/*
+Given a handle, replaces the element it refers to and moves it to its new place in the queue.
+This covers both decreasing and increasing the key of an element.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - int handle: a handle returned by PriorityQueue_Push.
+ - void* element: the memory address where the new element is stored.
+
+Outputs:
+ - 0: if the handle does not refer to an element in the queue.
+ - 1: if the element was updated.
+
+Time Complexity: O(log n)
+
+Example:
+ - This lowers the key of an element
+
+    int element = 1;
+    PriorityQueue_Update(pq, handle, &element);
+
+*/
+bool PriorityQueue_Update(PriorityQueue* pq, int handle, void* element);
+
+/*
+Given a handle, removes the element it refers to from the queue.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - int handle: a handle returned by PriorityQueue_Push.
+
+Outputs:
+ - 0: if the handle does not refer to an element in the queue.
+ - 1: if the element was removed.
+
+Time Complexity: O(log n)
+
+Example:
+ - This removes an element by its handle
+
+    PriorityQueue_Remove(pq, handle);
+
+*/
+bool PriorityQueue_Remove(PriorityQueue* pq, int handle);
+
+/*
+Pushes every element of a List into the PriorityQueue, restoring the heap once at the end.
+On a newly initialised queue, the element at index i of the list gets the handle i.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+ - List* l: the memory address of a List storing elements of the same size.
+
+Outputs:
+ - 0: if the list stores elements of a different size.
+ - 1: if the elements were added.
+
+Time Complexity: O(n + m)
+
+Example:
+ - This builds a queue from a list
+
+    PriorityQueue_FromList(pq, l);
+
+*/
+bool PriorityQueue_FromList(PriorityQueue* pq, List* l);
+
+/*
+Clears all elements from a given PriorityQueue structure, and forgets every handle.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This clears a queue.
+
+    PriorityQueue_Clear(pq);
+
+*/
+void PriorityQueue_Clear(PriorityQueue* pq);
+
+/*
+Frees all memory associated with an initialised PriorityQueue structure.
+
+Inputs:
+ - PriorityQueue* pq: the memory address of the PriorityQueue structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees the queue.
+
+    PriorityQueue_Free(pq);
+
+*/
+void PriorityQueue_Free(PriorityQueue* pq);
+
+#endif
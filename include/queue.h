@@ -0,0 +1,421 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <stdatomic.h>
+#include <threads.h>
+
+#ifndef QUEUE_H
+#define QUEUE_H
+
+// Threads which gave up spinning in a wait sleep here until the other side makes progress.
+struct QueueWaiters {
+
+    mtx_t push_mutex;
+    cnd_t not_full;
+    atomic_int pushers;
+
+    mtx_t shift_mutex;
+    cnd_t not_empty;
+    atomic_int shifters;
+
+};
+typedef struct QueueWaiters QueueWaiters;
+
+struct Queue {
+
+    size_t element_size;
+    size_t stride;
+    size_t mask;
+    uint8_t* cells;
+
+    _Alignas(64) atomic_size_t head;
+    _Alignas(64) atomic_size_t tail;
+
+    _Alignas(64) QueueWaiters waiters;
+
+};
+typedef struct Queue Queue;
+
+struct SPSCQueue {
+
+    size_t element_size;
+    size_t mask;
+    uint8_t* elements;
+
+    _Alignas(64) atomic_size_t head;
+    size_t cached_tail;
+
+    _Alignas(64) atomic_size_t tail;
+    size_t cached_head;
+
+    _Alignas(64) QueueWaiters waiters;
+
+};
+typedef struct SPSCQueue SPSCQueue;
+
+/*
+Initialises the memory of a Queue structure.
+A Queue is a bounded lock-free ring which any number of threads may push to and shift from at once.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - size_t element_size: the size in bytes of the element datatype being stored.
+ - size_t capacity: the number of elements the queue can hold, rounded up to a power of two.
+
+Time Complexity: O(n)
+
+Example:
+ - This creates a queue of 1024 integers
+
+    Queue* q = malloc(sizeof(Queue));
+    Queue_Init(q, sizeof(int), 1024);
+
+*/
+void Queue_Init(Queue* q, size_t element_size, size_t capacity);
+
+/*
+Returns the number of elements that are stored in the Queue.
+While other threads are using the queue, this is only a snapshot.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+
+Outputs:
+ - int: the number of elements that are currently stored in the queue.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the length of the queue
+
+    int length = Queue_Length(q);
+
+*/
+int Queue_Length(Queue* q);
+
+/*
+Pushes an element to the end of the Queue, if there is space.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - void* element: the memory address where the element is stored.
+
+Outputs:
+ - 0: if the queue is full.
+ - 1: if the element was pushed.
+
+Time Complexity: O(1)
+
+Example:
+ - This pushes an element to the queue
+
+    int element = 3;
+    Queue_Push(q, &element);
+
+*/
+bool Queue_Push(Queue* q, void* element);
+
+/*
+Stores the first element of the Queue in the buffer, then removes it from the queue.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - void* buffer: a memory address where the element will be stored, may be NULL.
+
+Outputs:
+ - 0: if the queue is empty.
+ - 1: if an element was shifted.
+
+Time Complexity: O(1)
+
+Example:
+ - This shifts the first element off the queue
+
+    int buffer;
+    Queue_Shift(q, &buffer);
+
+*/
+bool Queue_Shift(Queue* q, void* buffer);
+
+/*
+Pushes as many elements of an array as there is space for, claiming them all at once.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - void* elements: the memory address of count elements stored back to back.
+ - int count: the number of elements in the array.
+
+Outputs:
+ - int: the number of elements from the start of the array which were pushed.
+
+Time Complexity: O(k)
+
+Example:
+ - This pushes three elements at once
+
+    int elements[3] = {1, 2, 3};
+    Queue_PushMany(q, elements, 3);
+
+*/
+int Queue_PushMany(Queue* q, void* elements, int count);
+
+/*
+Shifts up to count elements off the Queue into an array, claiming them all at once.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - void* buffer: a memory address with room for count elements.
+ - int count: the maximum number of elements to shift.
+
+Outputs:
+ - int: the number of elements which were shifted.
+
+Time Complexity: O(k)
+
+Example:
+ - This shifts up to three elements at once
+
+    int buffer[3];
+    int shifted = Queue_ShiftMany(q, buffer, 3);
+
+*/
+int Queue_ShiftMany(Queue* q, void* buffer, int count);
+
+/*
+Pushes an element to the end of the Queue, waiting for space if it is full.
+It spins for a short while, then sleeps until a shift makes space, so a stalled producer does not hold a core.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - void* element: the memory address where the element is stored.
+
+Time Complexity: O(1) once there is space
+
+Example:
+ - This pushes an element to the queue
+
+    int element = 3;
+    Queue_PushWait(q, &element);
+
+*/
+void Queue_PushWait(Queue* q, void* element);
+
+/*
+Shifts the first element of the Queue into the buffer, waiting for one if it is empty.
+It spins for a short while, then sleeps until a push arrives, so an idle consumer does not hold a core.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+ - void* buffer: a memory address where the element will be stored, may be NULL.
+
+Time Complexity: O(1) once there is an element
+
+Example:
+ - This waits for the next element
+
+    int buffer;
+    Queue_ShiftWait(q, &buffer);
+
+*/
+void Queue_ShiftWait(Queue* q, void* buffer);
+
+/*
+Frees all memory associated with an initialised Queue structure.
+No other thread may be using the queue.
+
+Inputs:
+ - Queue* q: the memory address of the Queue structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees the queue.
+
+    Queue_Free(q);
+
+*/
+void Queue_Free(Queue* q);
+
+/*
+Initialises the memory of a SPSCQueue structure.
+A SPSCQueue is a bounded lock-free ring for exactly one pushing thread and one shifting thread, which is faster than a Queue.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - size_t element_size: the size in bytes of the element datatype being stored.
+ - size_t capacity: the number of elements the queue can hold, rounded up to a power of two.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a queue of 1024 integers
+
+    SPSCQueue* q = malloc(sizeof(SPSCQueue));
+    SPSCQueue_Init(q, sizeof(int), 1024);
+
+*/
+void SPSCQueue_Init(SPSCQueue* q, size_t element_size, size_t capacity);
+
+/*
+Returns the number of elements that are stored in the SPSCQueue.
+While other threads are using the queue, this is only a snapshot.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+
+Outputs:
+ - int: the number of elements that are currently stored in the queue.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the length of the queue
+
+    int length = SPSCQueue_Length(q);
+
+*/
+int SPSCQueue_Length(SPSCQueue* q);
+
+/*
+Pushes an element to the end of the SPSCQueue, if there is space. Only the producer thread may call this.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - void* element: the memory address where the element is stored.
+
+Outputs:
+ - 0: if the queue is full.
+ - 1: if the element was pushed.
+
+Time Complexity: O(1)
+
+Example:
+ - This pushes an element to the queue
+
+    int element = 3;
+    SPSCQueue_Push(q, &element);
+
+*/
+bool SPSCQueue_Push(SPSCQueue* q, void* element);
+
+/*
+Stores the first element of the SPSCQueue in the buffer, then removes it. Only the consumer thread may call this.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - void* buffer: a memory address where the element will be stored, may be NULL.
+
+Outputs:
+ - 0: if the queue is empty.
+ - 1: if an element was shifted.
+
+Time Complexity: O(1)
+
+Example:
+ - This shifts the first element off the queue
+
+    int buffer;
+    SPSCQueue_Shift(q, &buffer);
+
+*/
+bool SPSCQueue_Shift(SPSCQueue* q, void* buffer);
+
+/*
+Pushes as many elements of an array as there is space for. Only the producer thread may call this.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - void* elements: the memory address of count elements stored back to back.
+ - int count: the number of elements in the array.
+
+Outputs:
+ - int: the number of elements from the start of the array which were pushed.
+
+Time Complexity: O(k)
+
+Example:
+ - This pushes three elements at once
+
+    int elements[3] = {1, 2, 3};
+    SPSCQueue_PushMany(q, elements, 3);
+
+*/
+int SPSCQueue_PushMany(SPSCQueue* q, void* elements, int count);
+
+/*
+Shifts up to count elements off the SPSCQueue into an array. Only the consumer thread may call this.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - void* buffer: a memory address with room for count elements.
+ - int count: the maximum number of elements to shift.
+
+Outputs:
+ - int: the number of elements which were shifted.
+
+Time Complexity: O(k)
+
+Example:
+ - This shifts up to three elements at once
+
+    int buffer[3];
+    int shifted = SPSCQueue_ShiftMany(q, buffer, 3);
+
+*/
+int SPSCQueue_ShiftMany(SPSCQueue* q, void* buffer, int count);
+
+/*
+Pushes an element to the end of the SPSCQueue, waiting for space if it is full.
+It spins for a short while, then sleeps until a shift makes space.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - void* element: the memory address where the element is stored.
+
+Time Complexity: O(1) once there is space
+
+Example:
+ - This pushes an element to the queue
+
+    int element = 3;
+    SPSCQueue_PushWait(q, &element);
+
+*/
+void SPSCQueue_PushWait(SPSCQueue* q, void* element);
+
+/*
+Shifts the first element of the SPSCQueue into the buffer, waiting for one if it is empty.
+It spins for a short while, then sleeps until a push arrives.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+ - void* buffer: a memory address where the element will be stored, may be NULL.
+
+Time Complexity: O(1) once there is an element
+
+Example:
+ - This waits for the next element
+
+    int buffer;
+    SPSCQueue_ShiftWait(q, &buffer);
+
+*/
+void SPSCQueue_ShiftWait(SPSCQueue* q, void* buffer);
+
+/*
+Frees all memory associated with an initialised SPSCQueue structure.
+
+Inputs:
+ - SPSCQueue* q: the memory address of the SPSCQueue structure.
+
+Time Complexity: O(1)
+
+Example:
+ - This frees the queue.
+
+    SPSCQueue_Free(q);
+
+*/
+void SPSCQueue_Free(SPSCQueue* q);
+
+#endif
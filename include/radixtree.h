@@ -0,0 +1,341 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef RADIXTREE_H
+#define RADIXTREE_H
+
+// Keys are stored whole in their leaves, each with its value in front of it.
+struct RadixLeaf {
+    size_t length;
+    _Alignas(max_align_t) uint8_t data[];
+};
+typedef struct RadixLeaf RadixLeaf;
+
+struct RadixTree {
+
+    size_t value_size;
+    size_t size;
+
+    // The root is a node or a leaf, see src/radixtree.c
+    void* root;
+
+};
+typedef struct RadixTree RadixTree;
+
+struct RadixTreeIterator {
+    RadixTree* tree;
+    RadixLeaf* leaf;
+    size_t prefix_length;
+};
+typedef struct RadixTreeIterator RadixTreeIterator;
+
+/*
+Initialises the memory of a RadixTree structure, an adaptive radix tree mapping byte strings of any length to values.
+Lookups cost O(k) in the length of the key rather than a hash and a comparison of fixed-size buffers, and keys
+sharing a prefix can be found together.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - size_t value_size: the size in bytes of the value datatype.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a map from strings to integers.
+
+    RadixTree* t = malloc(sizeof(RadixTree));
+    RadixTree_Init(t, sizeof(int));
+
+*/
+void RadixTree_Init(RadixTree* t, size_t value_size);
+
+/*
+Returns the number of key-value pairs that are stored in the RadixTree.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+
+Outputs:
+ - size_t: the number of keys.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of the tree
+
+    size_t size = RadixTree_Size(t);
+
+*/
+size_t RadixTree_Size(RadixTree* t);
+
+/*
+Copies the value of a key into a buffer.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - const void* key: the memory address of the key bytes.
+ - size_t length: the number of bytes in the key, which may be 0.
+ - void* buffer: a memory address of at least value_size bytes which receives the value.
+
+Outputs:
+ - 0: if the key is not in the tree, which leaves the buffer unchanged.
+ - 1: if the value was copied.
+
+Time Complexity: O(k)
+
+Example:
+ - This gets the value of a string
+
+    int value;
+    RadixTree_Get(t, "apple", 5, &value);
+
+*/
+bool RadixTree_Get(RadixTree* t, const void* key, size_t length, void* buffer);
+
+/*
+Adds a key-value pair to the tree, replacing the value if the key is already there.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - const void* key: the memory address of the key bytes, which are copied.
+ - size_t length: the number of bytes in the key, which may be 0.
+ - void* value: a memory address which contains the value.
+
+Time Complexity: O(k)
+
+Example:
+ - This maps a string to an integer
+
+    int value = 5;
+    RadixTree_Put(t, "apple", 5, &value);
+
+*/
+void RadixTree_Put(RadixTree* t, const void* key, size_t length, void* value);
+
+/*
+Removes a key and its value from the tree, merging nodes left with a single child.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - const void* key: the memory address of the key bytes.
+ - size_t length: the number of bytes in the key.
+
+Outputs:
+ - 0: if the key was not in the tree.
+ - 1: if the key was removed.
+
+Time Complexity: O(k)
+
+Example:
+ - This removes a string
+
+    RadixTree_Remove(t, "apple", 5);
+
+*/
+bool RadixTree_Remove(RadixTree* t, const void* key, size_t length);
+
+/*
+Finds the longest key in the tree which is a prefix of the given bytes, and copies its value into a buffer.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - const void* key: the memory address of the bytes to match.
+ - size_t length: the number of bytes to match.
+ - size_t* match: a memory address which receives the length of the longest matching key, or NULL.
+ - void* buffer: a memory address of at least value_size bytes which receives the value.
+
+Outputs:
+ - 0: if no key is a prefix of the bytes, which leaves match and the buffer unchanged.
+ - 1: if a key was found.
+
+Time Complexity: O(k)
+
+Example:
+ - This routes a path to the handler of its longest registered prefix
+
+    int handler;
+    size_t match;
+    RadixTree_LongestPrefix(t, "/api/v1/users/42", 16, &match, &handler);
+
+*/
+bool RadixTree_LongestPrefix(RadixTree* t, const void* key, size_t length, size_t* match, void* buffer);
+
+/*
+Returns an iterator at the smallest key, which then visits every key in order. Keys are ordered byte by byte,
+with a key coming before any longer key it is a prefix of.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+
+Outputs:
+ - RadixTreeIterator: an iterator which is not valid if the tree is empty.
+
+Time Complexity: O(k)
+
+Example:
+ - This visits every key
+
+    for (RadixTreeIterator it = RadixTree_First(t); RadixTreeIterator_Valid(&it); RadixTreeIterator_Next(&it)) {
+        size_t length;
+        const char* key = RadixTreeIterator_Key(&it, &length);
+    }
+
+*/
+RadixTreeIterator RadixTree_First(RadixTree* t);
+
+/*
+Returns an iterator at the smallest key starting with the given prefix, which then visits every such key in order.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - const void* prefix: the memory address of the prefix bytes, which need not outlive the call.
+ - size_t length: the number of bytes in the prefix.
+
+Outputs:
+ - RadixTreeIterator: an iterator which is not valid if no key starts with the prefix.
+
+Time Complexity: O(k)
+
+Example:
+ - This lists the completions of a word
+
+    for (RadixTreeIterator it = RadixTree_Prefix(t, "app", 3); RadixTreeIterator_Valid(&it); RadixTreeIterator_Next(&it)) {
+        size_t length;
+        const char* completion = RadixTreeIterator_Key(&it, &length);
+    }
+
+*/
+RadixTreeIterator RadixTree_Prefix(RadixTree* t, const void* prefix, size_t length);
+
+/*
+Returns an iterator at the smallest key which is not less than the given key.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+ - const void* key: the memory address of the key bytes.
+ - size_t length: the number of bytes in the key.
+
+Outputs:
+ - RadixTreeIterator: an iterator which is not valid if every key is less than the given key.
+
+Time Complexity: O(k)
+
+Example:
+ - This visits the keys from "m" onwards
+
+    RadixTreeIterator it = RadixTree_LowerBound(t, "m", 1);
+
+*/
+RadixTreeIterator RadixTree_LowerBound(RadixTree* t, const void* key, size_t length);
+
+/*
+Checks whether an iterator points at a key. Iterators are invalidated by any change to the tree.
+
+Inputs:
+ - RadixTreeIterator* it: the memory address of the iterator.
+
+Outputs:
+ - 0: if the iterator has run off the end of the tree or its prefix.
+ - 1: if the iterator points at a key.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks an iterator
+
+    RadixTreeIterator_Valid(&it);
+
+*/
+bool RadixTreeIterator_Valid(RadixTreeIterator* it);
+
+/*
+Moves an iterator to the next key in order, searching down from the root again.
+
+Inputs:
+ - RadixTreeIterator* it: the memory address of a valid iterator.
+
+Time Complexity: O(k)
+
+Example:
+ - This advances an iterator
+
+    RadixTreeIterator_Next(&it);
+
+*/
+void RadixTreeIterator_Next(RadixTreeIterator* it);
+
+/*
+Returns the address of the key an iterator points at, which must not be modified.
+
+Inputs:
+ - RadixTreeIterator* it: the memory address of a valid iterator.
+ - size_t* length: a memory address which receives the number of bytes in the key, or NULL.
+
+Outputs:
+ - const void*: the address of the key bytes inside the tree, which are not null terminated.
+
+Time Complexity: O(1)
+
+Example:
+ - This prints the current key
+
+    size_t length;
+    const char* key = RadixTreeIterator_Key(&it, &length);
+    printf("%.*s\n", (int) length, key);
+
+*/
+const void* RadixTreeIterator_Key(RadixTreeIterator* it, size_t* length);
+
+/*
+Returns the address of the value an iterator points at.
+
+Inputs:
+ - RadixTreeIterator* it: the memory address of a valid iterator.
+
+Outputs:
+ - void*: the address of the value inside the tree.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads the current value
+
+    int value = *(int*) RadixTreeIterator_Value(&it);
+
+*/
+void* RadixTreeIterator_Value(RadixTreeIterator* it);
+
+/*
+Clears all key-value pairs from a given RadixTree structure.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This clears a tree.
+
+    RadixTree_Clear(t);
+
+*/
+void RadixTree_Clear(RadixTree* t);
+
+/*
+Frees all memory associated with an initialised RadixTree structure.
+
+Inputs:
+ - RadixTree* t: the memory address of the RadixTree structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    RadixTree_Free(t);
+
+*/
+void RadixTree_Free(RadixTree* t);
+
+#endif
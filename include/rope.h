@@ -0,0 +1,277 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef ROPE_H
+#define ROPE_H
+
+struct RopeNode {
+    struct RopeNode* left;
+    struct RopeNode* right;
+    uint64_t priority;
+    int count;
+    int total;
+    uint8_t data[];
+};
+typedef struct RopeNode RopeNode;
+
+struct Rope {
+
+    size_t element_size;
+    int chunk;
+
+    RopeNode* root;
+    uint64_t state;
+
+};
+typedef struct Rope Rope;
+
+/*
+Initialises the memory of a Rope structure.
+A Rope is a sequence stored as a balanced tree of fixed size chunks, so inserting and removing anywhere costs O(log n).
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - size_t element_size: the size in bytes of the element datatype being stored.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a rope which stores floats
+
+    Rope* r = malloc(sizeof(Rope));
+    Rope_Init(r, sizeof(float));
+
+*/
+void Rope_Init(Rope* r, size_t element_size);
+
+/*
+Returns the number of elements that are stored in the Rope.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+
+Outputs:
+ - int: the number of elements that are currently stored in the rope.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the length of the rope
+
+    int length = Rope_Length(r);
+
+*/
+int Rope_Length(Rope* r);
+
+/*
+Given an index, gets the element at the index in the Rope.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - int index: the index of the item in the rope.
+ - void* buffer: a memory address where the element will be stored if possible.
+
+Outputs:
+ - 0: if the index supplied is out of bounds.
+ - 1: if the index supplied is in the bounds.
+
+Time Complexity: O(log n)
+
+Example:
+ - This gets the value stored at index 3 in the rope
+
+    float buffer;
+    Rope_Get(r, 3, &buffer);
+
+*/
+bool Rope_Get(Rope* r, int index, void* buffer);
+
+/*
+Given an index, overwrites the element at the index in the Rope.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - int index: the index of the item in the rope.
+ - void* element: the memory address where the element is stored.
+
+Outputs:
+ - 0: if the index supplied is out of bounds.
+ - 1: if the element was overwritten.
+
+Time Complexity: O(log n)
+
+Example:
+ - This sets the value at index 3 in the rope
+
+    float element = 2.0f;
+    Rope_Set(r, 3, &element);
+
+*/
+bool Rope_Set(Rope* r, int index, void* element);
+
+/*
+Returns the address of the element at an index, and how many elements follow it contiguously in the same chunk.
+This allows a rope to be read one chunk at a time.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - int index: the index of the item in the rope.
+ - int* count: a memory address where the number of contiguous elements is stored.
+
+Outputs:
+ - void*: the address of the element, or NULL if the index is out of bounds.
+
+Time Complexity: O(log n)
+
+Example:
+ - This visits every element in the rope
+
+    int count;
+    for (int i = 0; i < Rope_Length(r); i += count) {
+        float* elements = Rope_Chunk(r, i, &count);
+    }
+
+*/
+void* Rope_Chunk(Rope* r, int index, int* count);
+
+/*
+Given an index, adds an element to the index in the Rope.
+All proceeding elements are shifted up.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - int index: the index to add the element at.
+ - void* element: the memory address where the element is stored.
+
+Outputs:
+ - 0: if the index could not be added.
+ - 1: if the index was successfully added.
+
+Time Complexity: O(log n)
+
+Example:
+ - This adds the element to index 3 in the rope
+
+    float element = 4.0f;
+    Rope_Add(r, 3, &element);
+
+*/
+bool Rope_Add(Rope* r, int index, void* element);
+
+/*
+Pushes an element to the end of the Rope.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - void* element: the memory address where the element is stored.
+
+Time Complexity: O(log n)
+
+Example:
+ - This pushes the element to the end of the rope
+
+    float element = 3.0f;
+    Rope_Push(r, &element);
+
+*/
+void Rope_Push(Rope* r, void* element);
+
+/*
+Given an index, removes the element stored at the index from the Rope.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - int index: the index of the element to remove.
+
+Outputs:
+ - 0: if the index could not be removed.
+ - 1: if the index was successfully removed.
+
+Time Complexity: O(log n)
+
+Example:
+ - This removes the element at index 3 from the rope
+
+    Rope_Remove(r, 3);
+
+*/
+bool Rope_Remove(Rope* r, int index);
+
+/*
+Splits a Rope in two at an index. The elements from the index onwards are moved to a new Rope.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - int index: the index of the first element to move.
+ - Rope* right: the memory address of an uninitialised Rope structure to move the elements to.
+
+Outputs:
+ - 0: if the index is out of bounds, and right is left uninitialised.
+ - 1: if the rope was split.
+
+Time Complexity: O(log n)
+
+Example:
+ - This moves everything from index 100 onwards to another rope
+
+    Rope right;
+    Rope_Split(r, 100, &right);
+
+*/
+bool Rope_Split(Rope* r, int index, Rope* right);
+
+/*
+Moves every element of another Rope onto the end of the Rope. The other Rope is left empty.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+ - Rope* other: the memory address of the Rope to move the elements from.
+
+Outputs:
+ - 0: if the ropes store elements of different sizes.
+ - 1: if the ropes were joined.
+
+Time Complexity: O(log n)
+
+Example:
+ - This joins two ropes
+
+    Rope_Concat(r, &right);
+
+*/
+bool Rope_Concat(Rope* r, Rope* other);
+
+/*
+Clears all elements from a given Rope structure.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This clears a rope.
+
+    Rope_Clear(r);
+
+*/
+void Rope_Clear(Rope* r);
+
+/*
+Frees all associated memory with a Rope structure.
+
+Inputs:
+ - Rope* r: the memory address of the Rope structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This frees the rope.
+
+    Rope_Free(r);
+
+*/
+void Rope_Free(Rope* r);
+
+#endif
@@ -0,0 +1,64 @@
+#include <stdbool.h>
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+/*
+Sets the number of threads used by the parallel algorithms of the library.
+The calling thread counts as one of them, so a count of 1 runs everything on the caller.
+The pool is shared by the whole process and its worker threads persist between calls.
+
+Inputs:
+ - int threads: the number of threads to use, or 0 to use one per online processor.
+
+Time Complexity: O(n)
+
+Example:
+ - This limits the library to four threads
+
+    ThreadPool_SetThreads(4);
+
+*/
+void ThreadPool_SetThreads(int threads);
+
+/*
+Returns the number of threads used by the parallel algorithms of the library.
+
+Outputs:
+ - int: the number of threads, including the calling thread.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the number of threads
+
+    int threads = ThreadPool_Threads();
+
+*/
+int ThreadPool_Threads();
+
+/*
+Calls a function once for every task index, spreading the calls over the threads of the pool.
+Returns once every call has returned. Calls made from inside a task run on the calling thread.
+
+Inputs:
+ - int tasks: the number of tasks, the function is called with each index from 0 to tasks - 1.
+ - void (*task)(int, void*): the function to call with the task index and the argument.
+ - void* arg: an argument passed to every call.
+
+Time Complexity: O(n / p)
+
+Example:
+ - This squares every element of an array on every thread
+
+    void square(int index, void* arg) {
+        int* array = arg;
+        array[index] = array[index] * array[index];
+    }
+
+    ThreadPool_ParallelFor(1024, square, array);
+
+*/
+void ThreadPool_ParallelFor(int tasks, void (*task)(int, void*), void* arg);
+
+#endif
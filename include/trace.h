@@ -0,0 +1,140 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+#ifdef CDSL_TRACE_USDT
+#include <sys/sdt.h>
+#endif
+
+#ifndef TRACE_H
+#define TRACE_H
+
+// Eviction walks and memmoves are only traced from these lengths up.
+#define TRACE_EVICTION_LENGTH 16
+#define TRACE_MEMMOVE_BYTES 65536
+
+enum TraceEvent {
+
+    // A HashMap table doubled: size is the number of pairs, before and after the number of buckets.
+    TRACE_HASHMAP_GROW,
+
+    // A HashMap grew because both eviction walks of a put failed, usually on a cycle. It follows the grow's own event.
+    TRACE_HASHMAP_REHASH,
+
+    // An eviction walk of a HashMap put reached TRACE_EVICTION_LENGTH pairs: size is its length, before the
+    // number of buckets, and after 1 if it found an empty slot or 0 if it gave up.
+    TRACE_HASHMAP_EVICTIONS,
+
+    // A List pointer array was reallocated: size is the length, before and after the capacity.
+    TRACE_LIST_REALLOC,
+
+    // At least TRACE_MEMMOVE_BYTES of a List pointer array moved: size is the bytes, before and after the first index moved from and to.
+    TRACE_LIST_MEMMOVE,
+
+    TRACE_EVENTS
+
+};
+typedef enum TraceEvent TraceEvent;
+
+struct TraceRecord {
+    TraceEvent event;
+    const void* object;
+    size_t size;
+    size_t before;
+    size_t after;
+    uint64_t nanoseconds;
+};
+typedef struct TraceRecord TraceRecord;
+
+typedef void (*TraceCallback)(const TraceRecord* record, void* arg);
+
+struct _TraceHook {
+    TraceCallback callback;
+    void* arg;
+};
+extern struct _TraceHook _Trace_Hooks[TRACE_EVENTS];
+
+struct _TraceSpan {
+    uint64_t start;
+    size_t before;
+};
+
+/*
+Registers a function to call on every occurrence of an event, in place of any registered before.
+Events are only fired when the library is built with ENABLE_TRACING, which defines CDSL_TRACE, and cost
+nothing otherwise. The clock is only read for an event while a function is registered for it.
+
+Such builds also have static probes for tools like bpftrace wherever <sys/sdt.h> is found, named
+cdsl:hashmap_grow, cdsl:hashmap_rehash, cdsl:hashmap_evictions, cdsl:list_realloc and cdsl:list_memmove,
+with the object, size, before and after of the record as their arguments.
+
+Functions are called on the thread causing the event, inside any lock it holds, and must not change
+the structure. Registration is not synchronised, so it should happen before other threads are started.
+
+Inputs:
+ - TraceEvent event: the event to watch.
+ - TraceCallback callback: the function to call with each record and arg, or NULL to stop watching.
+ - void* arg: passed to the function as its second argument.
+
+Time Complexity: O(1)
+
+Example:
+ - This logs slow grows
+
+    void log_grow(const TraceRecord* record, void* arg) {
+        if (record->nanoseconds > 1000000) {fprintf(arg, "grow to %zu took %llu ns\n", record->after, record->nanoseconds);}
+    }
+
+    Trace_Register(TRACE_HASHMAP_GROW, log_grow, stderr);
+
+*/
+void Trace_Register(TraceEvent event, TraceCallback callback, void* arg);
+
+/*
+Checks whether events are compiled into the library.
+
+Outputs:
+ - 0: if registered functions will never be called.
+ - 1: if the library was built with CDSL_TRACE.
+
+Time Complexity: O(1)
+
+Example:
+ - This warns when tracing is unavailable
+
+    if (!Trace_Enabled()) {fprintf(stderr, "rebuild with -DENABLE_TRACING=1\n");}
+
+*/
+bool Trace_Enabled(void);
+
+uint64_t _Trace_Now(void);
+void _Trace_Fire(struct _TraceSpan* span, TraceEvent event, const void* object, size_t size, size_t after);
+
+static inline struct _TraceSpan _Trace_Begin(TraceEvent event, size_t before) {
+    struct _TraceSpan span = {_Trace_Hooks[event].callback != NULL ? _Trace_Now() : 0, before};
+    return span;
+}
+
+// TRACE_BEGIN starts timing an event, and TRACE_END fires it to the probe and any registered function.
+// Without CDSL_TRACE both expand to nothing, so the structures pay nothing for them.
+#ifdef CDSL_TRACE
+
+#ifdef CDSL_TRACE_USDT
+#define TRACE_PROBE(probe, object, size, before, after) DTRACE_PROBE4(cdsl, probe, object, size, before, after)
+#else
+#define TRACE_PROBE(probe, object, size, before, after) do {} while (0)
+#endif
+
+#define TRACE_BEGIN(span, event, before) struct _TraceSpan span = _Trace_Begin(event, before)
+#define TRACE_END(span, event, probe, object, size, after) do { \
+        TRACE_PROBE(probe, object, size, span.before, after); \
+        if (span.start != 0) {_Trace_Fire(&span, event, object, size, after);} \
+    } while (0)
+
+#else
+
+#define TRACE_BEGIN(span, event, before)
+#define TRACE_END(span, event, probe, object, size, after) do {} while (0)
+
+#endif
+
+#endif
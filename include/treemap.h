@@ -0,0 +1,349 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <stddef.h>
+
+#ifndef TREEMAP_H
+#define TREEMAP_H
+
+struct TreeNode {
+    int leaf;
+    int count;
+    struct TreeNode* next;
+    struct TreeNode* prev;
+    uint8_t data[];
+};
+typedef struct TreeNode TreeNode;
+
+struct TreeMap {
+
+    size_t key_size;
+    size_t value_size;
+    size_t keys_bytes;
+    size_t size;
+    int order;
+
+    int (*compare)(const void*, const void*);
+
+    TreeNode* root;
+    uint8_t* buffer;
+
+};
+typedef struct TreeMap TreeMap;
+
+struct TreeMapIterator {
+    TreeMap* map;
+    TreeNode* node;
+    int index;
+};
+typedef struct TreeMapIterator TreeMapIterator;
+
+/*
+Initialises the memory of a TreeMap structure, an ordered map backed by a B+ tree.
+Keys and values are stored inline in nodes sized to a few cache lines, and leaves are linked for range scans.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - size_t key_size: the size in bytes of the key datatype.
+ - size_t value_size: the size in bytes of the value datatype.
+ - int (*compare)(const void*, const void*): returns a negative, zero or positive number like the comparator of qsort.
+
+Time Complexity: O(1)
+
+Example:
+ - This creates a map with integer keys and float values.
+
+    int compare(const void* a, const void* b) {return (*(int*)a > *(int*)b) - (*(int*)a < *(int*)b);}
+
+    TreeMap* t = malloc(sizeof(TreeMap));
+    TreeMap_Init(t, sizeof(int), sizeof(float), compare);
+
+*/
+void TreeMap_Init(TreeMap* t, size_t key_size, size_t value_size, int (*compare)(const void*, const void*));
+
+/*
+Returns the number of elements that are stored in the TreeMap.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+
+Outputs:
+ - int: the number of elements that are currently stored in the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This gets the size of the map
+
+    int size = TreeMap_Size(t);
+
+*/
+int TreeMap_Size(TreeMap* t);
+
+/*
+Given a key, gets the associated value of the key in the TreeMap.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* buffer: a memory address where the value will be placed if found.
+
+Outputs:
+ - 0: if the object could not be found in the map.
+ - 1: if the object was successfully retrieved from the map.
+
+Time Complexity: O(log n)
+
+Example:
+ - This gets the value stored at 5 in the map
+
+    int key = 5;
+    float buffer;
+
+    TreeMap_Get(t, &key, &buffer);
+
+*/
+bool TreeMap_Get(TreeMap* t, void* key, void* buffer);
+
+/*
+Given a key/value pair, adds/updates the key/value pair in the TreeMap.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - void* key: a memory address which contains data about the key.
+ - void* value: a memory address which contains data about the value.
+
+Time Complexity: O(log n)
+
+Example:
+ - This adds a key/value pair to the map.
+
+    int key = 5;
+    float value = 1.0f;
+
+    TreeMap_Put(t, &key, &value);
+
+*/
+void TreeMap_Put(TreeMap* t, void* key, void* value);
+
+/*
+Given a key, removes the associated key/value pair in the TreeMap.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - 0: if the key could not be found in the map.
+ - 1: if the key/value pair was successfully removed from the map.
+
+Time Complexity: O(log n)
+
+Example:
+ - This removes the key/value pair associated with 5 in the map
+
+    int key = 5;
+    TreeMap_Remove(t, &key);
+
+*/
+bool TreeMap_Remove(TreeMap* t, void* key);
+
+/*
+Fills an empty TreeMap from arrays of keys and values which are sorted by key.
+The leaves are built directly, which is much faster than putting the keys one by one.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - void* keys: the memory address of count keys stored back to back, in strictly increasing order.
+ - void* values: the memory address of count values stored back to back.
+ - int count: the number of key/value pairs.
+
+Outputs:
+ - 0: if the map is not empty or the keys are not strictly increasing, the map is left unchanged.
+ - 1: if the map was successfully loaded.
+
+Time Complexity: O(n)
+
+Example:
+ - This loads three pairs at once
+
+    int keys[3] = {1, 2, 3};
+    float values[3] = {0.5f, 1.0f, 1.5f};
+    TreeMap_Load(t, keys, values, 3);
+
+*/
+bool TreeMap_Load(TreeMap* t, void* keys, void* values, int count);
+
+/*
+Returns an iterator at the smallest key in the TreeMap.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+
+Outputs:
+ - TreeMapIterator: an iterator at the first element, which is not valid if the map is empty.
+
+Time Complexity: O(log n)
+
+Example:
+ - This visits every element in order
+
+    for (TreeMapIterator it = TreeMap_First(t); TreeMapIterator_Valid(&it); TreeMapIterator_Next(&it)) {
+        int key = *(int*) TreeMapIterator_Key(&it);
+    }
+
+*/
+TreeMapIterator TreeMap_First(TreeMap* t);
+
+/*
+Returns an iterator at the first key which is not less than the given key.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - TreeMapIterator: an iterator which is not valid if every key is less than the given key.
+
+Time Complexity: O(log n)
+
+Example:
+ - This visits every key in the range [10, 20)
+
+    int low = 10;
+    int high = 20;
+    TreeMapIterator it = TreeMap_LowerBound(t, &low);
+    while (TreeMapIterator_Valid(&it) && *(int*) TreeMapIterator_Key(&it) < high) {
+        TreeMapIterator_Next(&it);
+    }
+
+*/
+TreeMapIterator TreeMap_LowerBound(TreeMap* t, void* key);
+
+/*
+Returns an iterator at the first key which is greater than the given key.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+ - void* key: a memory address which contains data about the key.
+
+Outputs:
+ - TreeMapIterator: an iterator which is not valid if no key is greater than the given key.
+
+Time Complexity: O(log n)
+
+Example:
+ - This gets the first key after 10
+
+    int key = 10;
+    TreeMapIterator it = TreeMap_UpperBound(t, &key);
+
+*/
+TreeMapIterator TreeMap_UpperBound(TreeMap* t, void* key);
+
+/*
+Checks whether an iterator points at an element. Iterators are invalidated by any change to the map.
+
+Inputs:
+ - TreeMapIterator* it: the memory address of the iterator.
+
+Outputs:
+ - 0: if the iterator has run off the end of the map.
+ - 1: if the iterator points at an element.
+
+Time Complexity: O(1)
+
+Example:
+ - This checks an iterator
+
+    TreeMapIterator_Valid(&it);
+
+*/
+bool TreeMapIterator_Valid(TreeMapIterator* it);
+
+/*
+Moves an iterator to the next element in key order.
+
+Inputs:
+ - TreeMapIterator* it: the memory address of a valid iterator.
+
+Time Complexity: O(1)
+
+Example:
+ - This advances an iterator
+
+    TreeMapIterator_Next(&it);
+
+*/
+void TreeMapIterator_Next(TreeMapIterator* it);
+
+/*
+Returns the address of the key an iterator points at, which must not be modified.
+
+Inputs:
+ - TreeMapIterator* it: the memory address of a valid iterator.
+
+Outputs:
+ - void*: the address of the key inside the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads the current key
+
+    int key = *(int*) TreeMapIterator_Key(&it);
+
+*/
+void* TreeMapIterator_Key(TreeMapIterator* it);
+
+/*
+Returns the address of the value an iterator points at.
+
+Inputs:
+ - TreeMapIterator* it: the memory address of a valid iterator.
+
+Outputs:
+ - void*: the address of the value inside the map.
+
+Time Complexity: O(1)
+
+Example:
+ - This reads the current value
+
+    float value = *(float*) TreeMapIterator_Value(&it);
+
+*/
+void* TreeMapIterator_Value(TreeMapIterator* it);
+
+/*
+Clears all key-value pairs from a given TreeMap structure.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This clears a map.
+
+    TreeMap_Clear(t);
+
+*/
+void TreeMap_Clear(TreeMap* t);
+
+/*
+Frees all memory associated with an initialised TreeMap structure.
+
+Inputs:
+ - TreeMap* t: the memory address of the TreeMap structure.
+
+Time Complexity: O(n)
+
+Example:
+ - This frees all dynamically allocated memory.
+
+    TreeMap_Free(t);
+
+*/
+void TreeMap_Free(TreeMap* t);
+
+#endif
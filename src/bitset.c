@@ -0,0 +1,561 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "bitset.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define BITSET_INITIAL_WORDS 4
+#define COMPRESSEDBITSET_WORDS 1024
+#define COMPRESSEDBITSET_INITIAL_VALUES 4
+#define COMPRESSEDBITSET_INITIAL_CONTAINERS 4
+
+enum _Bitset_Operation {_BITSET_AND, _BITSET_OR, _BITSET_XOR, _BITSET_ANDNOT};
+
+//-----------------------------------------------------------------------------
+// Word operations
+//-----------------------------------------------------------------------------
+
+// Counts the set bits of n words. Without a popcount instruction, SSE2 counts
+// two words at a time by summing bits within bytes and then bytes with psadbw.
+static size_t _Bitset_Popcount(const uint64_t* words, size_t n) {
+
+    size_t count = 0;
+    size_t i = 0;
+
+#if defined(__SSE2__) && !defined(__POPCNT__)
+    const __m128i m1 = _mm_set1_epi8(0x55);
+    const __m128i m2 = _mm_set1_epi8(0x33);
+    const __m128i m4 = _mm_set1_epi8(0x0f);
+    __m128i total = _mm_setzero_si128();
+
+    for (; i + 2 <= n; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (words + i));
+        x = _mm_sub_epi8(x, _mm_and_si128(_mm_srli_epi16(x, 1), m1));
+        x = _mm_add_epi8(_mm_and_si128(x, m2), _mm_and_si128(_mm_srli_epi16(x, 2), m2));
+        x = _mm_and_si128(_mm_add_epi8(x, _mm_srli_epi16(x, 4)), m4);
+        total = _mm_add_epi64(total, _mm_sad_epu8(x, _mm_setzero_si128()));
+    }
+
+    uint64_t sums[2];
+    _mm_storeu_si128((__m128i*) sums, total);
+    count = sums[0] + sums[1];
+#endif
+
+    for (; i < n; i++) {count += __builtin_popcountll(words[i]);}
+    return count;
+
+}
+
+// Combines n words of a and b into out, which may be a.
+static void _Bitset_Combine(uint64_t* out, const uint64_t* a, const uint64_t* b, size_t n, enum _Bitset_Operation op) {
+
+    size_t i = 0;
+
+#ifdef __SSE2__
+    for (; i + 2 <= n; i += 2) {
+        __m128i x = _mm_loadu_si128((const __m128i*) (a + i));
+        __m128i y = _mm_loadu_si128((const __m128i*) (b + i));
+        switch (op) {
+            case _BITSET_AND: x = _mm_and_si128(x, y); break;
+            case _BITSET_OR: x = _mm_or_si128(x, y); break;
+            case _BITSET_XOR: x = _mm_xor_si128(x, y); break;
+            case _BITSET_ANDNOT: x = _mm_andnot_si128(y, x); break;
+        }
+        _mm_storeu_si128((__m128i*) (out + i), x);
+    }
+#endif
+
+    for (; i < n; i++) {
+        switch (op) {
+            case _BITSET_AND: out[i] = a[i] & b[i]; break;
+            case _BITSET_OR: out[i] = a[i] | b[i]; break;
+            case _BITSET_XOR: out[i] = a[i] ^ b[i]; break;
+            case _BITSET_ANDNOT: out[i] = a[i] & ~b[i]; break;
+        }
+    }
+
+}
+
+// Returns the position of the set bit of a word with the given rank.
+static inline int _Bitset_SelectWord(uint64_t word, size_t rank) {
+    for (size_t i = 0; i < rank; i++) {word &= word - 1;}
+    return __builtin_ctzll(word);
+}
+
+//-----------------------------------------------------------------------------
+// Bitset
+//-----------------------------------------------------------------------------
+
+void Bitset_Init(Bitset* b) {
+    b->words = NULL;
+    b->length = 0;
+}
+
+static void _Bitset_Reserve(Bitset* b, size_t length) {
+
+    if (length <= b->length) {return;}
+
+    size_t size = b->length > 0 ? b->length : BITSET_INITIAL_WORDS;
+    while (size < length) {size *= 2;}
+
+    b->words = realloc(b->words, size * sizeof(uint64_t));
+    memset(b->words + b->length, 0, (size - b->length) * sizeof(uint64_t));
+    b->length = size;
+
+}
+
+void Bitset_Set(Bitset* b, size_t index) {
+    _Bitset_Reserve(b, index / 64 + 1);
+    b->words[index / 64] |= UINT64_C(1) << (index % 64);
+}
+
+void Bitset_Unset(Bitset* b, size_t index) {
+    if (index / 64 < b->length) {b->words[index / 64] &= ~(UINT64_C(1) << (index % 64));}
+}
+
+bool Bitset_Get(Bitset* b, size_t index) {
+    return index / 64 < b->length && (b->words[index / 64] >> (index % 64)) & 1;
+}
+
+size_t Bitset_Count(Bitset* b) {
+    return _Bitset_Popcount(b->words, b->length);
+}
+
+size_t Bitset_Rank(Bitset* b, size_t index) {
+
+    size_t word = index / 64;
+    if (word >= b->length) {return Bitset_Count(b);}
+
+    size_t rank = _Bitset_Popcount(b->words, word);
+    if (index % 64 > 0) {rank += __builtin_popcountll(b->words[word] << (64 - index % 64));}
+    return rank;
+
+}
+
+bool Bitset_Select(Bitset* b, size_t rank, size_t* index) {
+
+    for (size_t i = 0; i < b->length; i++) {
+        size_t count = __builtin_popcountll(b->words[i]);
+        if (rank < count) {
+            *index = 64 * i + _Bitset_SelectWord(b->words[i], rank);
+            return 1;
+        }
+        rank -= count;
+    }
+
+    return 0;
+
+}
+
+void Bitset_And(Bitset* b, Bitset* other) {
+    size_t shared = b->length < other->length ? b->length : other->length;
+    _Bitset_Combine(b->words, b->words, other->words, shared, _BITSET_AND);
+    if (b->length > shared) {memset(b->words + shared, 0, (b->length - shared) * sizeof(uint64_t));}
+}
+
+void Bitset_Or(Bitset* b, Bitset* other) {
+    _Bitset_Reserve(b, other->length);
+    _Bitset_Combine(b->words, b->words, other->words, other->length, _BITSET_OR);
+}
+
+void Bitset_Xor(Bitset* b, Bitset* other) {
+    _Bitset_Reserve(b, other->length);
+    _Bitset_Combine(b->words, b->words, other->words, other->length, _BITSET_XOR);
+}
+
+void Bitset_AndNot(Bitset* b, Bitset* other) {
+    size_t shared = b->length < other->length ? b->length : other->length;
+    _Bitset_Combine(b->words, b->words, other->words, shared, _BITSET_ANDNOT);
+}
+
+// Moves an iterator with no bits left on to the next word with any.
+static inline void _BitsetIterator_Settle(BitsetIterator* it) {
+    while (it->bits == 0 && ++it->word < it->bitset->length) {it->bits = it->bitset->words[it->word];}
+}
+
+BitsetIterator Bitset_First(Bitset* b) {
+    BitsetIterator it = {b, 0, b->length > 0 ? b->words[0] : 0};
+    _BitsetIterator_Settle(&it);
+    return it;
+}
+
+bool BitsetIterator_Valid(BitsetIterator* it) {
+    return it->bits != 0;
+}
+
+void BitsetIterator_Next(BitsetIterator* it) {
+    it->bits &= it->bits - 1;
+    _BitsetIterator_Settle(it);
+}
+
+size_t BitsetIterator_Index(BitsetIterator* it) {
+    return 64 * it->word + __builtin_ctzll(it->bits);
+}
+
+void Bitset_Clear(Bitset* b) {
+    if (b->length > 0) {memset(b->words, 0, b->length * sizeof(uint64_t));}
+}
+
+void Bitset_Free(Bitset* b) {
+    free(b->words);
+}
+
+//-----------------------------------------------------------------------------
+// Compressed bitset
+//-----------------------------------------------------------------------------
+
+// Returns the index of the first container whose key is not less than the given one.
+static int _CompressedBitset_Find(CompressedBitset* c, uint16_t key) {
+    int lo = 0;
+    int hi = c->length;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (c->containers[mid].key < key) {lo = mid + 1;}
+        else {hi = mid;}
+    }
+    return lo;
+}
+
+// Returns the index of the first value of an array container not less than the given one.
+static int _CompressedBitset_Search(CompressedBitsetContainer* container, uint16_t low) {
+    uint16_t* values = container->values;
+    int lo = 0;
+    int hi = container->count;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (values[mid] < low) {lo = mid + 1;}
+        else {hi = mid;}
+    }
+    return lo;
+}
+
+static void _CompressedBitset_ToBitmap(CompressedBitsetContainer* container) {
+    uint16_t* values = container->values;
+    uint64_t* words = calloc(COMPRESSEDBITSET_WORDS, sizeof(uint64_t));
+    for (int i = 0; i < container->count; i++) {words[values[i] / 64] |= UINT64_C(1) << (values[i] % 64);}
+    free(values);
+    container->values = words;
+    container->bitmap = 1;
+    container->size = COMPRESSEDBITSET_WORDS;
+}
+
+static void _CompressedBitset_ToArray(CompressedBitsetContainer* container) {
+    uint64_t* words = container->values;
+    uint16_t* values = malloc((container->count > 0 ? container->count : 1) * sizeof(uint16_t));
+    int count = 0;
+    for (int i = 0; i < COMPRESSEDBITSET_WORDS; i++) {
+        for (uint64_t bits = words[i]; bits != 0; bits &= bits - 1) {values[count++] = (uint16_t) (64 * i + __builtin_ctzll(bits));}
+    }
+    free(words);
+    container->values = values;
+    container->bitmap = 0;
+    container->size = container->count > 0 ? container->count : 1;
+}
+
+void CompressedBitset_Init(CompressedBitset* c) {
+    c->containers = NULL;
+    c->length = 0;
+    c->size = 0;
+}
+
+bool CompressedBitset_Add(CompressedBitset* c, uint32_t value) {
+
+    uint16_t key = (uint16_t) (value >> 16);
+    uint16_t low = (uint16_t) value;
+
+    int i = _CompressedBitset_Find(c, key);
+    if (i == c->length || c->containers[i].key != key) {
+        if (c->length == c->size) {
+            c->size = c->size > 0 ? 2 * c->size : COMPRESSEDBITSET_INITIAL_CONTAINERS;
+            c->containers = realloc(c->containers, c->size * sizeof(CompressedBitsetContainer));
+        }
+        memmove(c->containers + i + 1, c->containers + i, (c->length - i) * sizeof(CompressedBitsetContainer));
+        c->containers[i] = (CompressedBitsetContainer) {key, 0, 0, COMPRESSEDBITSET_INITIAL_VALUES, malloc(COMPRESSEDBITSET_INITIAL_VALUES * sizeof(uint16_t))};
+        c->length++;
+    }
+    CompressedBitsetContainer* container = c->containers + i;
+
+    if (container->bitmap) {
+        uint64_t* words = container->values;
+        uint64_t bit = UINT64_C(1) << (low % 64);
+        if (words[low / 64] & bit) {return 0;}
+        words[low / 64] |= bit;
+        container->count++;
+        return 1;
+    }
+
+    int j = _CompressedBitset_Search(container, low);
+    uint16_t* values = container->values;
+    if (j < container->count && values[j] == low) {return 0;}
+
+    if (container->count == COMPRESSEDBITSET_ARRAY_LIMIT) {
+        _CompressedBitset_ToBitmap(container);
+        return CompressedBitset_Add(c, value);
+    }
+
+    if (container->count == container->size) {
+        container->size *= 2;
+        container->values = values = realloc(values, container->size * sizeof(uint16_t));
+    }
+    memmove(values + j + 1, values + j, (container->count - j) * sizeof(uint16_t));
+    values[j] = low;
+    container->count++;
+    return 1;
+
+}
+
+bool CompressedBitset_Remove(CompressedBitset* c, uint32_t value) {
+
+    uint16_t key = (uint16_t) (value >> 16);
+    uint16_t low = (uint16_t) value;
+
+    int i = _CompressedBitset_Find(c, key);
+    if (i == c->length || c->containers[i].key != key) {return 0;}
+    CompressedBitsetContainer* container = c->containers + i;
+
+    if (container->bitmap) {
+        uint64_t* words = container->values;
+        uint64_t bit = UINT64_C(1) << (low % 64);
+        if ((words[low / 64] & bit) == 0) {return 0;}
+        words[low / 64] &= ~bit;
+        container->count--;
+        if (container->count == COMPRESSEDBITSET_ARRAY_LIMIT) {_CompressedBitset_ToArray(container);}
+        return 1;
+    }
+
+    int j = _CompressedBitset_Search(container, low);
+    uint16_t* values = container->values;
+    if (j == container->count || values[j] != low) {return 0;}
+    memmove(values + j, values + j + 1, (container->count - j - 1) * sizeof(uint16_t));
+    container->count--;
+
+    if (container->count == 0) {
+        free(container->values);
+        memmove(container, container + 1, (c->length - i - 1) * sizeof(CompressedBitsetContainer));
+        c->length--;
+    }
+    return 1;
+
+}
+
+bool CompressedBitset_Contains(CompressedBitset* c, uint32_t value) {
+
+    uint16_t key = (uint16_t) (value >> 16);
+    uint16_t low = (uint16_t) value;
+
+    int i = _CompressedBitset_Find(c, key);
+    if (i == c->length || c->containers[i].key != key) {return 0;}
+    CompressedBitsetContainer* container = c->containers + i;
+
+    if (container->bitmap) {return (((uint64_t*) container->values)[low / 64] >> (low % 64)) & 1;}
+    int j = _CompressedBitset_Search(container, low);
+    return j < container->count && ((uint16_t*) container->values)[j] == low;
+
+}
+
+size_t CompressedBitset_Count(CompressedBitset* c) {
+    size_t count = 0;
+    for (int i = 0; i < c->length; i++) {count += c->containers[i].count;}
+    return count;
+}
+
+size_t CompressedBitset_Bytes(CompressedBitset* c) {
+    size_t bytes = c->size * sizeof(CompressedBitsetContainer);
+    for (int i = 0; i < c->length; i++) {
+        CompressedBitsetContainer* container = c->containers + i;
+        bytes += container->size * (container->bitmap ? sizeof(uint64_t) : sizeof(uint16_t));
+    }
+    return bytes;
+}
+
+// Copies a container so the result owns its values.
+static CompressedBitsetContainer _CompressedBitset_Copy(CompressedBitsetContainer* container) {
+    CompressedBitsetContainer copy = *container;
+    size_t bytes = container->size * (container->bitmap ? sizeof(uint64_t) : sizeof(uint16_t));
+    copy.values = malloc(bytes);
+    memcpy(copy.values, container->values, bytes);
+    return copy;
+}
+
+// Combines two containers with the same key into a new one, which may be empty.
+static CompressedBitsetContainer _CompressedBitset_Combine(CompressedBitsetContainer* a, CompressedBitsetContainer* b, enum _Bitset_Operation op) {
+
+    CompressedBitsetContainer result = {a->key, 0, 0, 0, NULL};
+
+    // Two arrays are merged, and the result only becomes a bitmap if it is too long.
+    if (!a->bitmap && !b->bitmap) {
+        uint16_t* x = a->values;
+        uint16_t* y = b->values;
+        uint16_t* values = malloc((a->count + b->count > 0 ? a->count + b->count : 1) * sizeof(uint16_t));
+        int i = 0;
+        int j = 0;
+        int count = 0;
+        while (i < a->count || j < b->count) {
+            if (j == b->count || (i < a->count && x[i] < y[j])) {
+                if (op != _BITSET_AND) {values[count++] = x[i];}
+                i++;
+            }
+            else if (i == a->count || y[j] < x[i]) {
+                if (op == _BITSET_OR || op == _BITSET_XOR) {values[count++] = y[j];}
+                j++;
+            }
+            else {
+                if (op == _BITSET_AND || op == _BITSET_OR) {values[count++] = x[i];}
+                i++;
+                j++;
+            }
+        }
+        result.values = values;
+        result.count = count;
+        result.size = a->count + b->count > 0 ? a->count + b->count : 1;
+        if (count > COMPRESSEDBITSET_ARRAY_LIMIT) {_CompressedBitset_ToBitmap(&result);}
+        return result;
+    }
+
+    // Otherwise both sides are taken as bitmaps and combined a word pair at a time.
+    uint64_t* x = a->values;
+    uint64_t* y = b->values;
+    uint64_t* scratch = NULL;
+    if (!a->bitmap || !b->bitmap) {
+        CompressedBitsetContainer* array = a->bitmap ? b : a;
+        uint16_t* values = array->values;
+        scratch = calloc(COMPRESSEDBITSET_WORDS, sizeof(uint64_t));
+        for (int i = 0; i < array->count; i++) {scratch[values[i] / 64] |= UINT64_C(1) << (values[i] % 64);}
+        if (array == a) {x = scratch;}
+        else {y = scratch;}
+    }
+
+    uint64_t* words = malloc(COMPRESSEDBITSET_WORDS * sizeof(uint64_t));
+    _Bitset_Combine(words, x, y, COMPRESSEDBITSET_WORDS, op);
+    free(scratch);
+
+    result.values = words;
+    result.bitmap = 1;
+    result.size = COMPRESSEDBITSET_WORDS;
+    result.count = (int) _Bitset_Popcount(words, COMPRESSEDBITSET_WORDS);
+    if (result.count <= COMPRESSEDBITSET_ARRAY_LIMIT) {_CompressedBitset_ToArray(&result);}
+    return result;
+
+}
+
+// Replaces the containers of c with their combination with those of other, walking both in key order.
+static void _CompressedBitset_Apply(CompressedBitset* c, CompressedBitset* other, enum _Bitset_Operation op) {
+
+    int size = c->length + other->length;
+    CompressedBitsetContainer* containers = malloc((size > 0 ? size : 1) * sizeof(CompressedBitsetContainer));
+    int length = 0;
+
+    int i = 0;
+    int j = 0;
+    while (i < c->length || j < other->length) {
+
+        CompressedBitsetContainer* a = i < c->length ? c->containers + i : NULL;
+        CompressedBitsetContainer* b = j < other->length ? other->containers + j : NULL;
+
+        if (b == NULL || (a != NULL && a->key < b->key)) {
+            if (op == _BITSET_AND) {free(a->values);}
+            else {containers[length++] = *a;}
+            i++;
+        }
+        else if (a == NULL || b->key < a->key) {
+            if (op == _BITSET_OR || op == _BITSET_XOR) {containers[length++] = _CompressedBitset_Copy(b);}
+            j++;
+        }
+        else {
+            CompressedBitsetContainer result = _CompressedBitset_Combine(a, b, op);
+            free(a->values);
+            if (result.count > 0) {containers[length++] = result;}
+            else {free(result.values);}
+            i++;
+            j++;
+        }
+
+    }
+
+    free(c->containers);
+    c->containers = containers;
+    c->length = length;
+    c->size = size > 0 ? size : 1;
+
+}
+
+void CompressedBitset_And(CompressedBitset* c, CompressedBitset* other) {
+    _CompressedBitset_Apply(c, other, _BITSET_AND);
+}
+
+void CompressedBitset_Or(CompressedBitset* c, CompressedBitset* other) {
+    _CompressedBitset_Apply(c, other, _BITSET_OR);
+}
+
+void CompressedBitset_Xor(CompressedBitset* c, CompressedBitset* other) {
+    _CompressedBitset_Apply(c, other, _BITSET_XOR);
+}
+
+void CompressedBitset_AndNot(CompressedBitset* c, CompressedBitset* other) {
+    _CompressedBitset_Apply(c, other, _BITSET_ANDNOT);
+}
+
+// Moves an iterator on to the next value at or after its position, across containers if needed.
+static void _CompressedBitsetIterator_Settle(CompressedBitsetIterator* it) {
+
+    CompressedBitset* c = it->bitset;
+    while (it->container < c->length) {
+
+        CompressedBitsetContainer* container = c->containers + it->container;
+        if (!container->bitmap) {
+            if (it->index < container->count) {return;}
+        }
+        else {
+            uint64_t* words = container->values;
+            int word = it->index / 64;
+            if (word < COMPRESSEDBITSET_WORDS) {
+                uint64_t bits = words[word] & (~UINT64_C(0) << (it->index % 64));
+                while (bits == 0 && ++word < COMPRESSEDBITSET_WORDS) {bits = words[word];}
+                if (bits != 0) {
+                    it->index = 64 * word + __builtin_ctzll(bits);
+                    return;
+                }
+            }
+        }
+
+        it->container++;
+        it->index = 0;
+
+    }
+
+}
+
+CompressedBitsetIterator CompressedBitset_First(CompressedBitset* c) {
+    CompressedBitsetIterator it = {c, 0, 0};
+    _CompressedBitsetIterator_Settle(&it);
+    return it;
+}
+
+bool CompressedBitsetIterator_Valid(CompressedBitsetIterator* it) {
+    return it->container < it->bitset->length;
+}
+
+void CompressedBitsetIterator_Next(CompressedBitsetIterator* it) {
+    it->index++;
+    _CompressedBitsetIterator_Settle(it);
+}
+
+uint32_t CompressedBitsetIterator_Value(CompressedBitsetIterator* it) {
+    CompressedBitsetContainer* container = it->bitset->containers + it->container;
+    uint16_t low = container->bitmap ? (uint16_t) it->index : ((uint16_t*) container->values)[it->index];
+    return ((uint32_t) container->key << 16) | low;
+}
+
+void CompressedBitset_Clear(CompressedBitset* c) {
+    CompressedBitset_Free(c);
+    CompressedBitset_Init(c);
+}
+
+void CompressedBitset_Free(CompressedBitset* c) {
+    for (int i = 0; i < c->length; i++) {free(c->containers[i].values);}
+    free(c->containers);
+}
@@ -0,0 +1,121 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "columnlist.h"
+#include "pages.h"
+
+#define COLUMNLIST_INITIAL_SIZE 4
+
+// The columns are not allocated until the first record is added, and grow
+// together, so every column always has room for size values of its field.
+void ColumnList_Init(ColumnList* c, size_t record_size, ColumnField* fields, int num_fields) {
+
+    c->record_size = record_size;
+    c->num_fields = num_fields;
+    c->fields = malloc(num_fields * sizeof(ColumnField));
+    memcpy(c->fields, fields, num_fields * sizeof(ColumnField));
+
+    c->columns = calloc(num_fields, sizeof(uint8_t*));
+    c->size = 0;
+    c->length = 0;
+
+}
+
+int ColumnList_Length(ColumnList* c) {
+    return c->length;
+}
+
+// Makes room for at least length records in every column, doubling the capacity as needed.
+static void _ColumnList_Reserve(ColumnList* c, int length) {
+
+    if (length <= c->size) {return;}
+    int size = c->size > 0 ? c->size : COLUMNLIST_INITIAL_SIZE;
+    while (size < length) {size *= 2;}
+
+    for (int f = 0; f < c->num_fields; f++) {
+        size_t field_size = c->fields[f].size;
+        c->columns[f] = Pages_Realloc(c->columns[f], c->size * field_size, size * field_size);
+    }
+    c->size = size;
+
+}
+
+static inline void _ColumnList_Scatter(ColumnList* c, int index, const uint8_t* record) {
+    for (int f = 0; f < c->num_fields; f++) {
+        ColumnField* field = c->fields + f;
+        memcpy(c->columns[f] + index * field->size, record + field->offset, field->size);
+    }
+}
+
+static inline void _ColumnList_Gather(ColumnList* c, int index, uint8_t* record) {
+    for (int f = 0; f < c->num_fields; f++) {
+        ColumnField* field = c->fields + f;
+        memcpy(record + field->offset, c->columns[f] + index * field->size, field->size);
+    }
+}
+
+void ColumnList_Push(ColumnList* c, void* record) {
+    _ColumnList_Reserve(c, c->length + 1);
+    _ColumnList_Scatter(c, c->length, record);
+    c->length++;
+}
+
+// Each column is filled in turn, so the writes to it are sequential.
+void ColumnList_Extend(ColumnList* c, void* records, int count) {
+
+    if (count <= 0) {return;}
+    _ColumnList_Reserve(c, c->length + count);
+
+    for (int f = 0; f < c->num_fields; f++) {
+        ColumnField* field = c->fields + f;
+        uint8_t* column = c->columns[f] + c->length * field->size;
+        const uint8_t* record = (const uint8_t*) records + field->offset;
+        for (int i = 0; i < count; i++) {
+            memcpy(column, record, field->size);
+            column += field->size;
+            record += c->record_size;
+        }
+    }
+    c->length += count;
+
+}
+
+bool ColumnList_Get(ColumnList* c, int index, void* record) {
+    if (index < 0 || index >= c->length) {return 0;}
+    _ColumnList_Gather(c, index, record);
+    return 1;
+}
+
+bool ColumnList_Set(ColumnList* c, int index, void* record) {
+    if (index < 0 || index >= c->length) {return 0;}
+    _ColumnList_Scatter(c, index, record);
+    return 1;
+}
+
+bool ColumnList_Pop(ColumnList* c, void* record) {
+    if (c->length < 1) {return 0;}
+    c->length--;
+    if (record != NULL) {_ColumnList_Gather(c, c->length, record);}
+    return 1;
+}
+
+void* ColumnList_Column(ColumnList* c, int field) {
+    if (field < 0 || field >= c->num_fields) {return NULL;}
+    return c->columns[field];
+}
+
+void ColumnList_Clear(ColumnList* c) {
+    for (int f = 0; f < c->num_fields; f++) {
+        Pages_Free(c->columns[f], c->size * c->fields[f].size);
+        c->columns[f] = NULL;
+    }
+    c->size = 0;
+    c->length = 0;
+}
+
+void ColumnList_Free(ColumnList* c) {
+    ColumnList_Clear(c);
+    free(c->columns);
+    free(c->fields);
+}
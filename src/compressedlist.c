@@ -0,0 +1,329 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "compressedlist.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define COMPRESSEDLIST_LANES 4
+#define COMPRESSEDLIST_ROWS (COMPRESSEDLIST_BLOCK_LENGTH / COMPRESSEDLIST_LANES)
+#define COMPRESSEDLIST_RAW_BITS 64
+#define COMPRESSEDLIST_INITIAL_BLOCKS 4
+
+// A block stores the gaps between its values, the first gap being 0. When
+// every gap fits in 32 bits they are packed with the width of the widest,
+// otherwise they are stored whole as 64 bit words.
+//
+// Packed gaps are laid out for four 32 bit lanes, as in the SIMD-BP128
+// scheme: gap i belongs to lane i % 4, and each lane packs its 32 gaps into
+// its own stream of words, which are interleaved so that word k of every
+// lane sits together. A block with width b is then b groups of four words,
+// and all four lanes are unpacked at once with the same shifts and masks.
+
+void CompressedList_Init(CompressedList* c) {
+
+    c->length = 0;
+    c->last = 0;
+
+    c->blocks = NULL;
+    c->num_blocks = 0;
+    c->blocks_size = 0;
+
+    c->data = NULL;
+    c->data_length = 0;
+    c->data_size = 0;
+
+    c->tail = NULL;
+    c->tail_length = 0;
+
+}
+
+size_t CompressedList_Length(CompressedList* c) {
+    return c->length;
+}
+
+size_t CompressedList_Bytes(CompressedList* c) {
+    size_t bytes = c->blocks_size * sizeof(CompressedBlock) + c->data_size * sizeof(uint32_t);
+    if (c->tail != NULL) {bytes += COMPRESSEDLIST_BLOCK_LENGTH * sizeof(uint64_t);}
+    return bytes;
+}
+
+static inline int _CompressedList_Words(int bits) {
+    return bits == COMPRESSEDLIST_RAW_BITS ? 2 * COMPRESSEDLIST_BLOCK_LENGTH : COMPRESSEDLIST_LANES * bits;
+}
+
+static void _CompressedList_Pack(const uint64_t* gaps, int bits, uint32_t* out) {
+
+    if (bits == COMPRESSEDLIST_RAW_BITS) {
+        memcpy(out, gaps, COMPRESSEDLIST_BLOCK_LENGTH * sizeof(uint64_t));
+        return;
+    }
+
+    memset(out, 0, _CompressedList_Words(bits) * sizeof(uint32_t));
+    for (int lane = 0; lane < COMPRESSEDLIST_LANES; lane++) {
+        int bit = 0;
+        for (int row = 0; row < COMPRESSEDLIST_ROWS; row++, bit += bits) {
+            uint32_t gap = (uint32_t) gaps[COMPRESSEDLIST_LANES * row + lane];
+            int word = bit / 32;
+            int shift = bit % 32;
+            out[COMPRESSEDLIST_LANES * word + lane] |= gap << shift;
+            if (shift + bits > 32) {out[COMPRESSEDLIST_LANES * (word + 1) + lane] |= gap >> (32 - shift);}
+        }
+    }
+
+}
+
+// Unpacks the 128 gaps of a block of width 1 to 32, four lanes at a time.
+static void _CompressedList_Unpack(const uint32_t* in, int bits, uint32_t* out) {
+
+    uint32_t mask = bits == 32 ? UINT32_MAX : ((uint32_t) 1 << bits) - 1;
+    int shift = 0;
+
+#ifdef __SSE2__
+    const __m128i* words = (const __m128i*) in;
+    __m128i lanes = _mm_set1_epi32((int) mask);
+    __m128i current = _mm_loadu_si128(words++);
+
+    for (int row = 0; row < COMPRESSEDLIST_ROWS; row++) {
+        __m128i gap = _mm_srl_epi32(current, _mm_cvtsi32_si128(shift));
+        shift += bits;
+        // The last row always ends exactly on a word, so no word past the block is read.
+        if (shift >= 32 && row < COMPRESSEDLIST_ROWS - 1) {
+            shift -= 32;
+            current = _mm_loadu_si128(words++);
+            if (shift > 0) {gap = _mm_or_si128(gap, _mm_sll_epi32(current, _mm_cvtsi32_si128(bits - shift)));}
+        }
+        _mm_storeu_si128((__m128i*) out + row, _mm_and_si128(gap, lanes));
+    }
+#else
+    uint32_t current[COMPRESSEDLIST_LANES];
+    memcpy(current, in, sizeof(current));
+    in += COMPRESSEDLIST_LANES;
+
+    for (int row = 0; row < COMPRESSEDLIST_ROWS; row++) {
+        uint32_t gaps[COMPRESSEDLIST_LANES];
+        for (int lane = 0; lane < COMPRESSEDLIST_LANES; lane++) {gaps[lane] = current[lane] >> shift;}
+        shift += bits;
+        if (shift >= 32 && row < COMPRESSEDLIST_ROWS - 1) {
+            shift -= 32;
+            memcpy(current, in, sizeof(current));
+            in += COMPRESSEDLIST_LANES;
+            if (shift > 0) {
+                for (int lane = 0; lane < COMPRESSEDLIST_LANES; lane++) {gaps[lane] |= current[lane] << (bits - shift);}
+            }
+        }
+        for (int lane = 0; lane < COMPRESSEDLIST_LANES; lane++) {out[COMPRESSEDLIST_LANES * row + lane] = gaps[lane] & mask;}
+    }
+#endif
+
+}
+
+// Decodes the values of a full block, returning how many there are.
+static int _CompressedList_Decode(CompressedList* c, int block, uint64_t* values) {
+
+    CompressedBlock* b = c->blocks + block;
+    const uint32_t* in = c->data + b->offset;
+    values[0] = b->first;
+
+    if (b->bits == 0) {
+        for (int i = 1; i < COMPRESSEDLIST_BLOCK_LENGTH; i++) {values[i] = b->first;}
+    }
+
+    else if (b->bits == COMPRESSEDLIST_RAW_BITS) {
+        memcpy(values, in, COMPRESSEDLIST_BLOCK_LENGTH * sizeof(uint64_t));
+        values[0] = b->first;
+        for (int i = 1; i < COMPRESSEDLIST_BLOCK_LENGTH; i++) {values[i] += values[i-1];}
+    }
+
+    else {
+        uint32_t gaps[COMPRESSEDLIST_BLOCK_LENGTH];
+        _CompressedList_Unpack(in, b->bits, gaps);
+        for (int i = 1; i < COMPRESSEDLIST_BLOCK_LENGTH; i++) {values[i] = values[i-1] + gaps[i];}
+    }
+
+    return COMPRESSEDLIST_BLOCK_LENGTH;
+
+}
+
+// Packs the full tail into a new block.
+static void _CompressedList_Flush(CompressedList* c) {
+
+    uint64_t gaps[COMPRESSEDLIST_BLOCK_LENGTH];
+    uint64_t widest = 0;
+    gaps[0] = 0;
+    for (int i = 1; i < COMPRESSEDLIST_BLOCK_LENGTH; i++) {
+        gaps[i] = c->tail[i] - c->tail[i-1];
+        widest |= gaps[i];
+    }
+
+    int bits = 0;
+    while (bits < 64 && (widest >> bits) != 0) {bits++;}
+    if (bits > 32) {bits = COMPRESSEDLIST_RAW_BITS;}
+
+    if (c->num_blocks == c->blocks_size) {
+        c->blocks_size = c->blocks_size > 0 ? 2 * c->blocks_size : COMPRESSEDLIST_INITIAL_BLOCKS;
+        c->blocks = realloc(c->blocks, c->blocks_size * sizeof(CompressedBlock));
+    }
+
+    size_t words = _CompressedList_Words(bits);
+    if (c->data_length + words > c->data_size) {
+        while (c->data_length + words > c->data_size) {c->data_size = c->data_size > 0 ? 2 * c->data_size : 2 * words;}
+        c->data = realloc(c->data, c->data_size * sizeof(uint32_t));
+    }
+
+    c->blocks[c->num_blocks++] = (CompressedBlock) {c->tail[0], c->data_length, bits};
+    _CompressedList_Pack(gaps, bits, c->data + c->data_length);
+    c->data_length += words;
+    c->tail_length = 0;
+
+}
+
+bool CompressedList_Append(CompressedList* c, uint64_t value) {
+
+    if (c->length > 0 && value < c->last) {return 0;}
+    if (c->tail == NULL) {c->tail = malloc(COMPRESSEDLIST_BLOCK_LENGTH * sizeof(uint64_t));}
+
+    c->tail[c->tail_length++] = value;
+    c->last = value;
+    c->length++;
+
+    if (c->tail_length == COMPRESSEDLIST_BLOCK_LENGTH) {_CompressedList_Flush(c);}
+    return 1;
+
+}
+
+// Loads a block into the iterator, where the block after the last full one is the tail.
+static void _CompressedList_Load(CompressedListIterator* it, int block) {
+
+    CompressedList* c = it->list;
+    it->block = block;
+    it->index = 0;
+
+    if (block < c->num_blocks) {it->count = _CompressedList_Decode(c, block, it->values);}
+    else {
+        it->block = c->num_blocks;
+        it->count = c->tail_length;
+        if (it->count > 0) {memcpy(it->values, c->tail, it->count * sizeof(uint64_t));}
+    }
+
+}
+
+// Moves to the first value not less than the given one, looking no further back than a block.
+static void _CompressedList_Seek(CompressedListIterator* it, int from, uint64_t value) {
+
+    CompressedList* c = it->list;
+
+    // Find the last block starting below the value. Equal values may run across blocks, so the
+    // answer is in that block or at the start of the next, never in one starting at the value.
+    int lo = from;
+    int hi = c->num_blocks;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (c->blocks[mid].first < value) {lo = mid + 1;}
+        else {hi = mid;}
+    }
+    int block = lo > from ? lo - 1 : from;
+
+    if (block != it->block) {_CompressedList_Load(it, block);}
+
+    while (1) {
+        while (it->index < it->count && it->values[it->index] < value) {it->index++;}
+        if (it->index < it->count || it->block >= c->num_blocks) {return;}
+        _CompressedList_Load(it, it->block + 1);
+    }
+
+}
+
+CompressedListIterator CompressedList_First(CompressedList* c) {
+    CompressedListIterator it;
+    it.list = c;
+    _CompressedList_Load(&it, 0);
+    return it;
+}
+
+CompressedListIterator CompressedList_LowerBound(CompressedList* c, uint64_t value) {
+    CompressedListIterator it;
+    it.list = c;
+    it.block = -1;
+    it.count = 0;
+    _CompressedList_Seek(&it, 0, value);
+    return it;
+}
+
+bool CompressedListIterator_Valid(CompressedListIterator* it) {
+    return it->index < it->count;
+}
+
+void CompressedListIterator_Next(CompressedListIterator* it) {
+    it->index++;
+    if (it->index == it->count && it->block < it->list->num_blocks) {_CompressedList_Load(it, it->block + 1);}
+}
+
+void CompressedListIterator_SkipTo(CompressedListIterator* it, uint64_t value) {
+
+    if (it->index >= it->count || it->values[it->index] >= value) {return;}
+
+    // Stay within the decoded block if the value is in it.
+    if (it->values[it->count - 1] >= value) {
+        while (it->values[it->index] < value) {it->index++;}
+        return;
+    }
+
+    _CompressedList_Seek(it, it->block + 1 < it->list->num_blocks ? it->block + 1 : it->list->num_blocks, value);
+
+}
+
+uint64_t CompressedListIterator_Value(CompressedListIterator* it) {
+    return it->values[it->index];
+}
+
+bool CompressedList_FromList(CompressedList* c, List* l) {
+
+    size_t size = l->element_size;
+    if (size != sizeof(uint32_t) && size != sizeof(uint64_t)) {return 0;}
+
+    CompressedList_Init(c);
+    for (int i = 0; i < l->length; i++) {
+        uint64_t value;
+        if (size == sizeof(uint32_t)) {value = *(uint32_t*) l->elements[i];}
+        else {value = *(uint64_t*) l->elements[i];}
+        if (!CompressedList_Append(c, value)) {
+            CompressedList_Free(c);
+            return 0;
+        }
+    }
+
+    return 1;
+
+}
+
+bool CompressedList_ToList(CompressedList* c, List* out, size_t element_size) {
+
+    if (element_size != sizeof(uint32_t) && element_size != sizeof(uint64_t)) {return 0;}
+
+    List_Init(out, element_size);
+    CompressedListIterator it = CompressedList_First(c);
+    while (CompressedListIterator_Valid(&it)) {
+        uint64_t value = CompressedListIterator_Value(&it);
+        uint32_t narrow = (uint32_t) value;
+        List_Push(out, element_size == sizeof(uint32_t) ? (void*) &narrow : (void*) &value);
+        CompressedListIterator_Next(&it);
+    }
+
+    return 1;
+
+}
+
+void CompressedList_Clear(CompressedList* c) {
+    CompressedList_Free(c);
+    CompressedList_Init(c);
+}
+
+void CompressedList_Free(CompressedList* c) {
+    free(c->blocks);
+    free(c->data);
+    free(c->tail);
+}
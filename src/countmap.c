@@ -0,0 +1,53 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include "countmap.h"
+
+// The counts live in the value blocks of the HashMap, which never move while
+// their key is in the map, so an address handed out by CountMap_Counter can
+// be added to atomically by any thread without going through the table.
+
+void CountMap_Init(CountMap* c, size_t key_size) {
+    HashMap_Init(&c->counts, key_size, sizeof(_Atomic int64_t));
+}
+
+int CountMap_Size(CountMap* c) {
+    return HashMap_Size(&c->counts);
+}
+
+int64_t CountMap_Get(CountMap* c, void* key) {
+    _Atomic int64_t* count = HashMap_Reference(&c->counts, key);
+    return count != NULL ? atomic_load_explicit(count, memory_order_relaxed) : 0;
+}
+
+_Atomic int64_t* CountMap_Counter(CountMap* c, void* key) {
+
+    _Atomic int64_t* count = HashMap_Reference(&c->counts, key);
+    if (count != NULL) {return count;}
+
+    int64_t zero = 0;
+    HashMap_Put(&c->counts, key, &zero);
+    return HashMap_Reference(&c->counts, key);
+
+}
+
+int64_t CountMap_Add(CountMap* c, void* key, int64_t delta) {
+    return atomic_fetch_add_explicit(CountMap_Counter(c, key), delta, memory_order_relaxed) + delta;
+}
+
+bool CountMap_Remove(CountMap* c, void* key) {
+    return HashMap_Remove(&c->counts, key);
+}
+
+KeyValue* CountMap_Elements(CountMap* c) {
+    return HashMap_Elements(&c->counts);
+}
+
+void CountMap_Clear(CountMap* c) {
+    HashMap_Clear(&c->counts);
+}
+
+void CountMap_Free(CountMap* c) {
+    HashMap_Free(&c->counts);
+}
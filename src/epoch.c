@@ -0,0 +1,202 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "epoch.h"
+
+#define EPOCH_COLLECT_LENGTH 64
+
+// The global epoch only moves forward once every thread inside a read has
+// seen its current value. Memory retired during epoch e may still be seen by
+// readers which entered during e or e - 1, so it is freed once the global
+// epoch reaches e + 2. Each thread owns a record on its own cache line, which
+// it writes on entering and leaving a read, and its own list of retired memory.
+
+struct _EpochGarbage {
+    void* memory;
+    size_t size;
+    void (*destroy)(void*, size_t);
+    uint64_t epoch;
+};
+
+struct _EpochThread {
+
+    _Alignas(64) atomic_uint_fast64_t active;
+    atomic_bool used;
+    int nesting;
+
+    struct _EpochGarbage* garbage;
+    int length;
+    int size;
+
+    struct _EpochThread* next;
+
+};
+
+static struct {
+
+    _Alignas(64) atomic_uint_fast64_t epoch;
+    _Alignas(64) struct _EpochThread* _Atomic threads;
+
+    once_flag once;
+    tss_t key;
+    mtx_t orphans_mutex;
+    struct _EpochThread orphans;
+
+} _Epoch = {.epoch = 1, .once = ONCE_FLAG_INIT};
+
+static _Thread_local struct _EpochThread* _Epoch_Self = NULL;
+
+static void _Epoch_Push(struct _EpochThread* t, void* memory, size_t size, void (*destroy)(void*, size_t), uint64_t epoch) {
+    if (t->length == t->size) {
+        t->size = t->size > 0 ? 2 * t->size : EPOCH_COLLECT_LENGTH;
+        t->garbage = realloc(t->garbage, t->size * sizeof(struct _EpochGarbage));
+    }
+    t->garbage[t->length++] = (struct _EpochGarbage) {memory, size, destroy, epoch};
+}
+
+// Frees everything in a list which was retired at least two epochs ago.
+static void _Epoch_Free(struct _EpochThread* t, uint64_t epoch) {
+    int length = 0;
+    for (int i = 0; i < t->length; i++) {
+        struct _EpochGarbage* g = t->garbage + i;
+        if (g->epoch + 2 > epoch) {t->garbage[length++] = *g; continue;}
+        if (g->destroy != NULL) {g->destroy(g->memory, g->size);}
+        else {free(g->memory);}
+    }
+    t->length = length;
+}
+
+// Hands the retired memory of an exiting thread over to the orphans, and frees its record for reuse.
+static void _Epoch_Release(void* arg) {
+
+    struct _EpochThread* t = arg;
+
+    mtx_lock(&_Epoch.orphans_mutex);
+    for (int i = 0; i < t->length; i++) {
+        struct _EpochGarbage* g = t->garbage + i;
+        _Epoch_Push(&_Epoch.orphans, g->memory, g->size, g->destroy, g->epoch);
+    }
+    mtx_unlock(&_Epoch.orphans_mutex);
+
+    free(t->garbage);
+    t->garbage = NULL;
+    t->length = 0;
+    t->size = 0;
+    t->nesting = 0;
+    atomic_store(&t->active, 0);
+    atomic_store(&t->used, 0);
+
+}
+
+static void _Epoch_Init(void) {
+    tss_create(&_Epoch.key, _Epoch_Release);
+    mtx_init(&_Epoch.orphans_mutex, mtx_plain);
+}
+
+// Returns the record of the calling thread, claiming a free one or adding a new one.
+static struct _EpochThread* _Epoch_Thread(void) {
+
+    if (_Epoch_Self != NULL) {return _Epoch_Self;}
+    call_once(&_Epoch.once, _Epoch_Init);
+
+    struct _EpochThread* t;
+    for (t = atomic_load(&_Epoch.threads); t != NULL; t = t->next) {
+        bool used = 0;
+        if (!atomic_load(&t->used) && atomic_compare_exchange_strong(&t->used, &used, 1)) {break;}
+    }
+
+    if (t == NULL) {
+        t = aligned_alloc(64, sizeof(struct _EpochThread));
+        atomic_init(&t->active, 0);
+        atomic_init(&t->used, 1);
+        t->nesting = 0;
+        t->garbage = NULL;
+        t->length = 0;
+        t->size = 0;
+        t->next = atomic_load(&_Epoch.threads);
+        while (!atomic_compare_exchange_weak(&_Epoch.threads, &t->next, t)) {}
+    }
+
+    _Epoch_Self = t;
+    tss_set(_Epoch.key, t);
+    return t;
+
+}
+
+void Epoch_Enter(void) {
+
+    struct _EpochThread* t = _Epoch_Thread();
+    if (t->nesting++ > 0) {return;}
+
+    // Publish the epoch before reading anything it protects.
+    atomic_store_explicit(&t->active, atomic_load_explicit(&_Epoch.epoch, memory_order_relaxed), memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+
+}
+
+void Epoch_Exit(void) {
+    struct _EpochThread* t = _Epoch_Self;
+    if (t == NULL || t->nesting == 0) {return;}
+    if (--t->nesting == 0) {atomic_store_explicit(&t->active, 0, memory_order_release);}
+}
+
+// Moves the global epoch forward if every thread inside a read has seen it, returning the epoch after.
+static uint64_t _Epoch_Advance(void) {
+
+    atomic_thread_fence(memory_order_seq_cst);
+    uint64_t epoch = atomic_load(&_Epoch.epoch);
+
+    for (struct _EpochThread* t = atomic_load(&_Epoch.threads); t != NULL; t = t->next) {
+        uint64_t active = atomic_load_explicit(&t->active, memory_order_acquire);
+        if (active != 0 && active != epoch) {return epoch;}
+    }
+
+    if (atomic_compare_exchange_strong(&_Epoch.epoch, &epoch, epoch + 1)) {return epoch + 1;}
+    return epoch;
+
+}
+
+static void _Epoch_Collect(struct _EpochThread* t) {
+
+    uint64_t epoch = _Epoch_Advance();
+    _Epoch_Free(t, epoch);
+
+    if (mtx_trylock(&_Epoch.orphans_mutex) == thrd_success) {
+        _Epoch_Free(&_Epoch.orphans, epoch);
+        mtx_unlock(&_Epoch.orphans_mutex);
+    }
+
+}
+
+void Epoch_Retire(void* memory, size_t size, void (*destroy)(void*, size_t)) {
+
+    if (memory == NULL) {return;}
+
+    struct _EpochThread* t = _Epoch_Thread();
+    _Epoch_Push(t, memory, size, destroy, atomic_load(&_Epoch.epoch));
+
+    // Try to free a batch at a time, so the scan of the threads is amortised.
+    if (t->length % EPOCH_COLLECT_LENGTH == 0) {_Epoch_Collect(t);}
+
+}
+
+void Epoch_Barrier(void) {
+
+    struct _EpochThread* t = _Epoch_Thread();
+
+    while (1) {
+
+        _Epoch_Collect(t);
+
+        mtx_lock(&_Epoch.orphans_mutex);
+        bool orphans = _Epoch.orphans.length > 0;
+        mtx_unlock(&_Epoch.orphans_mutex);
+
+        if (t->length == 0 && !orphans) {return;}
+        thrd_yield();
+
+    }
+
+}
@@ -0,0 +1,441 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "hash.h"
+#include "filter.h"
+
+#define BLOOMFILTER_MAGIC UINT64_C(0x31544c4642534443)
+#define BLOOMFILTER_HEADER 6
+#define BLOOMFILTER_BLOCK_WORDS 8
+#define BLOOMFILTER_MAX_HASHES 16
+#define BLOOMFILTER_BATCH 16
+
+#define CUCKOOFILTER_MAGIC UINT64_C(0x31544c4643534443)
+#define CUCKOOFILTER_HEADER 9
+#define CUCKOOFILTER_BUCKET_SIZE 4
+#define CUCKOOFILTER_MAX_KICKS 500
+
+//-----------------------------------------------------------------------------
+// Blocked Bloom filter
+//-----------------------------------------------------------------------------
+
+static inline uint64_t _BloomFilter_Hash(BloomFilter* f, const void* key) {
+    return SIP64((uint8_t*)key, f->key_size, f->seed_0, f->seed_1);
+}
+
+static inline uint64_t* _BloomFilter_Block(BloomFilter* f, uint64_t hash) {
+    return f->bits + (hash % f->blocks) * BLOOMFILTER_BLOCK_WORDS;
+}
+
+static inline void _BloomFilter_Set(BloomFilter* f, uint64_t hash) {
+
+    uint64_t* block = _BloomFilter_Block(f, hash);
+
+    // Remix the hash so the bit positions are independent of the block index.
+    uint64_t g = hash * UINT64_C(0xff51afd7ed558ccd);
+    g ^= g >> 33;
+    uint32_t a = (uint32_t) (g >> 32);
+    uint32_t b = (uint32_t) g | 1;
+
+    for (int i = 0; i < f->hashes; i++) {
+        uint32_t bit = (a + i * b) >> 23;
+        block[bit >> 6] |= UINT64_C(1) << (bit & 63);
+    }
+
+}
+
+static inline bool _BloomFilter_Test(BloomFilter* f, uint64_t hash) {
+
+    uint64_t* block = _BloomFilter_Block(f, hash);
+
+    uint64_t g = hash * UINT64_C(0xff51afd7ed558ccd);
+    g ^= g >> 33;
+    uint32_t a = (uint32_t) (g >> 32);
+    uint32_t b = (uint32_t) g | 1;
+
+    for (int i = 0; i < f->hashes; i++) {
+        uint32_t bit = (a + i * b) >> 23;
+        if ((block[bit >> 6] & (UINT64_C(1) << (bit & 63))) == 0) {return 0;}
+    }
+
+    return 1;
+
+}
+
+void _BloomFilter_Init(BloomFilter* f, size_t key_size, size_t blocks, int hashes, uint64_t seed_0, uint64_t seed_1) {
+
+    f->key_size = key_size;
+    f->blocks = blocks;
+    f->hashes = hashes;
+
+    // Each block is exactly one cache line.
+    f->bits = aligned_alloc(64, blocks * BLOOMFILTER_BLOCK_WORDS * sizeof(uint64_t));
+    memset(f->bits, 0, blocks * BLOOMFILTER_BLOCK_WORDS * sizeof(uint64_t));
+
+    f->seed_0 = seed_0;
+    f->seed_1 = seed_1;
+
+}
+
+void BloomFilter_Init(BloomFilter* f, size_t key_size, size_t capacity, size_t bits_per_key) {
+
+    if (bits_per_key < 1) {bits_per_key = 1;}
+
+    size_t blocks = (capacity * bits_per_key + 511) / 512;
+    if (blocks < 1) {blocks = 1;}
+
+    // The optimal number of hashes is ln(2) times the bits per key.
+    int hashes = (int) (bits_per_key * 0.693 + 0.5);
+    if (hashes < 1) {hashes = 1;}
+    if (hashes > BLOOMFILTER_MAX_HASHES) {hashes = BLOOMFILTER_MAX_HASHES;}
+
+    _BloomFilter_Init(f, key_size, blocks, hashes, SEED64(), SEED64());
+
+}
+
+void BloomFilter_Add(BloomFilter* f, void* key) {
+    _BloomFilter_Set(f, _BloomFilter_Hash(f, key));
+}
+
+bool BloomFilter_Contains(BloomFilter* f, void* key) {
+    return _BloomFilter_Test(f, _BloomFilter_Hash(f, key));
+}
+
+void BloomFilter_AddMany(BloomFilter* f, void* keys, int count) {
+
+    uint64_t hashes[BLOOMFILTER_BATCH];
+    uint8_t* key = keys;
+
+    for (int i = 0; i < count; i += BLOOMFILTER_BATCH) {
+
+        int batch = count - i < BLOOMFILTER_BATCH ? count - i : BLOOMFILTER_BATCH;
+
+        // Hash the whole batch and start loading every block before touching any of them.
+        for (int j = 0; j < batch; j++) {
+            hashes[j] = _BloomFilter_Hash(f, key);
+            __builtin_prefetch(_BloomFilter_Block(f, hashes[j]), 1);
+            key += f->key_size;
+        }
+
+        for (int j = 0; j < batch; j++) {
+            _BloomFilter_Set(f, hashes[j]);
+        }
+
+    }
+
+}
+
+int BloomFilter_ContainsMany(BloomFilter* f, void* keys, int count, bool* results) {
+
+    uint64_t hashes[BLOOMFILTER_BATCH];
+    uint8_t* key = keys;
+    int found = 0;
+
+    for (int i = 0; i < count; i += BLOOMFILTER_BATCH) {
+
+        int batch = count - i < BLOOMFILTER_BATCH ? count - i : BLOOMFILTER_BATCH;
+
+        for (int j = 0; j < batch; j++) {
+            hashes[j] = _BloomFilter_Hash(f, key);
+            __builtin_prefetch(_BloomFilter_Block(f, hashes[j]), 0);
+            key += f->key_size;
+        }
+
+        for (int j = 0; j < batch; j++) {
+            bool result = _BloomFilter_Test(f, hashes[j]);
+            if (results != NULL) {results[i + j] = result;}
+            found += result;
+        }
+
+    }
+
+    return found;
+
+}
+
+size_t BloomFilter_SerializedSize(BloomFilter* f) {
+    return (BLOOMFILTER_HEADER + f->blocks * BLOOMFILTER_BLOCK_WORDS) * sizeof(uint64_t);
+}
+
+void BloomFilter_Serialize(BloomFilter* f, void* buffer) {
+
+    uint64_t header[BLOOMFILTER_HEADER] = {
+        BLOOMFILTER_MAGIC, f->key_size, f->blocks, f->hashes, f->seed_0, f->seed_1
+    };
+
+    memcpy(buffer, header, sizeof(header));
+    memcpy((uint8_t*) buffer + sizeof(header), f->bits, f->blocks * BLOOMFILTER_BLOCK_WORDS * sizeof(uint64_t));
+
+}
+
+bool BloomFilter_Deserialize(BloomFilter* f, void* buffer, size_t length) {
+
+    uint64_t header[BLOOMFILTER_HEADER];
+    if (length < sizeof(header)) {return 0;}
+    memcpy(header, buffer, sizeof(header));
+
+    // Validate the header before trusting any of the sizes in it.
+    if (header[0] != BLOOMFILTER_MAGIC) {return 0;}
+    if (header[2] < 1 || header[2] > (SIZE_MAX / sizeof(uint64_t)) / BLOOMFILTER_BLOCK_WORDS - BLOOMFILTER_HEADER) {return 0;}
+    if (header[3] < 1 || header[3] > BLOOMFILTER_MAX_HASHES) {return 0;}
+    if (length != (BLOOMFILTER_HEADER + header[2] * BLOOMFILTER_BLOCK_WORDS) * sizeof(uint64_t)) {return 0;}
+
+    _BloomFilter_Init(f, header[1], header[2], (int) header[3], header[4], header[5]);
+    memcpy(f->bits, (uint8_t*) buffer + sizeof(header), f->blocks * BLOOMFILTER_BLOCK_WORDS * sizeof(uint64_t));
+    return 1;
+
+}
+
+void BloomFilter_Clear(BloomFilter* f) {
+    memset(f->bits, 0, f->blocks * BLOOMFILTER_BLOCK_WORDS * sizeof(uint64_t));
+}
+
+void BloomFilter_Free(BloomFilter* f) {
+    free(f->bits);
+}
+
+//-----------------------------------------------------------------------------
+// Cuckoo filter
+//-----------------------------------------------------------------------------
+
+static inline uint64_t _CuckooFilter_Hash(CuckooFilter* f, const void* key) {
+    return SIP64((uint8_t*)key, f->key_size, f->seed_0, f->seed_1);
+}
+
+static inline uint16_t _CuckooFilter_Fingerprint(uint64_t hash) {
+    // A fingerprint of zero marks an empty entry.
+    uint16_t fingerprint = (uint16_t) (hash >> 48);
+    return fingerprint == 0 ? 1 : fingerprint;
+}
+
+static inline size_t _CuckooFilter_Alternate(CuckooFilter* f, size_t bucket, uint16_t fingerprint) {
+    // Partial key cuckoo hashing, the alternate bucket only depends on the fingerprint.
+    return (bucket ^ (fingerprint * UINT64_C(0x5bd1e995))) & (f->buckets - 1);
+}
+
+static inline uint64_t _CuckooFilter_Next(CuckooFilter* f) {
+    f->state ^= f->state << 13;
+    f->state ^= f->state >> 7;
+    f->state ^= f->state << 17;
+    return f->state;
+}
+
+bool _CuckooFilter_TryPut(CuckooFilter* f, size_t bucket, uint16_t fingerprint) {
+
+    uint16_t* entries = f->fingerprints + bucket * CUCKOOFILTER_BUCKET_SIZE;
+    for (int i = 0; i < CUCKOOFILTER_BUCKET_SIZE; i++) {
+        if (entries[i] == 0) {
+            entries[i] = fingerprint;
+            return 1;
+        }
+    }
+
+    return 0;
+
+}
+
+bool _CuckooFilter_TryRemove(CuckooFilter* f, size_t bucket, uint16_t fingerprint) {
+
+    uint16_t* entries = f->fingerprints + bucket * CUCKOOFILTER_BUCKET_SIZE;
+    for (int i = 0; i < CUCKOOFILTER_BUCKET_SIZE; i++) {
+        if (entries[i] == fingerprint) {
+            entries[i] = 0;
+            return 1;
+        }
+    }
+
+    return 0;
+
+}
+
+bool _CuckooFilter_Has(CuckooFilter* f, size_t bucket, uint16_t fingerprint) {
+
+    uint16_t* entries = f->fingerprints + bucket * CUCKOOFILTER_BUCKET_SIZE;
+    return entries[0] == fingerprint || entries[1] == fingerprint
+        || entries[2] == fingerprint || entries[3] == fingerprint;
+
+}
+
+bool _CuckooFilter_Put(CuckooFilter* f, size_t bucket, uint16_t fingerprint) {
+
+    if (_CuckooFilter_TryPut(f, bucket, fingerprint)) {return 1;}
+    bucket = _CuckooFilter_Alternate(f, bucket, fingerprint);
+    if (_CuckooFilter_TryPut(f, bucket, fingerprint)) {return 1;}
+
+    // Kick random fingerprints to their alternate buckets until one finds space.
+    for (int i = 0; i < CUCKOOFILTER_MAX_KICKS; i++) {
+
+        uint16_t* entry = f->fingerprints + bucket * CUCKOOFILTER_BUCKET_SIZE + (_CuckooFilter_Next(f) & 3);
+        uint16_t tmp = *entry;
+        *entry = fingerprint;
+        fingerprint = tmp;
+
+        bucket = _CuckooFilter_Alternate(f, bucket, fingerprint);
+        if (_CuckooFilter_TryPut(f, bucket, fingerprint)) {return 1;}
+
+    }
+
+    // The table is full, keep the homeless fingerprint aside so it is not lost.
+    f->victim = fingerprint;
+    f->victim_bucket = bucket;
+    return 1;
+
+}
+
+void _CuckooFilter_Init(CuckooFilter* f, size_t key_size, size_t buckets, uint64_t seed_0, uint64_t seed_1, uint64_t state) {
+
+    f->key_size = key_size;
+    f->buckets = buckets;
+    f->size = 0;
+
+    f->fingerprints = calloc(buckets * CUCKOOFILTER_BUCKET_SIZE, sizeof(uint16_t));
+    f->victim = 0;
+    f->victim_bucket = 0;
+
+    f->seed_0 = seed_0;
+    f->seed_1 = seed_1;
+    f->state = state == 0 ? 1 : state;
+
+}
+
+void CuckooFilter_Init(CuckooFilter* f, size_t key_size, size_t capacity) {
+
+    // Buckets of four fill to about 95% before insertions start failing.
+    size_t buckets = 1;
+    while (buckets * CUCKOOFILTER_BUCKET_SIZE * 95 < capacity * 100) {buckets *= 2;}
+
+    _CuckooFilter_Init(f, key_size, buckets, SEED64(), SEED64(), SEED64());
+
+}
+
+int CuckooFilter_Size(CuckooFilter* f) {
+    return f->size;
+}
+
+bool CuckooFilter_Add(CuckooFilter* f, void* key) {
+
+    // A pending victim means the last insertion already failed to find space.
+    if (f->victim != 0) {return 0;}
+
+    uint64_t hash = _CuckooFilter_Hash(f, key);
+    _CuckooFilter_Put(f, hash & (f->buckets - 1), _CuckooFilter_Fingerprint(hash));
+    f->size++;
+    return 1;
+
+}
+
+bool CuckooFilter_Contains(CuckooFilter* f, void* key) {
+
+    uint64_t hash = _CuckooFilter_Hash(f, key);
+    uint16_t fingerprint = _CuckooFilter_Fingerprint(hash);
+    size_t left = hash & (f->buckets - 1);
+    size_t right = _CuckooFilter_Alternate(f, left, fingerprint);
+
+    if (_CuckooFilter_Has(f, left, fingerprint)) {return 1;}
+    if (_CuckooFilter_Has(f, right, fingerprint)) {return 1;}
+    return f->victim == fingerprint && (f->victim_bucket == left || f->victim_bucket == right);
+
+}
+
+bool CuckooFilter_Remove(CuckooFilter* f, void* key) {
+
+    uint64_t hash = _CuckooFilter_Hash(f, key);
+    uint16_t fingerprint = _CuckooFilter_Fingerprint(hash);
+    size_t left = hash & (f->buckets - 1);
+    size_t right = _CuckooFilter_Alternate(f, left, fingerprint);
+
+    if (f->victim == fingerprint && (f->victim_bucket == left || f->victim_bucket == right)) {
+        f->victim = 0;
+        f->size--;
+        return 1;
+    }
+
+    if (!_CuckooFilter_TryRemove(f, left, fingerprint) && !_CuckooFilter_TryRemove(f, right, fingerprint)) {return 0;}
+    f->size--;
+
+    // There is space again, try to give the victim a home.
+    if (f->victim != 0) {
+        uint16_t victim = f->victim;
+        f->victim = 0;
+        _CuckooFilter_Put(f, f->victim_bucket, victim);
+    }
+
+    return 1;
+
+}
+
+int CuckooFilter_AddMany(CuckooFilter* f, void* keys, int count) {
+
+    uint8_t* key = keys;
+    for (int i = 0; i < count; i++) {
+        if (!CuckooFilter_Add(f, key)) {return i;}
+        key += f->key_size;
+    }
+
+    return count;
+
+}
+
+int CuckooFilter_ContainsMany(CuckooFilter* f, void* keys, int count, bool* results) {
+
+    uint8_t* key = keys;
+    int found = 0;
+
+    for (int i = 0; i < count; i++) {
+        bool result = CuckooFilter_Contains(f, key);
+        if (results != NULL) {results[i] = result;}
+        found += result;
+        key += f->key_size;
+    }
+
+    return found;
+
+}
+
+size_t CuckooFilter_SerializedSize(CuckooFilter* f) {
+    return CUCKOOFILTER_HEADER * sizeof(uint64_t) + f->buckets * CUCKOOFILTER_BUCKET_SIZE * sizeof(uint16_t);
+}
+
+void CuckooFilter_Serialize(CuckooFilter* f, void* buffer) {
+
+    uint64_t header[CUCKOOFILTER_HEADER] = {
+        CUCKOOFILTER_MAGIC, f->key_size, f->buckets, f->size, f->victim, f->victim_bucket, f->seed_0, f->seed_1, f->state
+    };
+
+    memcpy(buffer, header, sizeof(header));
+    memcpy((uint8_t*) buffer + sizeof(header), f->fingerprints, f->buckets * CUCKOOFILTER_BUCKET_SIZE * sizeof(uint16_t));
+
+}
+
+bool CuckooFilter_Deserialize(CuckooFilter* f, void* buffer, size_t length) {
+
+    uint64_t header[CUCKOOFILTER_HEADER];
+    if (length < sizeof(header)) {return 0;}
+    memcpy(header, buffer, sizeof(header));
+
+    // Validate the header before trusting any of the sizes in it.
+    if (header[0] != CUCKOOFILTER_MAGIC) {return 0;}
+    if (header[2] < 1 || (header[2] & (header[2] - 1)) != 0) {return 0;}
+    if (header[2] > (SIZE_MAX - sizeof(header)) / (CUCKOOFILTER_BUCKET_SIZE * sizeof(uint16_t))) {return 0;}
+    if (length != sizeof(header) + header[2] * CUCKOOFILTER_BUCKET_SIZE * sizeof(uint16_t)) {return 0;}
+    if (header[4] > UINT16_MAX || header[5] >= header[2]) {return 0;}
+
+    _CuckooFilter_Init(f, header[1], header[2], header[6], header[7], header[8]);
+    f->size = header[3];
+    f->victim = (uint16_t) header[4];
+    f->victim_bucket = header[5];
+    memcpy(f->fingerprints, (uint8_t*) buffer + sizeof(header), f->buckets * CUCKOOFILTER_BUCKET_SIZE * sizeof(uint16_t));
+    return 1;
+
+}
+
+void CuckooFilter_Clear(CuckooFilter* f) {
+    memset(f->fingerprints, 0, f->buckets * CUCKOOFILTER_BUCKET_SIZE * sizeof(uint16_t));
+    f->victim = 0;
+    f->size = 0;
+}
+
+void CuckooFilter_Free(CuckooFilter* f) {
+    free(f->fingerprints);
+}
@@ -0,0 +1,166 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "hash.h"
+#include "frozenhashmap.h"
+
+#define FROZENHASHMAP_BUCKET_SIZE 4
+
+static inline uint64_t _FrozenHashMap_Mix(uint64_t x) {
+    x ^= x >> 30;
+    x *= UINT64_C(0xbf58476d1ce4e5b9);
+    x ^= x >> 27;
+    x *= UINT64_C(0x94d049bb133111eb);
+    x ^= x >> 31;
+    return x;
+}
+
+static inline size_t _FrozenHashMap_Bucket(FrozenHashMap* f, uint64_t hash) {
+    return (size_t) (((hash >> 32) * f->buckets) >> 32);
+}
+
+static inline size_t _FrozenHashMap_Slot(FrozenHashMap* f, uint64_t hash, uint32_t pilot) {
+    return _FrozenHashMap_Mix(hash ^ _FrozenHashMap_Mix(pilot)) % f->size;
+}
+
+bool _FrozenHashMap_Build(FrozenHashMap* f, uint64_t* hashes) {
+
+    size_t n = f->size;
+    size_t* starts = calloc(f->buckets + 1, sizeof(size_t));
+    size_t* members = malloc(n * sizeof(size_t));
+    size_t* order = malloc(f->buckets * sizeof(size_t));
+    size_t* slots = malloc(n * sizeof(size_t));
+    uint8_t* taken = calloc(n, sizeof(uint8_t));
+    bool success = 1;
+
+    // Group the keys by bucket with a counting sort.
+    for (size_t i = 0; i < n; i++) {starts[_FrozenHashMap_Bucket(f, hashes[i]) + 1]++;}
+    for (size_t b = 0; b < f->buckets; b++) {starts[b+1] += starts[b];}
+    size_t* cursor = malloc(f->buckets * sizeof(size_t));
+    memcpy(cursor, starts, f->buckets * sizeof(size_t));
+    for (size_t i = 0; i < n; i++) {members[cursor[_FrozenHashMap_Bucket(f, hashes[i])]++] = i;}
+
+    // Place the largest buckets first, while the table is still mostly empty.
+    size_t largest = 0;
+    for (size_t b = 0; b < f->buckets; b++) {
+        if (starts[b+1] - starts[b] > largest) {largest = starts[b+1] - starts[b];}
+    }
+    size_t k = 0;
+    for (size_t size = largest; size > 0; size--) {
+        for (size_t b = 0; b < f->buckets; b++) {
+            if (starts[b+1] - starts[b] == size) {order[k++] = b;}
+        }
+    }
+
+    // Searching for a pilot takes about n tries for the very last bucket.
+    uint64_t limit = 32 * (uint64_t) n + 1024;
+
+    for (size_t i = 0; i < k && success; i++) {
+
+        size_t b = order[i];
+        size_t count = starts[b+1] - starts[b];
+        uint64_t pilot = 0;
+
+        for (; pilot < limit; pilot++) {
+
+            // Every key of the bucket needs a free slot, and no two can share one.
+            size_t j = 0;
+            for (; j < count; j++) {
+                size_t slot = _FrozenHashMap_Slot(f, hashes[members[starts[b] + j]], (uint32_t) pilot);
+                if (taken[slot]) {break;}
+                taken[slot] = 1;
+                slots[j] = slot;
+            }
+
+            if (j == count) {break;}
+            while (j > 0) {taken[slots[--j]] = 0;}
+
+        }
+
+        // Give up on these seeds if no pilot works.
+        if (pilot == limit) {success = 0;}
+        f->pilots[b] = (uint32_t) pilot;
+
+    }
+
+    free(starts);
+    free(members);
+    free(order);
+    free(slots);
+    free(taken);
+    free(cursor);
+    return success;
+
+}
+
+void HashMap_Freeze(HashMap* h, FrozenHashMap* f) {
+
+    size_t n = h->size;
+    size_t stride = h->key_size + h->value_size;
+
+    f->key_size = h->key_size;
+    f->value_size = h->value_size;
+    f->size = n;
+    f->buckets = n / FROZENHASHMAP_BUCKET_SIZE + 1;
+
+    f->pilots = calloc(f->buckets, sizeof(uint32_t));
+    f->entries = malloc(n * stride + 1);
+
+    KeyValue** pairs = malloc(n * sizeof(KeyValue*) + 1);
+    uint64_t* hashes = malloc(n * sizeof(uint64_t) + 1);
+
+    size_t i = 0;
+    KeyValue* current = HashMap_Elements(h);
+    while (current != NULL) {
+        pairs[i++] = current;
+        current = current->next;
+    }
+
+    // Pick new seeds until every bucket has found a pilot.
+    do {
+        f->seed_0 = SEED64();
+        f->seed_1 = SEED64();
+        for (i = 0; i < n; i++) {
+            hashes[i] = SIP64((uint8_t*)pairs[i]->key, f->key_size, f->seed_0, f->seed_1);
+        }
+    } while (!_FrozenHashMap_Build(f, hashes));
+
+    // Pack every key and value into the slot chosen by its bucket's pilot.
+    for (i = 0; i < n; i++) {
+        uint32_t pilot = f->pilots[_FrozenHashMap_Bucket(f, hashes[i])];
+        uint8_t* entry = f->entries + _FrozenHashMap_Slot(f, hashes[i], pilot) * stride;
+        memcpy(entry, pairs[i]->key, f->key_size);
+        memcpy(entry + f->key_size, pairs[i]->value, f->value_size);
+    }
+
+    free(pairs);
+    free(hashes);
+
+}
+
+int FrozenHashMap_Size(FrozenHashMap* f) {
+    return f->size;
+}
+
+bool FrozenHashMap_Get(FrozenHashMap* f, void* key, void* buffer) {
+
+    // If the buffer is null or the map is empty, there is nothing to return.
+    if (buffer == NULL || f->size == 0) {return 0;}
+
+    uint64_t hash = SIP64((uint8_t*)key, f->key_size, f->seed_0, f->seed_1);
+    uint32_t pilot = f->pilots[_FrozenHashMap_Bucket(f, hash)];
+    uint8_t* entry = f->entries + _FrozenHashMap_Slot(f, hash, pilot) * (f->key_size + f->value_size);
+
+    // Keys which were never in the map still land on some entry.
+    if (memcmp(key, entry, f->key_size) != 0) {return 0;}
+
+    memcpy(buffer, entry + f->key_size, f->value_size);
+    return 1;
+
+}
+
+void FrozenHashMap_Free(FrozenHashMap* f) {
+    free(f->pilots);
+    free(f->entries);
+}
@@ -1,4 +1,11 @@
 #include <stddef.h>
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <time.h>
+#ifdef __linux__
+#include <sys/random.h>
+#endif
 #include "hash.h"
 
 uint64_t OAAT(const char* key) {
@@ -91,4 +98,78 @@ uint64_t SIP64(const uint8_t *in, const size_t inlen, uint64_t seed0, uint64_t s
     uint64_t out = 0;
     U64TO8_LE((uint8_t*)&out, b);
     return out;
-}
\ No newline at end of file
+}
+
+//-----------------------------------------------------------------------------
+// Seeds
+//
+// One base value is read from the kernel the first time a seed is needed.
+// Every thread then draws from its own splitmix64 stream, keyed by the base
+// and the order in which threads first asked, so no lock is ever taken.
+// Pinning replaces the base and bumps the epoch, which restarts every stream.
+//-----------------------------------------------------------------------------
+
+static once_flag _SEED64_Once = ONCE_FLAG_INIT;
+static atomic_uint_fast64_t _SEED64_Base;
+static atomic_uint_fast64_t _SEED64_Epoch;
+static atomic_uint_fast64_t _SEED64_Streams;
+
+static _Thread_local uint64_t _SEED64_State;
+static _Thread_local uint64_t _SEED64_StateEpoch = 0;
+
+static inline uint64_t _SEED64_Mix(uint64_t z) {
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+}
+
+static uint64_t _SEED64_Entropy(void) {
+
+    uint64_t r;
+#ifdef __linux__
+    if (getrandom(&r, sizeof(r), 0) == sizeof(r)) {return r;}
+#endif
+
+    // Without a kernel source, mix the clock with an address that varies between runs.
+    struct timespec t;
+    timespec_get(&t, TIME_UTC);
+    return _SEED64_Mix((uint64_t) t.tv_sec * 1000000000ULL + t.tv_nsec) ^ _SEED64_Mix((uint64_t) (uintptr_t) &t);
+
+}
+
+static void _SEED64_Init(void) {
+    atomic_store(&_SEED64_Base, _SEED64_Entropy());
+    atomic_store(&_SEED64_Epoch, 1);
+}
+
+static void _SEED64_Restart(uint64_t base) {
+    call_once(&_SEED64_Once, _SEED64_Init);
+    atomic_store(&_SEED64_Base, base);
+    atomic_store(&_SEED64_Streams, 0);
+    atomic_fetch_add(&_SEED64_Epoch, 1);
+}
+
+uint64_t SEED64(void) {
+
+    call_once(&_SEED64_Once, _SEED64_Init);
+
+    // Start a new stream for this thread if it has none, or the base has changed.
+    uint64_t epoch = atomic_load_explicit(&_SEED64_Epoch, memory_order_acquire);
+    if (_SEED64_StateEpoch != epoch) {
+        uint64_t stream = atomic_fetch_add_explicit(&_SEED64_Streams, 1, memory_order_relaxed);
+        _SEED64_State = atomic_load_explicit(&_SEED64_Base, memory_order_relaxed) ^ _SEED64_Mix(stream + 1);
+        _SEED64_StateEpoch = epoch;
+    }
+
+    _SEED64_State += 0x9e3779b97f4a7c15ULL;
+    return _SEED64_Mix(_SEED64_State);
+
+}
+
+void SEED64_Pin(uint64_t seed) {
+    _SEED64_Restart(seed);
+}
+
+void SEED64_Unpin(void) {
+    _SEED64_Restart(_SEED64_Entropy());
+}
@@ -2,23 +2,131 @@
 #include <stdint.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdatomic.h>
 #include "hash.h"
 #include "hashmap.h"
+#include "threadpool.h"
+#include "pages.h"
+#include "epoch.h"
+#include "trace.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
 
 #define HASHMAP_INITIAL_N 16
+#define HASHMAP_SMALL_N 8
+#define HASHMAP_GROUP_N 1024
+#define HASHMAP_MAX_EVICTIONS 128
+#define HASHMAP_BUILD_EVICTIONS 256
+#define HASHMAP_BUILD_ATTEMPTS 8
+#define HASHMAP_SWISS_GROUP_N 16
+#define HASHMAP_EMPTY 0x80
+#define HASHMAP_DELETED 0xfe
 
 void _HashMap_Put(HashMap* h, void* key, void* value, bool allocate);
 
-uint64_t _HashMap_Random(void) {
-    uint64_t r = 0;
-    for (int i = 0; i < 64; i += 15) {
-        r = r * ((uint64_t) RAND_MAX + 1) + rand();
+static inline uint64_t _HashMap_Hash(const void *data, size_t len, uint64_t seed0, uint64_t seed1) {
+    return SIP64((uint8_t*)data, len, seed0, seed1);
+}
+
+// Buckets are split into groups of HASHMAP_GROUP_N, or one group while the
+// tables are smaller than that. The right slot of a key is always in the same
+// group as its left slot, so evictions never move a key out of its group, and
+// a scan which visits a whole group at once cannot miss it.
+static inline size_t _HashMap_GroupN(size_t n) {
+    return n < HASHMAP_GROUP_N ? n : HASHMAP_GROUP_N;
+}
+
+static inline size_t _HashMap_RightIndex(HashMap* h, size_t n, const void* key, size_t left) {
+    size_t group = _HashMap_GroupN(n);
+    return left - left % group + _HashMap_Hash(key, h->key_size, h->right_seed_0, h->right_seed_1) % group;
+}
+
+//-----------------------------------------------------------------------------
+// Swiss tables
+//
+// A swiss map keeps its n slots in one table, followed by a control byte for
+// each slot: HASHMAP_EMPTY, HASHMAP_DELETED, or the low 7 bits of the hash of
+// the key in the slot. The slots are split into groups of 16, and a key is
+// searched for from the group picked by the rest of its hash, a group at a
+// time, comparing the 16 control bytes of a group at once and then only the
+// keys whose byte matched. The first group with an empty slot ends a search.
+//
+// Removing from a group with no empty slot leaves its slot deleted rather
+// than empty, so a group never gets an empty slot back until the table is
+// rebuilt, and every key lies between its own group and the first group with
+// an empty slot after it. Searches step through the groups in order rather
+// than jumping about, which is what lets a scan visit a group's keys as one.
+//-----------------------------------------------------------------------------
+
+static inline uint8_t* _HashMap_Control(KeyValue* array, size_t n) {
+    return (uint8_t*) (array + n);
+}
+
+static inline size_t _HashMap_SwissGroup(uint64_t hash, size_t n) {
+    return (hash >> 7) & (n / HASHMAP_SWISS_GROUP_N - 1);
+}
+
+// Returns a bit for each of the 16 control bytes of a group which equals the given byte.
+static inline uint32_t _HashMap_SwissMatch(const uint8_t* control, uint8_t byte) {
+#ifdef __SSE2__
+    __m128i bytes = _mm_loadu_si128((const __m128i*) control);
+    return (uint32_t) _mm_movemask_epi8(_mm_cmpeq_epi8(bytes, _mm_set1_epi8((char) byte)));
+#else
+    uint32_t match = 0;
+    for (int i = 0; i < HASHMAP_SWISS_GROUP_N; i++) {match |= (uint32_t) (control[i] == byte) << i;}
+    return match;
+#endif
+}
+
+// Returns a bit for each slot of a group which is empty or deleted, the two control bytes with their top bit set.
+static inline uint32_t _HashMap_SwissVacant(const uint8_t* control) {
+#ifdef __SSE2__
+    return (uint32_t) _mm_movemask_epi8(_mm_loadu_si128((const __m128i*) control));
+#else
+    uint32_t vacant = 0;
+    for (int i = 0; i < HASHMAP_SWISS_GROUP_N; i++) {vacant |= (uint32_t) (control[i] >> 7) << i;}
+    return vacant;
+#endif
+}
+
+// Returns the index of the slot holding the key, or n if it is not in the table.
+static size_t _HashMap_SwissFind(HashMap* h, void* key, uint64_t hash) {
+
+    size_t groups = h->n / HASHMAP_SWISS_GROUP_N;
+    size_t group = _HashMap_SwissGroup(hash, h->n);
+    uint8_t* control = _HashMap_Control(h->array, h->n);
+
+    for (size_t i = 0; i < groups; i++) {
+        size_t start = group * HASHMAP_SWISS_GROUP_N;
+        for (uint32_t match = _HashMap_SwissMatch(control + start, hash & 0x7f); match != 0; match &= match - 1) {
+            size_t slot = start + __builtin_ctz(match);
+            if (memcmp(key, h->array[slot].key, h->key_size) == 0) {return slot;}
+        }
+        if (_HashMap_SwissMatch(control + start, HASHMAP_EMPTY) != 0) {break;}
+        group = (group + 1) & (groups - 1);
     }
-    return r;
+
+    return h->n;
+
 }
 
-static inline uint64_t _HashMap_Hash(const void *data, size_t len, uint64_t seed0, uint64_t seed1) {
-    return SIP64((uint8_t*)data, len, seed0, seed1);
+// Returns the index of the first empty or deleted slot along the search for a key which is not in the table.
+static size_t _HashMap_SwissClaim(KeyValue* array, size_t n, uint64_t hash) {
+
+    size_t groups = n / HASHMAP_SWISS_GROUP_N;
+    size_t group = _HashMap_SwissGroup(hash, n);
+    uint8_t* control = _HashMap_Control(array, n);
+
+    // The table is never full, so some group has a free slot.
+    while (1) {
+        size_t start = group * HASHMAP_SWISS_GROUP_N;
+        uint32_t vacant = _HashMap_SwissVacant(control + start);
+        if (vacant != 0) {return start + __builtin_ctz(vacant);}
+        group = (group + 1) & (groups - 1);
+    }
+
 }
 
 void _HashMap_Init(HashMap* h, size_t n, size_t key_size, size_t value_size) {
@@ -28,14 +136,21 @@ void _HashMap_Init(HashMap* h, size_t n, size_t key_size, size_t value_size) {
     h->size = 0;
     h->n = n;
 
-    h->array = malloc(2 * n * sizeof(KeyValue));
+    h->array = Pages_Alloc(2 * n * sizeof(KeyValue));
     h->head = NULL;
     h->tail = NULL;
 
-    h->left_seed_0 = _HashMap_Random();
-    h->left_seed_1 = _HashMap_Random();
-    h->right_seed_0 = _HashMap_Random();
-    h->right_seed_1 = _HashMap_Random();
+    h->left_seed_0 = SEED64();
+    h->left_seed_1 = SEED64();
+    h->right_seed_0 = SEED64();
+    h->right_seed_1 = SEED64();
+
+    h->engine = HASHMAP_CUCKOO;
+    h->deleted = 0;
+
+    atomic_init(&h->version, 0);
+    h->concurrent = 0;
+    h->share = NULL;
 
     for (int i = 0; i < 2 * n; i++) {
         h->array[i].key = NULL;
@@ -44,8 +159,335 @@ void _HashMap_Init(HashMap* h, size_t n, size_t key_size, size_t value_size) {
 
 }
 
+// A map starts out small, with n set to 0. Its pairs live in an array of
+// HASHMAP_SMALL_N slots which is only allocated on the first put, and keys
+// are found by comparing them one at a time, so neither seeding nor hashing
+// is needed until the map outgrows it and is grown into the tables of its engine.
+void HashMap_InitEngine(HashMap* h, size_t key_size, size_t value_size, HashMapEngine engine) {
+
+    h->key_size = key_size;
+    h->value_size = value_size;
+    h->size = 0;
+    h->n = 0;
+
+    h->array = NULL;
+    h->head = NULL;
+    h->tail = NULL;
+
+    h->left_seed_0 = 0;
+    h->left_seed_1 = 0;
+    h->right_seed_0 = 0;
+    h->right_seed_1 = 0;
+
+    h->engine = engine;
+    h->deleted = 0;
+
+    atomic_init(&h->version, 0);
+    h->concurrent = 0;
+    h->share = NULL;
+
+}
+
 void HashMap_Init(HashMap* h, size_t key_size, size_t value_size) {
-    _HashMap_Init(h, HASHMAP_INITIAL_N, key_size, value_size);
+    HashMap_InitEngine(h, key_size, value_size, HASHMAP_CUCKOO);
+}
+
+void HashMap_SetConcurrent(HashMap* h, bool concurrent) {
+    h->concurrent = concurrent;
+}
+
+//-----------------------------------------------------------------------------
+// Concurrent readers
+//
+// A concurrent map has one writer at a time and any number of readers which
+// take no locks. The writer makes the version odd while it changes the map,
+// and readers retry whenever the version was odd or changed under them.
+// Readers may still be looking at keys, values and tables which the writer
+// has let go of, so those are retired through the epochs rather than freed.
+//-----------------------------------------------------------------------------
+
+static inline void _HashMap_BeginWrite(HashMap* h) {
+    if (!h->concurrent) {return;}
+    atomic_store_explicit(&h->version, atomic_load_explicit(&h->version, memory_order_relaxed) + 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_release);
+}
+
+static inline void _HashMap_EndWrite(HashMap* h) {
+    if (!h->concurrent) {return;}
+    atomic_store_explicit(&h->version, atomic_load_explicit(&h->version, memory_order_relaxed) + 1, memory_order_release);
+}
+
+static inline void _HashMap_Discard(HashMap* h, void* memory) {
+    if (h->concurrent) {Epoch_Retire(memory, 0, NULL);}
+    else {free(memory);}
+}
+
+// Readers load n before the array, and writers store the array before n, so a
+// reader never pairs a table with an n larger than the one it was made for.
+static inline void _HashMap_StoreArray(HashMap* h, KeyValue* array, size_t n) {
+    atomic_store_explicit((KeyValue* _Atomic*) &h->array, array, memory_order_release);
+    atomic_store_explicit((_Atomic size_t*) &h->n, n, memory_order_release);
+}
+
+// Returns the size in bytes the table of a map was allocated with.
+static inline size_t _HashMap_Length(HashMap* h) {
+    if (h->n == 0) {return HASHMAP_SMALL_N * sizeof(KeyValue);}
+    if (h->engine == HASHMAP_SWISS) {return h->n * sizeof(KeyValue) + h->n;}
+    return 2 * h->n * sizeof(KeyValue);
+}
+
+// Returns the value stored in a slot if it holds the key, or NULL.
+static inline void* _HashMap_ConcurrentMatch(HashMap* h, KeyValue* pair, void* key) {
+    void* stored = atomic_load_explicit((void* _Atomic*) &pair->key, memory_order_relaxed);
+    void* value = atomic_load_explicit((void* _Atomic*) &pair->value, memory_order_relaxed);
+    if (stored == NULL || value == NULL || memcmp(key, stored, h->key_size) != 0) {return NULL;}
+    return value;
+}
+
+// Searches a swiss table like _HashMap_SwissFind, reading each group's control bytes with two atomic loads.
+// The table may be one grown after n was loaded, whose control bytes are further on. Those read for n
+// are then some of its slots instead, which only sends the search to slots that are in the table.
+static void* _HashMap_SwissConcurrentFind(HashMap* h, KeyValue* array, size_t n, void* key) {
+
+    uint64_t hash = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1);
+    size_t groups = n / HASHMAP_SWISS_GROUP_N;
+    size_t group = _HashMap_SwissGroup(hash, n);
+    uint8_t* control = _HashMap_Control(array, n);
+
+    for (size_t i = 0; i < groups; i++) {
+
+        size_t start = group * HASHMAP_SWISS_GROUP_N;
+        uint64_t bytes[2];
+        bytes[0] = atomic_load_explicit((_Atomic uint64_t*) (control + start), memory_order_relaxed);
+        bytes[1] = atomic_load_explicit((_Atomic uint64_t*) (control + start + 8), memory_order_relaxed);
+
+        for (uint32_t match = _HashMap_SwissMatch((uint8_t*) bytes, hash & 0x7f); match != 0; match &= match - 1) {
+            void* value = _HashMap_ConcurrentMatch(h, array + start + __builtin_ctz(match), key);
+            if (value != NULL) {return value;}
+        }
+        if (_HashMap_SwissMatch((uint8_t*) bytes, HASHMAP_EMPTY) != 0) {break;}
+        group = (group + 1) & (groups - 1);
+
+    }
+
+    return NULL;
+
+}
+
+static bool _HashMap_ConcurrentGet(HashMap* h, void* key, void* buffer) {
+
+    bool found;
+    Epoch_Enter();
+
+    while (1) {
+
+        uint64_t version = atomic_load_explicit(&h->version, memory_order_acquire);
+        if (version % 2 == 1) {continue;}
+
+        size_t n = atomic_load_explicit((_Atomic size_t*) &h->n, memory_order_acquire);
+        KeyValue* array = atomic_load_explicit((KeyValue* _Atomic*) &h->array, memory_order_acquire);
+        void* value = NULL;
+
+        if (array != NULL && n == 0) {
+            for (int i = 0; i < HASHMAP_SMALL_N && value == NULL; i++) {value = _HashMap_ConcurrentMatch(h, array + i, key);}
+        }
+        else if (array != NULL && h->engine == HASHMAP_SWISS) {
+            value = _HashMap_SwissConcurrentFind(h, array, n, key);
+        }
+        else if (array != NULL) {
+            size_t left = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1) % n;
+            value = _HashMap_ConcurrentMatch(h, array + left, key);
+            if (value == NULL) {value = _HashMap_ConcurrentMatch(h, array + n + _HashMap_RightIndex(h, n, key, left), key);}
+        }
+
+        found = value != NULL;
+        if (found) {memcpy(buffer, value, h->value_size);}
+
+        // If nothing was written meanwhile, what was read is consistent.
+        atomic_thread_fence(memory_order_acquire);
+        if (atomic_load_explicit(&h->version, memory_order_relaxed) == version) {break;}
+
+    }
+
+    Epoch_Exit();
+    return found;
+
+}
+
+// Returns the slot holding the key in a small map, or NULL if it is not there.
+KeyValue* _HashMap_SmallFind(HashMap* h, void* key) {
+
+    if (h->array == NULL) {return NULL;}
+
+    for (int i = 0; i < HASHMAP_SMALL_N; i++) {
+        KeyValue* pair = h->array + i;
+        if (pair->key != NULL && memcmp(key, pair->key, h->key_size) == 0) {return pair;}
+    }
+
+    return NULL;
+
+}
+
+//-----------------------------------------------------------------------------
+// Copy-on-write clones
+//
+// A cloned table is shared by every map holding it, until one of them writes
+// to it and takes a copy of its own. The keys and values are shared apart
+// from the table, a group at a time: each group has a count of the tables
+// holding its pairs, and a table which changes a pair in a shared group first
+// copies the group's pairs. Pairs never leave their group except by growing,
+// so the groups a table owns stay owned. A NULL count means the table owns
+// the group outright, which is always so while only one map holds the table.
+//-----------------------------------------------------------------------------
+
+struct _HashMapShare {
+    atomic_int references;
+    atomic_int* groups[];
+};
+
+static inline size_t _HashMap_Groups(size_t n) {
+    return n / _HashMap_GroupN(n);
+}
+
+// Frees the pairs in a group, from both tables.
+static void _HashMap_FreeGroup(HashMap* h, KeyValue* array, size_t n, size_t group) {
+    size_t start = group * _HashMap_GroupN(n);
+    for (size_t i = start; i < start + _HashMap_GroupN(n); i++) {
+        KeyValue* pairs[2] = {array + i, array + n + i};
+        for (int j = 0; j < 2; j++) {
+            if (pairs[j]->key == NULL) {continue;}
+            _HashMap_Discard(h, pairs[j]->key);
+            _HashMap_Discard(h, pairs[j]->value);
+        }
+    }
+}
+
+// Lets go of a shared table, freeing it along with any groups nothing else holds.
+static void _HashMap_DropTable(HashMap* h, KeyValue* array, size_t n, struct _HashMapShare* share) {
+
+    if (atomic_fetch_sub(&share->references, 1) != 1) {return;}
+
+    for (size_t g = 0; g < _HashMap_Groups(n); g++) {
+        atomic_int* count = share->groups[g];
+        if (count != NULL && atomic_fetch_sub(count, 1) != 1) {continue;}
+        _HashMap_FreeGroup(h, array, n, g);
+        free(count);
+    }
+
+    free(share);
+    if (h->concurrent) {Epoch_Retire(array, 2 * n * sizeof(KeyValue), Pages_Free);}
+    else {Pages_Free(array, 2 * n * sizeof(KeyValue));}
+
+}
+
+// Gives the map a table of its own if it shares one. The copy holds the same pairs, so each group is held once more.
+static void _HashMap_OwnTable(HashMap* h) {
+
+    struct _HashMapShare* share = h->share;
+    if (share == NULL || atomic_load(&share->references) == 1) {return;}
+
+    size_t groups = _HashMap_Groups(h->n);
+    struct _HashMapShare* own = malloc(sizeof(struct _HashMapShare) + groups * sizeof(atomic_int*));
+    atomic_init(&own->references, 1);
+    for (size_t g = 0; g < groups; g++) {
+        own->groups[g] = share->groups[g];
+        atomic_fetch_add(own->groups[g], 1);
+    }
+
+    // The list runs through the table, so its links move over with it.
+    KeyValue* array = Pages_Alloc(2 * h->n * sizeof(KeyValue));
+    memcpy(array, h->array, 2 * h->n * sizeof(KeyValue));
+    for (size_t i = 0; i < 2 * h->n; i++) {
+        if (array[i].key == NULL) {continue;}
+        if (array[i].next != NULL) {array[i].next = array + (array[i].next - h->array);}
+        if (array[i].prev != NULL) {array[i].prev = array + (array[i].prev - h->array);}
+    }
+    h->head = array + (h->head - h->array);
+    h->tail = array + (h->tail - h->array);
+
+    KeyValue* shared = h->array;
+    h->share = own;
+    _HashMap_StoreArray(h, array, h->n);
+    _HashMap_DropTable(h, shared, h->n, share);
+
+}
+
+// Gives the map its own copy of the pairs in a group, once it has a table of its own.
+static void _HashMap_OwnGroup(HashMap* h, size_t group) {
+
+    atomic_int* count = h->share->groups[group];
+    if (count == NULL) {return;}
+    h->share->groups[group] = NULL;
+
+    if (atomic_load(count) == 1) {
+        free(count);
+        return;
+    }
+
+    // Keep the originals until the count says whether anything else still holds them.
+    size_t length = 0;
+    size_t start = group * _HashMap_GroupN(h->n);
+    void** originals = malloc(4 * _HashMap_GroupN(h->n) * sizeof(void*));
+
+    for (size_t i = start; i < start + _HashMap_GroupN(h->n); i++) {
+        KeyValue* pairs[2] = {h->array + i, h->array + h->n + i};
+        for (int j = 0; j < 2; j++) {
+            KeyValue* pair = pairs[j];
+            if (pair->key == NULL) {continue;}
+            void* key = malloc(h->key_size);
+            void* value = malloc(h->value_size);
+            memcpy(key, pair->key, h->key_size);
+            memcpy(value, pair->value, h->value_size);
+            originals[length++] = pair->key;
+            originals[length++] = pair->value;
+            pair->key = key;
+            pair->value = value;
+        }
+    }
+
+    if (atomic_fetch_sub(count, 1) == 1) {
+        for (size_t i = 0; i < length; i++) {_HashMap_Discard(h, originals[i]);}
+        free(count);
+    }
+    free(originals);
+
+}
+
+// Makes the table and the group of a bucket safe to write to.
+static inline void _HashMap_Own(HashMap* h, size_t bucket) {
+    if (h->share == NULL) {return;}
+    _HashMap_OwnTable(h);
+    _HashMap_OwnGroup(h, bucket % h->n / _HashMap_GroupN(h->n));
+}
+
+void HashMap_Clone(HashMap* h, HashMap* clone) {
+
+    // Small maps and swiss maps are copied outright.
+    if (h->n == 0 || h->engine == HASHMAP_SWISS) {
+        HashMap_InitEngine(clone, h->key_size, h->value_size, h->engine);
+        for (KeyValue* pair = h->head; pair != NULL; pair = pair->next) {_HashMap_Put(clone, pair->key, pair->value, 1);}
+        return;
+    }
+
+    size_t groups = _HashMap_Groups(h->n);
+    if (h->share == NULL) {
+        h->share = malloc(sizeof(struct _HashMapShare) + groups * sizeof(atomic_int*));
+        atomic_init(&h->share->references, 1);
+        for (size_t g = 0; g < groups; g++) {h->share->groups[g] = NULL;}
+    }
+
+    // Groups the table owns become shared with itself, so that copies of the table can hold them too.
+    for (size_t g = 0; g < groups; g++) {
+        if (h->share->groups[g] != NULL) {continue;}
+        h->share->groups[g] = malloc(sizeof(atomic_int));
+        atomic_init(h->share->groups[g], 1);
+    }
+
+    atomic_fetch_add(&h->share->references, 1);
+    memcpy(clone, h, sizeof(HashMap));
+    atomic_init(&clone->version, 0);
+    clone->concurrent = 0;
+
 }
 
 int HashMap_Size(HashMap* h) {
@@ -60,10 +502,26 @@ bool HashMap_Get(HashMap* h, void* key, void* buffer) {
 
     // If the buffer is null, we cannot write to it, return 0.
     if (buffer == NULL) {return 0;}
+    if (h->concurrent) {return _HashMap_ConcurrentGet(h, key, buffer);}
 
     KeyValue* pair;
     int computed_hash;
 
+    // Small maps are searched linearly.
+    if (h->n == 0) {
+        pair = _HashMap_SmallFind(h, key);
+        if (pair == NULL) {return 0;}
+        memcpy(buffer, pair->value, h->value_size);
+        return 1;
+    }
+
+    if (h->engine == HASHMAP_SWISS) {
+        size_t slot = _HashMap_SwissFind(h, key, _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1));
+        if (slot == h->n) {return 0;}
+        memcpy(buffer, h->array[slot].value, h->value_size);
+        return 1;
+    }
+
     // Compute left hash
     computed_hash = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;
     pair = h->array + computed_hash;
@@ -75,7 +533,7 @@ bool HashMap_Get(HashMap* h, void* key, void* buffer) {
     }
 
     // Compute right hash
-    computed_hash = _HashMap_Hash(key, h->key_size, h->right_seed_0, h->right_seed_1) % h->n;
+    computed_hash = _HashMap_RightIndex(h, h->n, key, computed_hash);
     pair = h->array + h->n + computed_hash;
 
     // If key is in the right table
@@ -89,6 +547,45 @@ bool HashMap_Get(HashMap* h, void* key, void* buffer) {
 
 }
 
+void* _HashMap_Reference(HashMap* h, void* key) {
+
+    KeyValue* pair;
+    size_t bucket;
+
+    // Small maps are never shared, so their values can be handed out as they are.
+    if (h->n == 0) {
+        pair = _HashMap_SmallFind(h, key);
+        return pair != NULL ? pair->value : NULL;
+    }
+
+    // Swiss maps are never shared either.
+    if (h->engine == HASHMAP_SWISS) {
+        size_t slot = _HashMap_SwissFind(h, key, _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1));
+        return slot < h->n ? h->array[slot].value : NULL;
+    }
+
+    bucket = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;
+    pair = h->array + bucket;
+
+    if (pair->key == NULL || memcmp(key, pair->key, h->key_size) != 0) {
+        bucket = h->n + _HashMap_RightIndex(h, h->n, key, bucket);
+        pair = h->array + bucket;
+        if (pair->key == NULL || memcmp(key, pair->key, h->key_size) != 0) {return NULL;}
+    }
+
+    // The value may be written to, so it must not be shared with a clone.
+    _HashMap_Own(h, bucket);
+    return h->array[bucket].value;
+
+}
+
+void* HashMap_Reference(HashMap* h, void* key) {
+    _HashMap_BeginWrite(h);
+    void* value = _HashMap_Reference(h, key);
+    _HashMap_EndWrite(h);
+    return value;
+}
+
 void _HashMap_PushToList(HashMap* h, KeyValue* pair) {
 
     if (h->tail == NULL) {
@@ -112,7 +609,7 @@ void _HashMap_RemoveFromList(HashMap* h, KeyValue* pair) {
     if (pair->prev == NULL) {
         h->head = pair->next;
         if (pair->next == NULL) {h->tail = NULL;}
-        else {h->head = pair->next;}
+        else {pair->next->prev = NULL;}
     }
 
     else if (pair->next == NULL) {
@@ -127,68 +624,205 @@ void _HashMap_RemoveFromList(HashMap* h, KeyValue* pair) {
 
 }
 
-void _HashMap_SwapInList(HashMap* h, KeyValue* a, KeyValue* b) {
+// Moves a pair's place in the list over to another slot, which is taking over its key.
+void _HashMap_ReplaceInList(HashMap* h, KeyValue* from, KeyValue* to) {
 
-    if (a == b) {return;}
+    to->prev = from->prev;
+    to->next = from->next;
 
-    KeyValue* a_prev = a->prev;
-    KeyValue* a_next = a->next;
-    KeyValue* b_prev = b->prev;
-    KeyValue* b_next = b->next;
+    if (to->prev == NULL) {h->head = to;}
+    else {to->prev->next = to;}
 
-    a->prev = b_prev;
-    a->next = b_next;
-    b->prev = a_prev;
-    b->next = a_next;
+    if (to->next == NULL) {h->tail = to;}
+    else {to->next->prev = to;}
 
-    if (a_prev != NULL) {a_prev->next = b;}
-    if (a_next != NULL) {a_next->prev = b;}
-    if (b_prev != NULL) {b_prev->next = a;}
-    if (b_next != NULL) {b_next->prev = a;}
+}
 
-    if (a->prev == NULL) {h->head = a;}
-    else if (b->prev == NULL) {h->head = b;}
-    
-    if (a->next == NULL) {h->tail = a;}
-    else if (b->next == NULL) {h->tail = b;}
+// Rebuilds the table of a swiss map, or of a small map growing into one, with n slots. The seeds of a
+// swiss map are kept, so every key's group is its old one or the old one plus the old number of groups.
+// Deleted slots are dropped, so a table full of them is rebuilt at the same size.
+static void _HashMap_SwissResize(HashMap* h, size_t n) {
 
-}
+    TRACE_BEGIN(span, TRACE_HASHMAP_GROW, h->n);
 
-void HashMap_Grow(HashMap* h) {
+    if (h->n == 0) {
+        h->left_seed_0 = SEED64();
+        h->left_seed_1 = SEED64();
+    }
 
-    HashMap new_h;
-    _HashMap_Init(&new_h, 2 * h->n, h->key_size, h->value_size);
+    KeyValue* array = Pages_Alloc(n * sizeof(KeyValue) + n);
+    uint8_t* control = _HashMap_Control(array, n);
+    for (size_t i = 0; i < n; i++) {
+        array[i].key = NULL;
+        array[i].value = NULL;
+    }
+    memset(control, HASHMAP_EMPTY, n);
 
-    // Move all key value pairs from the old map to the new one.
+    // The pairs are moved over in list order, relinking the list through their new slots.
     KeyValue* current = h->head;
+    h->head = NULL;
+    h->tail = NULL;
     while (current != NULL) {
-        _HashMap_Put(&new_h, current->key, current->value, 0);
-        current = current->next;
+        KeyValue* next = current->next;
+        uint64_t hash = _HashMap_Hash(current->key, h->key_size, h->left_seed_0, h->left_seed_1);
+        size_t slot = _HashMap_SwissClaim(array, n, hash);
+        control[slot] = hash & 0x7f;
+        array[slot].key = current->key;
+        array[slot].value = current->value;
+        _HashMap_PushToList(h, array + slot);
+        current = next;
     }
 
-    // Free all required memory from the old hashmap
-    free(h->array);
+    KeyValue* old = h->array;
+    size_t length = _HashMap_Length(h);
+    h->deleted = 0;
+    _HashMap_StoreArray(h, array, n);
+
+    if (h->concurrent) {Epoch_Retire(old, length, Pages_Free);}
+    else {Pages_Free(old, length);}
 
-    // Move the new hashmap into the location of the old one.
-    memcpy(h, &new_h, sizeof(HashMap));
+    TRACE_END(span, TRACE_HASHMAP_GROW, hashmap_grow, h, h->size, h->n);
 
 }
 
-bool HashMap_Remove(HashMap* h, void* key) {
+void _HashMap_Grow(HashMap* h) {
+
+    if (h->engine == HASHMAP_SWISS) {
+        _HashMap_SwissResize(h, h->n > 0 ? 2 * h->n : HASHMAP_INITIAL_N);
+        return;
+    }
+
+    TRACE_BEGIN(span, TRACE_HASHMAP_GROW, h->n);
+
+    // The pairs are about to change group, so every one of them must be owned.
+    if (h->share != NULL) {
+        _HashMap_OwnTable(h);
+        for (size_t g = 0; g < _HashMap_Groups(h->n); g++) {_HashMap_OwnGroup(h, g);}
+        free(h->share);
+        h->share = NULL;
+    }
+
+    HashMap new_h;
+    _HashMap_Init(&new_h, h->n > 0 ? 2 * h->n : HASHMAP_INITIAL_N, h->key_size, h->value_size);
+
+    // Small maps have no tables yet, so their pairs are put in the usual way.
+    if (h->n == 0) {
+        KeyValue* current = h->head;
+        while (current != NULL) {
+            _HashMap_Put(&new_h, current->key, current->value, 0);
+            current = current->next;
+        }
+    }
+
+    // Otherwise the seeds are kept and every pair stays in the same table. Its
+    // new bucket is its old one or the old one plus n, so no two pairs collide,
+    // and its new group is one of the two that its old group split into, which
+    // is what lets a scan carry on across a grow.
+    else {
+
+        new_h.left_seed_0 = h->left_seed_0;
+        new_h.left_seed_1 = h->left_seed_1;
+        new_h.right_seed_0 = h->right_seed_0;
+        new_h.right_seed_1 = h->right_seed_1;
+
+        KeyValue* current = h->head;
+        while (current != NULL) {
+            KeyValue* next = current->next;
+            size_t left = _HashMap_Hash(current->key, h->key_size, h->left_seed_0, h->left_seed_1) % new_h.n;
+            KeyValue* pair;
+            if (current < h->array + h->n) {pair = new_h.array + left;}
+            else {pair = new_h.array + new_h.n + _HashMap_RightIndex(&new_h, new_h.n, current->key, left);}
+            pair->key = current->key;
+            pair->value = current->value;
+            _HashMap_PushToList(&new_h, pair);
+            new_h.size++;
+            current = next;
+        }
+
+    }
+
+    KeyValue* array = h->array;
+    size_t length = _HashMap_Length(h);
+
+    // Move the new hashmap into the location of the old one, and free the old table.
+    if (h->concurrent) {
+        h->size = new_h.size;
+        h->head = new_h.head;
+        h->tail = new_h.tail;
+        h->left_seed_0 = new_h.left_seed_0;
+        h->left_seed_1 = new_h.left_seed_1;
+        h->right_seed_0 = new_h.right_seed_0;
+        h->right_seed_1 = new_h.right_seed_1;
+        _HashMap_StoreArray(h, new_h.array, new_h.n);
+        Epoch_Retire(array, length, Pages_Free);
+    } else {
+        memcpy(h, &new_h, sizeof(HashMap));
+        Pages_Free(array, length);
+    }
+
+    TRACE_END(span, TRACE_HASHMAP_GROW, hashmap_grow, h, h->size, h->n);
+
+}
+
+static bool _HashMap_SwissRemove(HashMap* h, void* key) {
+
+    size_t slot = _HashMap_SwissFind(h, key, _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1));
+    if (slot == h->n) {return 0;}
+
+    KeyValue* pair = h->array + slot;
+    _HashMap_Discard(h, pair->key);
+    _HashMap_Discard(h, pair->value);
+    pair->key = NULL;
+    pair->value = NULL;
+    _HashMap_RemoveFromList(h, pair);
+    h->size--;
+
+    // Searches already end at a group with an empty slot, so the slot can only be emptied in one.
+    uint8_t* control = _HashMap_Control(h->array, h->n);
+    if (_HashMap_SwissMatch(control + slot - slot % HASHMAP_SWISS_GROUP_N, HASHMAP_EMPTY) != 0) {control[slot] = HASHMAP_EMPTY;}
+    else {
+        control[slot] = HASHMAP_DELETED;
+        h->deleted++;
+    }
+
+    return 1;
+
+}
+
+bool _HashMap_Remove(HashMap* h, void* key) {
 
     KeyValue* pair;
     int computed_hash;
 
+    // Small maps are searched linearly.
+    if (h->n == 0) {
+        pair = _HashMap_SmallFind(h, key);
+        if (pair == NULL) {return 0;}
+        _HashMap_Discard(h, pair->key);
+        _HashMap_Discard(h, pair->value);
+        pair->key = NULL;
+        pair->value = NULL;
+        _HashMap_RemoveFromList(h, pair);
+        h->size--;
+        return 1;
+    }
+
+    if (h->engine == HASHMAP_SWISS) {return _HashMap_SwissRemove(h, key);}
+
     // Compute left hash
     computed_hash = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;
     pair = h->array + computed_hash;
     
     // If key is in the left table
     if (pair->key != NULL && memcmp(key, pair->key, h->key_size) == 0) {
+
+        // Take a copy of a shared table and group first
+        _HashMap_Own(h, computed_hash);
+        pair = h->array + computed_hash;
         
         // Free the memory allocated to store the key and value
-        free(pair->key);
-        free(pair->value);
+        _HashMap_Discard(h, pair->key);
+        _HashMap_Discard(h, pair->value);
 
         // Set the pointers to null
         pair->key = NULL;
@@ -204,15 +838,19 @@ bool HashMap_Remove(HashMap* h, void* key) {
     }
 
     // Compute right hash
-    computed_hash = _HashMap_Hash(key, h->key_size, h->right_seed_0, h->right_seed_1) % h->n;
+    computed_hash = _HashMap_RightIndex(h, h->n, key, computed_hash);
     pair = h->array + h->n + computed_hash;
 
     // If key is in the right table
     if (pair->key != NULL && memcmp(key, pair->key, h->key_size) == 0) {
+
+        // Take a copy of a shared table and group first
+        _HashMap_Own(h, computed_hash);
+        pair = h->array + h->n + computed_hash;
         
         // Free the memory allocated to store the key and value
-        free(pair->key);
-        free(pair->value);
+        _HashMap_Discard(h, pair->key);
+        _HashMap_Discard(h, pair->value);
 
         // Set the pointers to null
         pair->key = NULL;
@@ -259,7 +897,6 @@ bool _HashMap_TryPut(HashMap* h, KeyValue* pair, void* key, void* value, bool al
     if (pair->key != NULL && memcmp(key, pair->key, h->key_size) == 0) { 
         
         if (allocate) {
-            pair->value = malloc(h->value_size);
             memcpy(pair->value, value, h->value_size);
         } else {
             pair->value = value;
@@ -271,56 +908,66 @@ bool _HashMap_TryPut(HashMap* h, KeyValue* pair, void* key, void* value, bool al
     return 0;
 }
 
-bool _HashMap_Evict(HashMap* h, KeyValue* displaced, KeyValue* target, KeyValue* refuge, bool allocate) {
-    
-    void* tmp_key; 
-    void* tmp_value; 
-    bool exit_flag = 0;
-    
-    if (refuge->key == NULL) {
-        
-        if (allocate) {
-            tmp_key = malloc(h->key_size);
-            tmp_value = malloc(h->value_size);
-            memcpy(tmp_key, displaced->key, h->key_size);
-            memcpy(tmp_value, displaced->value, h->value_size);
-            displaced->key = tmp_key;
-            displaced->value = tmp_value;
+// Walks the eviction path from an occupied slot until an empty slot is found,
+// pushing each occupant to its alternative slot in the other table.
+// Returns 1 once the starting slot is empty, or 0 if the path was too long.
+bool _HashMap_Evict(HashMap* h, KeyValue* start) {
+
+    KeyValue* path[HASHMAP_MAX_EVICTIONS + 1];
+    path[0] = start;
+    TRACE_BEGIN(span, TRACE_HASHMAP_EVICTIONS, h->n);
+
+    for (int i = 0; i < HASHMAP_MAX_EVICTIONS; i++) {
+
+        KeyValue* current = path[i];
+        KeyValue* next;
+        if (current < h->array + h->n) {next = h->array + h->n + _HashMap_RightIndex(h, h->n, current->key, current - h->array);}
+        else {next = h->array + _HashMap_Hash(current->key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;}
+        path[i+1] = next;
+
+        if (next->key != NULL) {continue;}
+
+        // Shift every pair one step along the path, starting from the empty end.
+        // The slots take over the list position of the pair they receive.
+        for (int j = i + 1; j > 0; j--) {
+            path[j]->key = path[j-1]->key;
+            path[j]->value = path[j-1]->value;
+            _HashMap_ReplaceInList(h, path[j-1], path[j]);
         }
 
-        // Add the refuge pair to the linked list
-        _HashMap_PushToList(h, refuge);
-        exit_flag = 1;
+        start->key = NULL;
+        start->value = NULL;
+        if (i + 1 >= TRACE_EVICTION_LENGTH) {TRACE_END(span, TRACE_HASHMAP_EVICTIONS, hashmap_evictions, h, i + 1, 1);}
+        return 1;
 
     }
 
-    // If we cant exit, store the refuge pair in a temporary buffer
-    if (exit_flag == 0) {
-        tmp_key = refuge->key;
-        tmp_value = refuge->value;
-    }
+    TRACE_END(span, TRACE_HASHMAP_EVICTIONS, hashmap_evictions, h, HASHMAP_MAX_EVICTIONS, 0);
+    return 0;
 
-    // Move the target into the refuge
-    refuge->key = target->key;
-    refuge->value = target->value;
+}
 
-    // Move the displaced into the target
-    target->key = displaced->key;
-    target->value = displaced->value;
+static void _HashMap_SwissPut(HashMap* h, void* key, void* value, bool allocate) {
 
-    // Swap the order of the nodes in the linked list
-    _HashMap_SwapInList(h, target, refuge);
+    uint64_t hash = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1);
+    size_t slot = _HashMap_SwissFind(h, key, hash);
+    if (slot < h->n) {
+        _HashMap_TryPut(h, h->array + slot, key, value, allocate);
+        return;
+    }
 
-    // We have found a successful home, for everybody :)
-    if (exit_flag == 1) {
-        h->size++;
-        return 1;
+    // Deleted slots lengthen searches as much as full ones, so they count towards the 7/8 load factor.
+    // Once they make up most of it, the table is rebuilt at the same size rather than grown.
+    if (8 * (h->size + h->deleted + 1) > 7 * h->n) {
+        _HashMap_SwissResize(h, 16 * (h->size + 1) > 7 * h->n ? 2 * h->n : h->n);
     }
 
-    // Refuge pair is now homeless :(
-    displaced->key = tmp_key;
-    displaced->value = tmp_value;
-    return 0;
+    slot = _HashMap_SwissClaim(h->array, h->n, hash);
+    uint8_t* control = _HashMap_Control(h->array, h->n);
+    if (control[slot] == HASHMAP_DELETED) {h->deleted--;}
+    _HashMap_TryPut(h, h->array + slot, key, value, allocate);
+    control[slot] = hash & 0x7f;
+
 }
 
 void _HashMap_Put(HashMap* h, void* key, void* value, bool allocate) {
@@ -330,75 +977,394 @@ void _HashMap_Put(HashMap* h, void* key, void* value, bool allocate) {
     int left_hash;
     int right_hash;
 
+    // Small maps update the key in place, or take the first free slot until there are none left.
+    if (h->n == 0) {
+
+        if (h->array == NULL) {
+            KeyValue* array = malloc(HASHMAP_SMALL_N * sizeof(KeyValue));
+            for (int i = 0; i < HASHMAP_SMALL_N; i++) {
+                array[i].key = NULL;
+                array[i].value = NULL;
+            }
+            _HashMap_StoreArray(h, array, 0);
+        }
+
+        KeyValue* pair = _HashMap_SmallFind(h, key);
+        if (pair != NULL) {
+            _HashMap_TryPut(h, pair, key, value, allocate);
+            return;
+        }
+
+        for (int i = 0; i < HASHMAP_SMALL_N; i++) {
+            if (h->array[i].key == NULL) {
+                _HashMap_TryPut(h, h->array + i, key, value, allocate);
+                return;
+            }
+        }
+
+        _HashMap_Grow(h);
+
+    }
+
+    if (h->engine == HASHMAP_SWISS) {
+        _HashMap_SwissPut(h, key, value, allocate);
+        return;
+    }
+
     // If the load factor exceeds 0.5, rebuild the table to improve performance
-    if (h->size > h->n / 2) {HashMap_Grow(h);}
+    if (h->size > h->n / 2) {_HashMap_Grow(h);}
 
-    // Try and put the key, value pair in the left spot.
     left_hash = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;
+    _HashMap_Own(h, left_hash);
     left_pair = h->array + left_hash;
-    if (_HashMap_TryPut(h, left_pair, key, value, allocate)) {return;}
-
-    // Try and put the key, value pair in the right spot.
-    right_hash = _HashMap_Hash(key, h->key_size, h->right_seed_0, h->right_seed_1) % h->n;
+    right_hash = _HashMap_RightIndex(h, h->n, key, left_hash);
     right_pair = h->array + h->n + right_hash;
+
+    // If the key is already stored in either spot, update its value there.
+    // This must come first, as the key may sit in the right spot while the left one is empty.
+    if (left_pair->key != NULL && _HashMap_TryPut(h, left_pair, key, value, allocate)) {return;}
+    if (right_pair->key != NULL && _HashMap_TryPut(h, right_pair, key, value, allocate)) {return;}
+
+    // Otherwise try and put the key, value pair in an empty spot.
+    if (_HashMap_TryPut(h, left_pair, key, value, allocate)) {return;}
     if (_HashMap_TryPut(h, right_pair, key, value, allocate)) {return;}
 
-    // Start an eviction sequence
-    KeyValue new_pair = {key, value};
-    KeyValue* displaced_pair = &new_pair;
+    // Free one of the two slots by pushing its occupants along. A cycle traps
+    // the walk from one side, but can often be escaped from the other.
+    if (_HashMap_Evict(h, left_pair)) {
+        _HashMap_TryPut(h, left_pair, key, value, allocate);
+        return;
+    }
+    if (_HashMap_Evict(h, right_pair)) {
+        _HashMap_TryPut(h, right_pair, key, value, allocate);
+        return;
+    }
+
+    // Both eviction paths are too long.
+    // We must rebuild the entire hash table.
+    TRACE_BEGIN(span, TRACE_HASHMAP_REHASH, h->n);
+    _HashMap_Grow(h);
+    TRACE_END(span, TRACE_HASHMAP_REHASH, hashmap_rehash, h, h->size, h->n);
 
-    for (int i = 0; i < 2*h->n; i++) {
+    // Move the displaced pair into the new one.
+    _HashMap_Put(h, key, value, allocate);
 
-        // If i is even, try and place it in the left table.
-        if (i % 2 == 0) {
+}
 
-            // Compute right hash of the left pair
-            right_hash = _HashMap_Hash(left_pair->key, h->key_size, h->right_seed_0, h->right_seed_1) % h->n;
-            right_pair = h->array + h->n + right_hash;
-            
-            // Evict the left pair. If it is resolved, then return.
-            if (_HashMap_Evict(h, displaced_pair, left_pair, right_pair, allocate)) {return;}
+void HashMap_Put(HashMap* h, void* key, void* value) {
+    _HashMap_BeginWrite(h);
+    _HashMap_Put(h, key, value, 1);
+    _HashMap_EndWrite(h);
+}
 
+bool HashMap_Remove(HashMap* h, void* key) {
+    _HashMap_BeginWrite(h);
+    bool removed = _HashMap_Remove(h, key);
+    _HashMap_EndWrite(h);
+    return removed;
+}
+
+void HashMap_Grow(HashMap* h) {
+    _HashMap_BeginWrite(h);
+    _HashMap_Grow(h);
+    _HashMap_EndWrite(h);
+}
+
+// Bulk construction works on record indices rather than key/value pairs.
+// The expensive parts, hashing every key and copying every pair into the
+// table, are split into runs over the thread pool. Placement is a cuckoo
+// insertion of indices into an int table using the precomputed hashes, which
+// never touches the keys except to spot duplicates.
+struct _HashMapBuild {
+    HashMap* h;
+    uint8_t* keys;
+    uint8_t* values;
+    int count;
+    int tasks;
+    size_t* left;
+    size_t* right;
+    int* slots;
+    int* winners;
+};
+
+static inline size_t _HashMap_RunStart(size_t length, int tasks, int index) {
+    return length * index / tasks;
+}
+
+void _HashMap_BuildHash(int index, void* arg) {
+
+    struct _HashMapBuild* b = arg;
+    HashMap* h = b->h;
+    size_t end = _HashMap_RunStart(b->count, b->tasks, index + 1);
+
+    for (size_t i = _HashMap_RunStart(b->count, b->tasks, index); i < end; i++) {
+        uint8_t* key = b->keys + i * h->key_size;
+        b->left[i] = _HashMap_Hash(key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;
+        b->right[i] = _HashMap_RightIndex(h, h->n, key, b->left[i]);
+        b->winners[i] = i;
+    }
+
+    end = _HashMap_RunStart(2 * h->n, b->tasks, index + 1);
+    for (size_t i = _HashMap_RunStart(2 * h->n, b->tasks, index); i < end; i++) {
+        b->slots[i] = -1;
+    }
+
+}
+
+// Places every record, returning 0 if an eviction sequence ran too long.
+bool _HashMap_BuildPlace(struct _HashMapBuild* b) {
+
+    HashMap* h = b->h;
+
+    for (int i = 0; i < b->count; i++) {
+
+        size_t left = b->left[i];
+        size_t right = h->n + b->right[i];
+
+        // A repeated key can only be in one of its own two slots.
+        int other = b->slots[left] >= 0 ? b->slots[left] : -1;
+        if (other < 0 || memcmp(b->keys + (size_t) other * h->key_size, b->keys + (size_t) i * h->key_size, h->key_size) != 0) {
+            other = b->slots[right];
+            if (other >= 0 && memcmp(b->keys + (size_t) other * h->key_size, b->keys + (size_t) i * h->key_size, h->key_size) != 0) {other = -1;}
+        }
+        if (other >= 0) {
+            b->winners[other] = i;
+            b->left[i] = SIZE_MAX;
+            continue;
         }
 
-        // Try and place it in the right table.
-        else {
+        if (b->slots[left] < 0) {
+            b->slots[left] = i;
+            continue;
+        }
 
-            // Compute left hash of the right pair
-            left_hash = _HashMap_Hash(right_pair->key, h->key_size, h->left_seed_0, h->left_seed_1) % h->n;
-            left_pair = h->array + left_hash;
-            
-            // Evict the right pair. If it is resolved, then return.
-            if (_HashMap_Evict(h, displaced_pair, right_pair, left_pair, allocate)) {return;}
+        if (b->slots[right] < 0) {
+            b->slots[right] = i;
+            continue;
+        }
 
+        // Push the record into its left slot, and keep moving whoever was there to their other slot.
+        int record = i;
+        bool is_left = 1;
+        int evictions = 0;
+        while (record >= 0) {
+            if (evictions++ == HASHMAP_BUILD_EVICTIONS) {return 0;}
+            size_t slot = is_left ? b->left[record] : h->n + b->right[record];
+            int displaced = b->slots[slot];
+            b->slots[slot] = record;
+            record = displaced;
+            is_left = !is_left;
         }
 
-    }   
+    }
 
-    // If the eviction sequence is greater than 2n, then there is a cycle.
-    // We must rebuild the entire hash table.
-    HashMap_Grow(h);
+    return 1;
 
-    // Move the displaced pair into the new one.
-    _HashMap_Put(h, key, value, allocate);
+}
+
+void _HashMap_BuildFill(int index, void* arg) {
+
+    struct _HashMapBuild* b = arg;
+    HashMap* h = b->h;
+    size_t end = _HashMap_RunStart(2 * h->n, b->tasks, index + 1);
+
+    for (size_t i = _HashMap_RunStart(2 * h->n, b->tasks, index); i < end; i++) {
+
+        int record = b->slots[i];
+        if (record < 0) {
+            h->array[i].key = NULL;
+            h->array[i].value = NULL;
+            continue;
+        }
+
+        h->array[i].key = malloc(h->key_size);
+        h->array[i].value = malloc(h->value_size);
+        memcpy(h->array[i].key, b->keys + (size_t) record * h->key_size, h->key_size);
+        memcpy(h->array[i].value, b->values + (size_t) b->winners[record] * h->value_size, h->value_size);
+
+        // From here on the left hash is no longer needed, so it remembers where the record went.
+        b->left[record] = i;
+
+    }
 
 }
 
-void HashMap_Put(HashMap* h, void* key, void* value) {
-    _HashMap_Put(h, key, value, 1);
+void HashMap_BuildFrom(HashMap* h, size_t key_size, size_t value_size, void* keys, void* values, int count, int threads) {
+
+    // Size the table so the load factor stays at most 0.5, as HashMap_Put would leave it.
+    size_t n = HASHMAP_INITIAL_N;
+    while ((size_t) count > n / 2) {n *= 2;}
+
+    struct _HashMapBuild b;
+    b.h = h;
+    b.keys = keys;
+    b.values = values;
+    b.count = count > 0 ? count : 0;
+    b.tasks = threads > 0 ? threads : ThreadPool_Threads();
+    b.left = malloc((b.count > 0 ? b.count : 1) * sizeof(size_t));
+    b.right = malloc((b.count > 0 ? b.count : 1) * sizeof(size_t));
+    b.winners = malloc((b.count > 0 ? b.count : 1) * sizeof(int));
+    b.slots = NULL;
+
+    // Hash and place, with new seeds and eventually a larger table if placement gets stuck.
+    for (int attempt = 0; ; attempt++) {
+
+        if (attempt > 0 && attempt % HASHMAP_BUILD_ATTEMPTS == 0) {n *= 2;}
+
+        h->key_size = key_size;
+        h->value_size = value_size;
+        h->n = n;
+        h->left_seed_0 = SEED64();
+        h->left_seed_1 = SEED64();
+        h->right_seed_0 = SEED64();
+        h->right_seed_1 = SEED64();
+
+        b.slots = realloc(b.slots, 2 * n * sizeof(int));
+        ThreadPool_ParallelFor(b.tasks, _HashMap_BuildHash, &b);
+        if (_HashMap_BuildPlace(&b)) {break;}
+
+    }
+
+    h->array = Pages_Alloc(2 * n * sizeof(KeyValue));
+    ThreadPool_ParallelFor(b.tasks, _HashMap_BuildFill, &b);
+
+    h->engine = HASHMAP_CUCKOO;
+    h->deleted = 0;
+    atomic_init(&h->version, 0);
+    h->concurrent = 0;
+    h->share = NULL;
+
+    // Link the pairs in the order their keys first appeared.
+    h->size = 0;
+    h->head = NULL;
+    h->tail = NULL;
+    for (int i = 0; i < b.count; i++) {
+        if (b.left[i] == SIZE_MAX) {continue;}
+        _HashMap_PushToList(h, h->array + b.left[i]);
+        h->size++;
+    }
+
+    free(b.left);
+    free(b.right);
+    free(b.winners);
+    free(b.slots);
+
+}
+
+static inline uint64_t _HashMap_Reverse(uint64_t v) {
+    v = ((v >> 1) & 0x5555555555555555ULL) | ((v & 0x5555555555555555ULL) << 1);
+    v = ((v >> 2) & 0x3333333333333333ULL) | ((v & 0x3333333333333333ULL) << 2);
+    v = ((v >> 4) & 0x0f0f0f0f0f0f0f0fULL) | ((v & 0x0f0f0f0f0f0f0f0fULL) << 4);
+    v = ((v >> 8) & 0x00ff00ff00ff00ffULL) | ((v & 0x00ff00ff00ff00ffULL) << 8);
+    v = ((v >> 16) & 0x0000ffff0000ffffULL) | ((v & 0x0000ffff0000ffffULL) << 16);
+    return (v >> 32) | (v << 32);
+}
+
+static inline void _HashMap_ScanPair(KeyValue* pair, List* keys, List* values) {
+    if (keys != NULL) {List_Push(keys, pair->key);}
+    if (values != NULL) {List_Push(values, pair->value);}
+}
+
+// Sets the bits above the mask so the carry runs straight through them.
+static inline uint64_t _HashMap_ScanNext(uint64_t cursor, uint64_t mask) {
+    cursor |= ~mask;
+    cursor = _HashMap_Reverse(cursor);
+    cursor++;
+    return _HashMap_Reverse(cursor);
+}
+
+// A swiss group is visited by following the search of its keys, to the first group with an empty slot,
+// and taking the keys along the way whose own group it is. A grow splits a group in two as the cuckoo
+// tables do, and so does a rebuild at the same size, in that it keeps every key in its own group.
+static uint64_t _HashMap_SwissScan(HashMap* h, uint64_t cursor, int count, List* keys, List* values) {
+
+    size_t groups = h->n / HASHMAP_SWISS_GROUP_N;
+    uint64_t mask = groups - 1;
+    uint8_t* control = _HashMap_Control(h->array, h->n);
+    int found = 0;
+
+    do {
+
+        size_t own = cursor & mask;
+        size_t group = own;
+        for (size_t i = 0; i < groups; i++) {
+            size_t start = group * HASHMAP_SWISS_GROUP_N;
+            for (uint32_t full = ~_HashMap_SwissVacant(control + start) & 0xffff; full != 0; full &= full - 1) {
+                KeyValue* pair = h->array + start + __builtin_ctz(full);
+                uint64_t hash = _HashMap_Hash(pair->key, h->key_size, h->left_seed_0, h->left_seed_1);
+                if (_HashMap_SwissGroup(hash, h->n) != own) {continue;}
+                _HashMap_ScanPair(pair, keys, values);
+                found++;
+            }
+            if (_HashMap_SwissMatch(control + start, HASHMAP_EMPTY) != 0) {break;}
+            group = (group + 1) & mask;
+        }
+
+        cursor = _HashMap_ScanNext(cursor, mask);
+
+    } while (cursor != 0 && found < count);
+
+    return cursor;
+
+}
+
+// The cursor is a group index counted with its bits reversed, as in the Redis
+// SCAN command. A grow splits group g into g and g + groups, and counting on
+// the high bits first means both halves of every group already visited come
+// before the cursor in the larger map, so nothing is skipped.
+uint64_t HashMap_Scan(HashMap* h, uint64_t cursor, int count, List* keys, List* values) {
+
+    // Small maps are returned whole.
+    if (h->n == 0) {
+        for (KeyValue* pair = h->head; pair != NULL; pair = pair->next) {_HashMap_ScanPair(pair, keys, values);}
+        return 0;
+    }
+
+    if (h->engine == HASHMAP_SWISS) {return _HashMap_SwissScan(h, cursor, count, keys, values);}
+
+    size_t group = _HashMap_GroupN(h->n);
+    uint64_t mask = h->n / group - 1;
+    int found = 0;
+
+    do {
+
+        // Both slots of every key in the group are here, so the group is visited as one.
+        size_t start = (cursor & mask) * group;
+        for (size_t i = start; i < start + group; i++) {
+            KeyValue* left = h->array + i;
+            KeyValue* right = h->array + h->n + i;
+            if (left->key != NULL) {_HashMap_ScanPair(left, keys, values); found++;}
+            if (right->key != NULL) {_HashMap_ScanPair(right, keys, values); found++;}
+        }
+
+        cursor = _HashMap_ScanNext(cursor, mask);
+
+    } while (cursor != 0 && found < count);
+
+    return cursor;
+
 }
 
 void HashMap_Clear(HashMap* h) {
     size_t key_size = h->key_size;
     size_t value_size = h->value_size;
+    HashMapEngine engine = h->engine;
     HashMap_Free(h);
-    HashMap_Init(h, key_size, value_size);
+    HashMap_InitEngine(h, key_size, value_size, engine);
 }
 
 void HashMap_Free(HashMap* h) {
 
+    if (h->share != NULL) {
+        _HashMap_DropTable(h, h->array, h->n, h->share);
+        return;
+    }
+
+    // Small maps only have their HASHMAP_SMALL_N slots, if any, and swiss maps their n slots.
+    size_t slots = h->n > 0 ? (h->engine == HASHMAP_SWISS ? h->n : 2 * h->n) : (h->array != NULL ? HASHMAP_SMALL_N : 0);
+
     KeyValue* pair;
-    for (int i = 0; i < 2 * h->n; i++) {
+    for (int i = 0; i < slots; i++) {
         
         pair = h->array + i;
         if (pair->key != NULL) {free(pair->key);}
@@ -406,5 +1372,5 @@ void HashMap_Free(HashMap* h) {
 
     }
 
-    free(h->array);
+    Pages_Free(h->array, h->array != NULL ? _HashMap_Length(h) : 0);
 }
\ No newline at end of file
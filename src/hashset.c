@@ -0,0 +1,283 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "hash.h"
+#include "hashset.h"
+
+#define HASHSET_INITIAL_N 16
+#define HASHSET_MAX_EVICTIONS 128
+
+void _HashSet_Add(HashSet* s, void* key, bool allocate);
+
+static inline SetKey* _HashSet_Left(HashSet* s, const void* key) {
+    return s->array + SIP64((uint8_t*)key, s->key_size, s->left_seed_0, s->left_seed_1) % s->n;
+}
+
+static inline SetKey* _HashSet_Right(HashSet* s, const void* key) {
+    return s->array + s->n + SIP64((uint8_t*)key, s->key_size, s->right_seed_0, s->right_seed_1) % s->n;
+}
+
+void _HashSet_Init(HashSet* s, size_t n, size_t key_size) {
+
+    s->key_size = key_size;
+    s->size = 0;
+    s->n = n;
+
+    s->array = malloc(2 * n * sizeof(SetKey));
+    s->head = NULL;
+    s->tail = NULL;
+
+    s->left_seed_0 = SEED64();
+    s->left_seed_1 = SEED64();
+    s->right_seed_0 = SEED64();
+    s->right_seed_1 = SEED64();
+
+    for (size_t i = 0; i < 2 * n; i++) {
+        s->array[i].key = NULL;
+    }
+
+}
+
+void HashSet_Init(HashSet* s, size_t key_size) {
+    _HashSet_Init(s, HASHSET_INITIAL_N, key_size);
+}
+
+int HashSet_Size(HashSet* s) {
+    return s->size;
+}
+
+SetKey* HashSet_Elements(HashSet* s) {
+    return s->head;
+}
+
+SetKey* _HashSet_Find(HashSet* s, const void* key) {
+
+    SetKey* slot = _HashSet_Left(s, key);
+    if (slot->key != NULL && memcmp(key, slot->key, s->key_size) == 0) {return slot;}
+
+    slot = _HashSet_Right(s, key);
+    if (slot->key != NULL && memcmp(key, slot->key, s->key_size) == 0) {return slot;}
+
+    return NULL;
+
+}
+
+bool HashSet_Contains(HashSet* s, void* key) {
+    return _HashSet_Find(s, key) != NULL;
+}
+
+int HashSet_ContainsMany(HashSet* s, void* keys, int count, bool* results) {
+
+    int found = 0;
+    uint8_t* key = keys;
+
+    for (int i = 0; i < count; i++) {
+        bool result = _HashSet_Find(s, key) != NULL;
+        if (results != NULL) {results[i] = result;}
+        found += result;
+        key += s->key_size;
+    }
+
+    return found;
+
+}
+
+void _HashSet_PushToList(HashSet* s, SetKey* slot) {
+
+    slot->next = NULL;
+    slot->prev = s->tail;
+
+    if (s->tail == NULL) {s->head = slot;}
+    else {s->tail->next = slot;}
+    s->tail = slot;
+
+}
+
+void _HashSet_RemoveFromList(HashSet* s, SetKey* slot) {
+
+    if (slot->prev == NULL) {s->head = slot->next;}
+    else {slot->prev->next = slot->next;}
+
+    if (slot->next == NULL) {s->tail = slot->prev;}
+    else {slot->next->prev = slot->prev;}
+
+}
+
+void _HashSet_ReplaceInList(HashSet* s, SetKey* from, SetKey* to) {
+
+    to->prev = from->prev;
+    to->next = from->next;
+
+    if (to->prev == NULL) {s->head = to;}
+    else {to->prev->next = to;}
+
+    if (to->next == NULL) {s->tail = to;}
+    else {to->next->prev = to;}
+
+}
+
+void HashSet_Grow(HashSet* s) {
+
+    HashSet new_s;
+    _HashSet_Init(&new_s, 2 * s->n, s->key_size);
+
+    // Move all keys from the old set to the new one, keeping their order.
+    SetKey* current = s->head;
+    while (current != NULL) {
+        _HashSet_Add(&new_s, current->key, 0);
+        current = current->next;
+    }
+
+    // Free the old table and move the new set into its place.
+    free(s->array);
+    memcpy(s, &new_s, sizeof(HashSet));
+
+}
+
+void _HashSet_RemoveSlot(HashSet* s, SetKey* slot) {
+    free(slot->key);
+    slot->key = NULL;
+    _HashSet_RemoveFromList(s, slot);
+    s->size--;
+}
+
+bool HashSet_Remove(HashSet* s, void* key) {
+    SetKey* slot = _HashSet_Find(s, key);
+    if (slot == NULL) {return 0;}
+    _HashSet_RemoveSlot(s, slot);
+    return 1;
+}
+
+void _HashSet_Place(HashSet* s, SetKey* slot, void* key, bool allocate) {
+
+    if (allocate) {
+        slot->key = malloc(s->key_size);
+        memcpy(slot->key, key, s->key_size);
+    } else {
+        slot->key = key;
+    }
+
+    _HashSet_PushToList(s, slot);
+    s->size++;
+
+}
+
+void _HashSet_Add(HashSet* s, void* key, bool allocate) {
+
+    // If the load factor exceeds 0.5, rebuild the table to improve performance
+    if (s->size > s->n / 2) {HashSet_Grow(s);}
+
+    SetKey* left = _HashSet_Left(s, key);
+    SetKey* right = _HashSet_Right(s, key);
+
+    // Nothing to do if the key is already stored.
+    if (left->key != NULL && memcmp(key, left->key, s->key_size) == 0) {return;}
+    if (right->key != NULL && memcmp(key, right->key, s->key_size) == 0) {return;}
+
+    if (left->key == NULL) {_HashSet_Place(s, left, key, allocate); return;}
+    if (right->key == NULL) {_HashSet_Place(s, right, key, allocate); return;}
+
+    // Walk the eviction path from the left slot until an empty slot is found.
+    // Each occupant is pushed to its alternative slot in the other table.
+    SetKey* path[HASHSET_MAX_EVICTIONS + 1];
+    path[0] = left;
+
+    for (int i = 0; i < HASHSET_MAX_EVICTIONS; i++) {
+
+        SetKey* current = path[i];
+        SetKey* next = (current < s->array + s->n) ? _HashSet_Right(s, current->key) : _HashSet_Left(s, current->key);
+        path[i+1] = next;
+
+        if (next->key != NULL) {continue;}
+
+        // Shift every key one step along the path, starting from the empty end.
+        // The slots take over the list position of the key they receive.
+        for (int j = i + 1; j > 0; j--) {
+            path[j]->key = path[j-1]->key;
+            _HashSet_ReplaceInList(s, path[j-1], path[j]);
+        }
+
+        _HashSet_Place(s, path[0], key, allocate);
+        return;
+
+    }
+
+    // The eviction path is too long, most likely a cycle.
+    // We must rebuild the entire hash table.
+    HashSet_Grow(s);
+    _HashSet_Add(s, key, allocate);
+
+}
+
+void HashSet_Add(HashSet* s, void* key) {
+    _HashSet_Add(s, key, 1);
+}
+
+void HashSet_Union(HashSet* s, HashSet* other) {
+
+    if (s == other) {return;}
+
+    SetKey* current = other->head;
+    while (current != NULL) {
+        _HashSet_Add(s, current->key, 1);
+        current = current->next;
+    }
+
+}
+
+void HashSet_Intersection(HashSet* s, HashSet* other) {
+
+    if (s == other) {return;}
+
+    SetKey* current = s->head;
+    while (current != NULL) {
+        SetKey* next = current->next;
+        if (_HashSet_Find(other, current->key) == NULL) {_HashSet_RemoveSlot(s, current);}
+        current = next;
+    }
+
+}
+
+void HashSet_Difference(HashSet* s, HashSet* other) {
+
+    if (s == other) {
+        HashSet_Clear(s);
+        return;
+    }
+
+    // Walk whichever set is smaller.
+    if (s->size <= other->size) {
+        SetKey* current = s->head;
+        while (current != NULL) {
+            SetKey* next = current->next;
+            if (_HashSet_Find(other, current->key) != NULL) {_HashSet_RemoveSlot(s, current);}
+            current = next;
+        }
+    }
+
+    else {
+        SetKey* current = other->head;
+        while (current != NULL) {
+            SetKey* slot = _HashSet_Find(s, current->key);
+            if (slot != NULL) {_HashSet_RemoveSlot(s, slot);}
+            current = current->next;
+        }
+    }
+
+}
+
+void HashSet_Clear(HashSet* s) {
+    size_t key_size = s->key_size;
+    HashSet_Free(s);
+    HashSet_Init(s, key_size);
+}
+
+void HashSet_Free(HashSet* s) {
+
+    for (size_t i = 0; i < 2 * s->n; i++) {
+        if (s->array[i].key != NULL) {free(s->array[i].key);}
+    }
+
+    free(s->array);
+}
@@ -1,14 +1,177 @@
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
+#include <stdatomic.h>
 #include "list.h"
+#include "threadpool.h"
+#include "pages.h"
+#include "trace.h"
 
-#define INITIAL_LIST_SIZE 16
+#define INITIAL_LIST_SIZE 4
+#define LIST_PARALLEL_LENGTH 8192
+#define LIST_INSERTION_LENGTH 32
+#define LIST_CHUNK_LENGTH 1024
 
+// The pointer array is not allocated until the first element is added, so
+// empty lists cost nothing to create or free.
 void List_Init(List* l, size_t element_size) {
-    l->elements = malloc(INITIAL_LIST_SIZE * sizeof(void*));
+    l->elements = NULL;
     l->element_size = element_size;
-    l->size = INITIAL_LIST_SIZE;
+    l->size = 0;
     l->length = 0;
+    l->share = NULL;
+}
+
+// Makes room for at least length element pointers, doubling the capacity as needed.
+void _List_Reserve(List* l, int length) {
+    if (length <= l->size) return;
+    int size = l->size > 0 ? l->size : INITIAL_LIST_SIZE;
+    while (size < length) size = size * 2;
+    TRACE_BEGIN(span, TRACE_LIST_REALLOC, l->size);
+    l->elements = Pages_Realloc(l->elements, l->size * sizeof(void*), size * sizeof(void*));
+    l->size = size;
+    TRACE_END(span, TRACE_LIST_REALLOC, list_realloc, l, l->length, l->size);
+}
+
+// Moves count element pointers from one index to another, tracing large moves.
+static inline void _List_Move(List* l, int to, int from, int count) {
+    size_t bytes = count * sizeof(void*);
+    TRACE_BEGIN(span, TRACE_LIST_MEMMOVE, from);
+    memmove(l->elements + to, l->elements + from, bytes);
+    if (bytes >= TRACE_MEMMOVE_BYTES) TRACE_END(span, TRACE_LIST_MEMMOVE, list_memmove, l, bytes, to);
+}
+
+//-----------------------------------------------------------------------------
+// Copy-on-write clones
+//
+// A cloned pointer array is shared by every list holding it, until one of
+// them changes and takes a copy of its own. The elements are shared apart
+// from the array, a chunk of LIST_CHUNK_LENGTH indices at a time: each chunk
+// has a count of the arrays holding its elements, and a list which adds,
+// removes or moves an element of a shared chunk first copies the chunk's
+// elements. Chunks past the last count, or with a NULL count, are owned
+// outright. The length never moves into or out of a shared chunk without it
+// being copied, so its elements are always those at its indices below the
+// length.
+//-----------------------------------------------------------------------------
+
+struct _ListShare {
+    atomic_int references;
+    int chunks;
+    atomic_int* counts[];
+};
+
+static inline int _List_ChunkEnd(List* l, int chunk) {
+    int end = (chunk + 1) * LIST_CHUNK_LENGTH;
+    return end < l->length ? end : l->length;
+}
+
+// Lets go of a shared pointer array, freeing it along with any elements nothing else holds.
+static void _List_DropArray(List* l, void** elements, struct _ListShare* share) {
+
+    if (atomic_fetch_sub(&share->references, 1) != 1) return;
+
+    for (int c = 0; c * LIST_CHUNK_LENGTH < l->length; c++) {
+        atomic_int* count = c < share->chunks ? share->counts[c] : NULL;
+        if (count != NULL && atomic_fetch_sub(count, 1) != 1) continue;
+        for (int i = c * LIST_CHUNK_LENGTH; i < _List_ChunkEnd(l, c); i++) free(elements[i]);
+        free(count);
+    }
+
+    free(share);
+    Pages_Free(elements, l->size * sizeof(void*));
+
+}
+
+// Gives the list a pointer array of its own if it shares one. The copy points at the same elements, so each chunk is held once more.
+static void _List_OwnArray(List* l) {
+
+    struct _ListShare* share = l->share;
+    if (atomic_load(&share->references) == 1) return;
+
+    struct _ListShare* own = malloc(sizeof(struct _ListShare) + share->chunks * sizeof(atomic_int*));
+    atomic_init(&own->references, 1);
+    own->chunks = share->chunks;
+    for (int c = 0; c < share->chunks; c++) {
+        own->counts[c] = share->counts[c];
+        atomic_fetch_add(own->counts[c], 1);
+    }
+
+    void** shared = l->elements;
+    l->elements = Pages_Alloc(l->size * sizeof(void*));
+    memcpy(l->elements, shared, l->length * sizeof(void*));
+    l->share = own;
+    _List_DropArray(l, shared, share);
+
+}
+
+// Gives the list its own copy of the elements in a chunk, once it has a pointer array of its own.
+static void _List_OwnChunk(List* l, int chunk) {
+
+    atomic_int* count = l->share->counts[chunk];
+    if (count == NULL) return;
+    l->share->counts[chunk] = NULL;
+
+    if (atomic_load(count) == 1) {
+        free(count);
+        return;
+    }
+
+    // Keep the originals until the count says whether anything else still holds them.
+    int start = chunk * LIST_CHUNK_LENGTH;
+    int end = _List_ChunkEnd(l, chunk);
+    void** originals = malloc((end - start) * sizeof(void*));
+    memcpy(originals, l->elements + start, (end - start) * sizeof(void*));
+
+    for (int i = start; i < end; i++) {
+        void* e = malloc(l->element_size);
+        memcpy(e, originals[i - start], l->element_size);
+        l->elements[i] = e;
+    }
+
+    if (atomic_fetch_sub(count, 1) == 1) {
+        for (int i = 0; i < end - start; i++) free(originals[i]);
+        free(count);
+    }
+    free(originals);
+
+}
+
+// Makes the pointer array, and the chunks holding the indices from start to end, safe to change.
+static inline void _List_Own(List* l, int start, int end) {
+    if (l->share == NULL) return;
+    _List_OwnArray(l);
+    for (int c = start / LIST_CHUNK_LENGTH; c < l->share->chunks && c * LIST_CHUNK_LENGTH < end; c++) _List_OwnChunk(l, c);
+}
+
+void List_Clone(List* l, List* clone) {
+
+    int chunks = (l->length + LIST_CHUNK_LENGTH - 1) / LIST_CHUNK_LENGTH;
+    if (chunks == 0) {
+        List_Init(clone, l->element_size);
+        return;
+    }
+
+    // A shared array never grows, so only an array the list owns can need more counts.
+    if (l->share == NULL || l->share->chunks < chunks) {
+        int from = l->share != NULL ? l->share->chunks : 0;
+        struct _ListShare* share = realloc(l->share, sizeof(struct _ListShare) + chunks * sizeof(atomic_int*));
+        if (l->share == NULL) atomic_init(&share->references, 1);
+        for (int c = from; c < chunks; c++) share->counts[c] = NULL;
+        share->chunks = chunks;
+        l->share = share;
+    }
+
+    // Chunks the array owns become shared with itself, so that copies of the array can hold them too.
+    for (int c = 0; c < chunks; c++) {
+        if (l->share->counts[c] != NULL) continue;
+        l->share->counts[c] = malloc(sizeof(atomic_int));
+        atomic_init(l->share->counts[c], 1);
+    }
+
+    atomic_fetch_add(&l->share->references, 1);
+    memcpy(clone, l, sizeof(List));
+
 }
 
 int List_Length(List* l) {
@@ -28,6 +191,7 @@ bool List_Get(List* l, int index, void* buffer) {
 bool List_Pop(List* l, void* buffer) {
     
     if (l->length < 1) return 0;
+    _List_Own(l, l->length - 1, l->length);
     if (buffer != NULL) memcpy(buffer, l->elements[l->length-1], l->element_size);
     
     free(l->elements[l->length-1]);
@@ -39,10 +203,11 @@ bool List_Pop(List* l, void* buffer) {
 bool List_Shift(List* l, void* buffer) {
     
     if (l->length < 1) return 0;
+    _List_Own(l, 0, l->length);
     if (buffer != NULL) memcpy(buffer, l->elements[0], l->element_size);
     
     free(l->elements[0]);
-    memmove(l->elements, l->elements + 1, (l->length - 1) * sizeof(void*));
+    _List_Move(l, 0, 1, l->length - 1);
     l->length--;
     
     return 1;
@@ -54,8 +219,9 @@ bool List_Remove(List* l, int index) {
     if (index == 0) return List_Shift(l, NULL);
     if (index == l->length - 1) return List_Pop(l, NULL);
     
+    _List_Own(l, index, l->length);
     free(l->elements[index]);
-    memmove(l->elements + index, l->elements + index + 1, (l->length - index - 1) * sizeof(void*));
+    _List_Move(l, index, index + 1, l->length - index - 1);
     l->length--;
     
     return 1;
@@ -63,10 +229,8 @@ bool List_Remove(List* l, int index) {
 
 void List_Push(List* l, void* element) {
 
-    if (l->length >= l->size) {
-        l->elements = realloc(l->elements, l->size * 2 * sizeof(void*));
-        l->size = l->size * 2;
-    }
+    _List_Own(l, l->length, l->length + 1);
+    _List_Reserve(l, l->length + 1);
 
     void* e = malloc(l->element_size);
     memmove(e, element, l->element_size);
@@ -77,14 +241,12 @@ void List_Push(List* l, void* element) {
 
 void List_Unshift(List* l, void* element) {
 
-    if (l->length >= l->size) {
-        l->elements = realloc(l->elements, l->size * 2 * sizeof(void*));
-        l->size = l->size * 2;
-    }
+    _List_Own(l, 0, l->length + 1);
+    _List_Reserve(l, l->length + 1);
 
     void* e = malloc(l->element_size);
     memmove(e, element, l->element_size);
-    memmove(l->elements + 1, l->elements, l->length * sizeof(void*));
+    _List_Move(l, 1, 0, l->length);
     l->elements[0] = e;
     l->length++;
 
@@ -104,20 +266,465 @@ bool List_Add(List* l, int index, void* element) {
         return 0;
     }
 
-    if (l->length >= l->size) {
-        l->elements = realloc(l->elements, l->size * 2 * sizeof(void*));
-        l->size = l->size * 2;
-    }
+    _List_Own(l, index, l->length + 1);
+    _List_Reserve(l, l->length + 1);
 
     void* e = malloc(l->element_size);
     memmove(e, element, l->element_size);
-    memmove(l->elements + index + 1, l->elements + index, (l->length - index) * sizeof(void*));
+    _List_Move(l, index + 1, index, l->length - index);
     l->elements[index] = e;
     l->length++;
     
     return 0;
 }
 
+bool List_InsertRange(List* l, int index, void* elements, int count) {
+
+    if (index < 0 || index > l->length || count < 0) return 0;
+    if (count == 0) return 1;
+
+    _List_Own(l, index, l->length + count);
+    _List_Reserve(l, l->length + count);
+    _List_Move(l, index + count, index, l->length - index);
+
+    uint8_t* element = elements;
+    for (int i = 0; i < count; i++) {
+        void* e = malloc(l->element_size);
+        memcpy(e, element, l->element_size);
+        l->elements[index + i] = e;
+        element += l->element_size;
+    }
+
+    l->length += count;
+    return 1;
+}
+
+void List_Extend(List* l, void* elements, int count) {
+    List_InsertRange(l, l->length, elements, count);
+}
+
+bool List_RemoveRange(List* l, int start, int end) {
+
+    if (start < 0 || end > l->length || start > end) return 0;
+    if (start == end) return 1;
+
+    _List_Own(l, start, l->length);
+    for (int i = start; i < end; i++) free(l->elements[i]);
+    _List_Move(l, start, end, l->length - end);
+    l->length -= end - start;
+
+    return 1;
+}
+
+bool List_Slice(List* l, int start, int end, List* out) {
+
+    if (start < 0 || end > l->length || start > end) return 0;
+
+    List_Init(out, l->element_size);
+    _List_Reserve(out, end - start);
+
+    for (int i = start; i < end; i++) {
+        void* e = malloc(l->element_size);
+        memcpy(e, l->elements[i], l->element_size);
+        out->elements[i - start] = e;
+    }
+
+    out->length = end - start;
+    return 1;
+}
+
+int List_RemoveIf(List* l, bool (*remove)(const void*, void*), void* arg) {
+
+    // Compact the survivors towards the front in a single pass.
+    _List_Own(l, 0, l->length);
+    int length = 0;
+    for (int i = 0; i < l->length; i++) {
+        if (remove(l->elements[i], arg)) free(l->elements[i]);
+        else l->elements[length++] = l->elements[i];
+    }
+
+    int removed = l->length - length;
+    l->length = length;
+    return removed;
+}
+
+// Returns how many runs a list of the given length should be split into across the pool.
+static int _List_Tasks(int length) {
+    if (length < LIST_PARALLEL_LENGTH) return 1;
+    int tasks = ThreadPool_Threads();
+    if (tasks > length / (LIST_PARALLEL_LENGTH / 2)) tasks = length / (LIST_PARALLEL_LENGTH / 2);
+    return tasks;
+}
+
+static inline int _List_RunStart(int length, int tasks, int index) {
+    return (int) ((long long) length * index / tasks);
+}
+
+//-----------------------------------------------------------------------------
+// Merge sort
+//
+// Each task sorts one run of the pointer array, then rounds of merges double
+// the run width. Every round is split by output position rather than by run,
+// so the last merge still uses every thread.
+//-----------------------------------------------------------------------------
+
+struct _ListSort {
+    void** source;
+    void** target;
+    int length;
+    int tasks;
+    int width;
+    int (*compare)(const void*, const void*);
+};
+
+static void _List_Merge(void** left, int left_length, void** right, int right_length, void** out, int (*compare)(const void*, const void*)) {
+    int i = 0, j = 0, k = 0;
+    while (i < left_length && j < right_length) {
+        if (compare(right[j], left[i]) < 0) out[k++] = right[j++];
+        else out[k++] = left[i++];
+    }
+    while (i < left_length) out[k++] = left[i++];
+    while (j < right_length) out[k++] = right[j++];
+}
+
+// Sorts length pointers by the elements they point to, using the buffer as scratch space.
+static void _List_MergeSort(void** elements, void** buffer, int length, int (*compare)(const void*, const void*)) {
+
+    for (int start = 0; start < length; start += LIST_INSERTION_LENGTH) {
+        int end = start + LIST_INSERTION_LENGTH < length ? start + LIST_INSERTION_LENGTH : length;
+        for (int i = start + 1; i < end; i++) {
+            void* e = elements[i];
+            int j = i;
+            while (j > start && compare(e, elements[j-1]) < 0) {
+                elements[j] = elements[j-1];
+                j--;
+            }
+            elements[j] = e;
+        }
+    }
+
+    void** source = elements;
+    void** target = buffer;
+    for (int width = LIST_INSERTION_LENGTH; width < length; width *= 2) {
+        for (int lo = 0; lo < length; lo += 2 * width) {
+            int mid = lo + width < length ? lo + width : length;
+            int hi = lo + 2 * width < length ? lo + 2 * width : length;
+            _List_Merge(source + lo, mid - lo, source + mid, hi - mid, target + lo, compare);
+        }
+        void** swap = source;
+        source = target;
+        target = swap;
+    }
+
+    if (source != elements) memcpy(elements, source, length * sizeof(void*));
+
+}
+
+// Returns how many of the first k merged elements come from the left run.
+static int _List_CoRank(int k, void** left, int left_length, void** right, int right_length, int (*compare)(const void*, const void*)) {
+    int lo = k - right_length > 0 ? k - right_length : 0;
+    int hi = k < left_length ? k : left_length;
+    while (lo < hi) {
+        int i = (lo + hi) / 2;
+        if (compare(right[k-i-1], left[i]) < 0) hi = i;
+        else lo = i + 1;
+    }
+    return lo;
+}
+
+static void _List_SortRun(int index, void* arg) {
+    struct _ListSort* s = arg;
+    int start = index * s->width;
+    int end = start + s->width < s->length ? start + s->width : s->length;
+    if (start < end) _List_MergeSort(s->source + start, s->target + start, end - start, s->compare);
+}
+
+static void _List_SortMerge(int index, void* arg) {
+
+    struct _ListSort* s = arg;
+    int start = _List_RunStart(s->length, s->tasks, index);
+    int end = _List_RunStart(s->length, s->tasks, index + 1);
+
+    for (int lo = start / (2 * s->width) * (2 * s->width); lo < end; lo += 2 * s->width) {
+
+        int mid = lo + s->width < s->length ? lo + s->width : s->length;
+        int hi = lo + 2 * s->width < s->length ? lo + 2 * s->width : s->length;
+        int from = (start > lo ? start : lo) - lo;
+        int to = (end < hi ? end : hi) - lo;
+
+        void** left = s->source + lo;
+        void** right = s->source + mid;
+        int i = _List_CoRank(from, left, mid - lo, right, hi - mid, s->compare);
+        int j = _List_CoRank(to, left, mid - lo, right, hi - mid, s->compare);
+        _List_Merge(left + i, j - i, right + from - i, (to - j) - (from - i), s->target + lo + from, s->compare);
+
+    }
+
+}
+
+void List_Sort(List* l, int (*compare)(const void*, const void*)) {
+
+    if (l->length < 2) return;
+    _List_Own(l, 0, l->length);
+    void** buffer = malloc(l->length * sizeof(void*));
+
+    int tasks = _List_Tasks(l->length);
+    if (tasks == 1) {
+        _List_MergeSort(l->elements, buffer, l->length, compare);
+        free(buffer);
+        return;
+    }
+
+    struct _ListSort s = {l->elements, buffer, l->length, tasks, (l->length + tasks - 1) / tasks, compare};
+    ThreadPool_ParallelFor(tasks, _List_SortRun, &s);
+
+    while (s.width < s.length) {
+        ThreadPool_ParallelFor(tasks, _List_SortMerge, &s);
+        void** swap = s.source;
+        s.source = s.target;
+        s.target = swap;
+        s.width *= 2;
+    }
+
+    if (s.source != l->elements) memcpy(l->elements, s.source, l->length * sizeof(void*));
+    free(buffer);
+
+}
+
+//-----------------------------------------------------------------------------
+// Radix sort
+//
+// The keys are loaded once next to their element pointers, then sorted one
+// byte at a time. Each task counts the digits of its run, the counts are
+// turned into per-task offsets, and each task scatters its run, which keeps
+// every pass stable. Passes where every key shares the digit are skipped.
+//-----------------------------------------------------------------------------
+
+struct _ListRadixEntry {
+    uint64_t key;
+    void* element;
+};
+
+struct _ListRadix {
+    void** elements;
+    size_t element_size;
+    bool is_signed;
+    struct _ListRadixEntry* source;
+    struct _ListRadixEntry* target;
+    size_t (*counts)[256];
+    int length;
+    int tasks;
+    int shift;
+};
+
+static void _List_RadixLoad(int index, void* arg) {
+
+    struct _ListRadix* r = arg;
+    int end = _List_RunStart(r->length, r->tasks, index + 1);
+
+    for (int i = _List_RunStart(r->length, r->tasks, index); i < end; i++) {
+
+        uint64_t key;
+        switch (r->element_size) {
+            case 1: {uint8_t k; memcpy(&k, r->elements[i], 1); key = k; break;}
+            case 2: {uint16_t k; memcpy(&k, r->elements[i], 2); key = k; break;}
+            case 4: {uint32_t k; memcpy(&k, r->elements[i], 4); key = k; break;}
+            default: {memcpy(&key, r->elements[i], 8); break;}
+        }
+
+        // Flipping the sign bit puts negative numbers first.
+        if (r->is_signed) key ^= (uint64_t) 1 << (8 * r->element_size - 1);
+
+        r->source[i].key = key;
+        r->source[i].element = r->elements[i];
+
+    }
+
+}
+
+static void _List_RadixCount(int index, void* arg) {
+    struct _ListRadix* r = arg;
+    size_t* counts = r->counts[index];
+    memset(counts, 0, 256 * sizeof(size_t));
+    int end = _List_RunStart(r->length, r->tasks, index + 1);
+    for (int i = _List_RunStart(r->length, r->tasks, index); i < end; i++) {
+        counts[(r->source[i].key >> r->shift) & 0xFF]++;
+    }
+}
+
+static void _List_RadixScatter(int index, void* arg) {
+    struct _ListRadix* r = arg;
+    size_t* offsets = r->counts[index];
+    int end = _List_RunStart(r->length, r->tasks, index + 1);
+    for (int i = _List_RunStart(r->length, r->tasks, index); i < end; i++) {
+        r->target[offsets[(r->source[i].key >> r->shift) & 0xFF]++] = r->source[i];
+    }
+}
+
+static void _List_RadixStore(int index, void* arg) {
+    struct _ListRadix* r = arg;
+    int end = _List_RunStart(r->length, r->tasks, index + 1);
+    for (int i = _List_RunStart(r->length, r->tasks, index); i < end; i++) {
+        r->elements[i] = r->source[i].element;
+    }
+}
+
+bool List_SortIntegers(List* l, bool is_signed) {
+
+    size_t size = l->element_size;
+    if (size != 1 && size != 2 && size != 4 && size != 8) return 0;
+    if (l->length < 2) return 1;
+    _List_Own(l, 0, l->length);
+
+    struct _ListRadix r;
+    r.elements = l->elements;
+    r.element_size = size;
+    r.is_signed = is_signed;
+    r.length = l->length;
+    r.tasks = _List_Tasks(l->length);
+    r.source = malloc(l->length * sizeof(struct _ListRadixEntry));
+    r.target = malloc(l->length * sizeof(struct _ListRadixEntry));
+    r.counts = malloc(r.tasks * sizeof(*r.counts));
+
+    ThreadPool_ParallelFor(r.tasks, _List_RadixLoad, &r);
+
+    for (r.shift = 0; r.shift < (int) (8 * size); r.shift += 8) {
+
+        ThreadPool_ParallelFor(r.tasks, _List_RadixCount, &r);
+
+        // Turn the counts into the offset each task starts writing each digit at.
+        size_t total = 0;
+        bool skip = 0;
+        for (int digit = 0; digit < 256; digit++) {
+            size_t start = total;
+            for (int t = 0; t < r.tasks; t++) {
+                size_t count = r.counts[t][digit];
+                r.counts[t][digit] = total;
+                total += count;
+            }
+            if (total - start == (size_t) r.length) skip = 1;
+        }
+        if (skip) continue;
+
+        ThreadPool_ParallelFor(r.tasks, _List_RadixScatter, &r);
+        struct _ListRadixEntry* swap = r.source;
+        r.source = r.target;
+        r.target = swap;
+
+    }
+
+    ThreadPool_ParallelFor(r.tasks, _List_RadixStore, &r);
+
+    free(r.source);
+    free(r.target);
+    free(r.counts);
+    return 1;
+
+}
+
+//-----------------------------------------------------------------------------
+// Map, filter and reduce
+//-----------------------------------------------------------------------------
+
+struct _ListApply {
+    List* l;
+    int tasks;
+    void (*function)(void*, void*);
+    bool (*accept)(const void*, void*);
+    void (*combine)(void*, const void*, void*);
+    void* arg;
+    bool* keep;
+    uint8_t* partials;
+};
+
+static void _List_MapRun(int index, void* arg) {
+    struct _ListApply* a = arg;
+    int end = _List_RunStart(a->l->length, a->tasks, index + 1);
+    for (int i = _List_RunStart(a->l->length, a->tasks, index); i < end; i++) {
+        a->function(a->l->elements[i], a->arg);
+    }
+}
+
+static void _List_FilterRun(int index, void* arg) {
+    struct _ListApply* a = arg;
+    int end = _List_RunStart(a->l->length, a->tasks, index + 1);
+    for (int i = _List_RunStart(a->l->length, a->tasks, index); i < end; i++) {
+        a->keep[i] = a->accept(a->l->elements[i], a->arg);
+    }
+}
+
+static void _List_ReduceRun(int index, void* arg) {
+    struct _ListApply* a = arg;
+    void* partial = a->partials + (index + 1) * a->l->element_size;
+    memcpy(partial, a->partials, a->l->element_size);
+    int end = _List_RunStart(a->l->length, a->tasks, index + 1);
+    for (int i = _List_RunStart(a->l->length, a->tasks, index); i < end; i++) {
+        a->combine(partial, a->l->elements[i], a->arg);
+    }
+}
+
+void List_Map(List* l, void (*function)(void*, void*), void* arg) {
+    _List_Own(l, 0, l->length);
+    struct _ListApply a = {.l = l, .tasks = _List_Tasks(l->length), .function = function, .arg = arg};
+    ThreadPool_ParallelFor(a.tasks, _List_MapRun, &a);
+}
+
+int List_Filter(List* l, bool (*keep)(const void*, void*), void* arg) {
+
+    if (l->length < 1) return 0;
+    _List_Own(l, 0, l->length);
+
+    struct _ListApply a = {.l = l, .tasks = _List_Tasks(l->length), .accept = keep, .arg = arg};
+    a.keep = malloc(l->length * sizeof(bool));
+    ThreadPool_ParallelFor(a.tasks, _List_FilterRun, &a);
+
+    // Only pointers move, so compacting is cheap next to the calls to keep.
+    int length = 0;
+    for (int i = 0; i < l->length; i++) {
+        if (a.keep[i]) l->elements[length++] = l->elements[i];
+        else free(l->elements[i]);
+    }
+
+    int removed = l->length - length;
+    l->length = length;
+    free(a.keep);
+    return removed;
+
+}
+
+void List_Reduce(List* l, void (*combine)(void*, const void*, void*), void* arg, void* buffer) {
+
+    if (l->length < 1) return;
+
+    // The first slot holds the identity, followed by one partial result per task.
+    struct _ListApply a = {.l = l, .tasks = _List_Tasks(l->length), .combine = combine, .arg = arg};
+    a.partials = malloc((a.tasks + 1) * l->element_size);
+    memcpy(a.partials, buffer, l->element_size);
+    ThreadPool_ParallelFor(a.tasks, _List_ReduceRun, &a);
+
+    for (int i = 0; i < a.tasks; i++) {
+        combine(buffer, a.partials + (i + 1) * l->element_size, arg);
+    }
+
+    free(a.partials);
+
+}
+
+int List_BinarySearch(List* l, void* element, int (*compare)(const void*, const void*)) {
+
+    int lo = 0;
+    int hi = l->length;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (compare(l->elements[mid], element) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+
+    if (lo < l->length && compare(l->elements[lo], element) == 0) return lo;
+    return -1;
+
+}
+
 void List_Clear(List* l) {
     size_t element_size = l->element_size;
     List_Free(l);
@@ -125,6 +732,10 @@ void List_Clear(List* l) {
 }
 
 void List_Free(List* l) {
+    if (l->share != NULL) {
+        _List_DropArray(l, l->elements, l->share);
+        return;
+    }
     for (int i = 0; i < l->length; i++) free(l->elements[i]);
-    free(l->elements);
+    Pages_Free(l->elements, l->size * sizeof(void*));
 }
\ No newline at end of file
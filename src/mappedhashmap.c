@@ -0,0 +1,278 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "hash.h"
+#include "mappedhashmap.h"
+
+#define MAPPEDHASHMAP_MAGIC "CDSLMHM1"
+#define MAPPEDHASHMAP_INITIAL_N 16
+#define MAPPEDHASHMAP_MAX_EVICTIONS 128
+
+// The placement is the same cuckoo scheme as HashMap: a left and a right table
+// of n slots each, a path based eviction tried from both slots, and growth
+// that keeps the seeds and every pair in its own table. Slots hold the pairs
+// by value, as a used byte followed by the key and the value.
+
+static inline uint8_t* _MappedHashMap_Slot(MappedHashMap* m, size_t index) {
+    return m->slots + index * m->stride;
+}
+
+static inline uint8_t* _MappedHashMap_Key(uint8_t* slot) {
+    return slot + 1;
+}
+
+static inline uint8_t* _MappedHashMap_Value(MappedHashMap* m, uint8_t* slot) {
+    return slot + 1 + m->header->key_size;
+}
+
+static inline size_t _MappedHashMap_Left(MappedHashMap* m, const void* key, size_t n) {
+    MappedHashMapHeader* header = m->header;
+    return SIP64((const uint8_t*) key, header->key_size, header->left_seed_0, header->left_seed_1) % n;
+}
+
+static inline size_t _MappedHashMap_Right(MappedHashMap* m, const void* key, size_t n) {
+    MappedHashMapHeader* header = m->header;
+    return SIP64((const uint8_t*) key, header->key_size, header->right_seed_0, header->right_seed_1) % n;
+}
+
+static inline bool _MappedHashMap_Holds(MappedHashMap* m, uint8_t* slot, const void* key) {
+    return slot[0] && memcmp(_MappedHashMap_Key(slot), key, m->header->key_size) == 0;
+}
+
+// Maps length bytes of the file, replacing any previous mapping.
+static bool _MappedHashMap_Map(MappedHashMap* m, size_t length) {
+
+    void* memory = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_SHARED, m->fd, 0);
+    if (memory == MAP_FAILED) {return 0;}
+
+    if (m->header != NULL) {munmap(m->header, m->length);}
+    m->header = memory;
+    m->slots = (uint8_t*) memory + sizeof(MappedHashMapHeader);
+    m->length = length;
+    return 1;
+
+}
+
+bool MappedHashMap_Open(MappedHashMap* m, const char* path, size_t key_size, size_t value_size) {
+
+    m->fd = open(path, O_RDWR | O_CREAT, 0644);
+    if (m->fd < 0) {return 0;}
+
+    m->stride = 1 + key_size + value_size;
+    m->header = NULL;
+    m->slots = NULL;
+    m->length = 0;
+
+    struct stat st;
+    if (fstat(m->fd, &st) != 0) {
+        close(m->fd);
+        return 0;
+    }
+
+    // A new file gets a header and empty tables.
+    if (st.st_size == 0) {
+
+        size_t length = sizeof(MappedHashMapHeader) + 2 * MAPPEDHASHMAP_INITIAL_N * m->stride;
+        if (ftruncate(m->fd, length) != 0 || !_MappedHashMap_Map(m, length)) {
+            close(m->fd);
+            return 0;
+        }
+
+        MappedHashMapHeader* header = m->header;
+        memcpy(header->magic, MAPPEDHASHMAP_MAGIC, sizeof(header->magic));
+        header->key_size = key_size;
+        header->value_size = value_size;
+        header->size = 0;
+        header->n = MAPPEDHASHMAP_INITIAL_N;
+        header->left_seed_0 = SEED64();
+        header->left_seed_1 = SEED64();
+        header->right_seed_0 = SEED64();
+        header->right_seed_1 = SEED64();
+        return 1;
+
+    }
+
+    // An existing file must hold a map of the same pairs, and be at least as long as its tables.
+    // It can be longer if a grow failed after extending it, in which case the rest is unused.
+    if ((size_t) st.st_size < sizeof(MappedHashMapHeader) || !_MappedHashMap_Map(m, st.st_size)) {
+        close(m->fd);
+        return 0;
+    }
+
+    MappedHashMapHeader* header = m->header;
+    if (memcmp(header->magic, MAPPEDHASHMAP_MAGIC, sizeof(header->magic)) != 0 ||
+        header->key_size != key_size || header->value_size != value_size ||
+        m->length < sizeof(MappedHashMapHeader) + 2 * header->n * m->stride) {
+        MappedHashMap_Close(m);
+        return 0;
+    }
+
+    return 1;
+
+}
+
+int MappedHashMap_Size(MappedHashMap* m) {
+    return m->header->size;
+}
+
+bool MappedHashMap_Get(MappedHashMap* m, void* key, void* buffer) {
+
+    // If the buffer is null, we cannot write to it, return 0.
+    if (buffer == NULL) {return 0;}
+
+    size_t n = m->header->n;
+    uint8_t* slot = _MappedHashMap_Slot(m, _MappedHashMap_Left(m, key, n));
+    if (!_MappedHashMap_Holds(m, slot, key)) {
+        slot = _MappedHashMap_Slot(m, n + _MappedHashMap_Right(m, key, n));
+        if (!_MappedHashMap_Holds(m, slot, key)) {return 0;}
+    }
+
+    memcpy(buffer, _MappedHashMap_Value(m, slot), m->header->value_size);
+    return 1;
+
+}
+
+bool MappedHashMap_Remove(MappedHashMap* m, void* key) {
+
+    size_t n = m->header->n;
+    uint8_t* slot = _MappedHashMap_Slot(m, _MappedHashMap_Left(m, key, n));
+    if (!_MappedHashMap_Holds(m, slot, key)) {
+        slot = _MappedHashMap_Slot(m, n + _MappedHashMap_Right(m, key, n));
+        if (!_MappedHashMap_Holds(m, slot, key)) {return 0;}
+    }
+
+    memset(slot, 0, m->stride);
+    m->header->size--;
+    return 1;
+
+}
+
+// Doubles both tables by extending the file. The right table moves into the
+// new space first, which frees the old one for the second half of the left
+// table. Every pair goes to its old slot or the old slot plus n, so none collide.
+static bool _MappedHashMap_Grow(MappedHashMap* m) {
+
+    size_t n = m->header->n;
+    size_t length = sizeof(MappedHashMapHeader) + 4 * n * m->stride;
+    if (ftruncate(m->fd, length) != 0) {return 0;}
+    if (!_MappedHashMap_Map(m, length)) {
+        // Should the file not shrink back either, the space past the tables is left unused, which Open allows.
+        int shrunk = ftruncate(m->fd, m->length);
+        (void) shrunk;
+        return 0;
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint8_t* slot = _MappedHashMap_Slot(m, n + i);
+        if (!slot[0]) {continue;}
+        uint8_t* target = _MappedHashMap_Slot(m, 2 * n + _MappedHashMap_Right(m, _MappedHashMap_Key(slot), 2 * n));
+        memcpy(target, slot, m->stride);
+        memset(slot, 0, m->stride);
+    }
+
+    for (size_t i = 0; i < n; i++) {
+        uint8_t* slot = _MappedHashMap_Slot(m, i);
+        if (!slot[0]) {continue;}
+        size_t left = _MappedHashMap_Left(m, _MappedHashMap_Key(slot), 2 * n);
+        if (left == i) {continue;}
+        memcpy(_MappedHashMap_Slot(m, left), slot, m->stride);
+        memset(slot, 0, m->stride);
+    }
+
+    m->header->n = 2 * n;
+    return 1;
+
+}
+
+// Walks the eviction path from an occupied slot until an empty slot is found,
+// pushing each occupant to its alternative slot in the other table.
+// Returns 1 once the starting slot is empty, or 0 if the path was too long.
+static bool _MappedHashMap_Evict(MappedHashMap* m, size_t start) {
+
+    size_t n = m->header->n;
+    size_t path[MAPPEDHASHMAP_MAX_EVICTIONS + 1];
+    path[0] = start;
+
+    for (int i = 0; i < MAPPEDHASHMAP_MAX_EVICTIONS; i++) {
+
+        uint8_t* key = _MappedHashMap_Key(_MappedHashMap_Slot(m, path[i]));
+        if (path[i] < n) {path[i+1] = n + _MappedHashMap_Right(m, key, n);}
+        else {path[i+1] = _MappedHashMap_Left(m, key, n);}
+
+        if (_MappedHashMap_Slot(m, path[i+1])[0]) {continue;}
+
+        // Shift every pair one step along the path, starting from the empty end.
+        for (int j = i + 1; j > 0; j--) {
+            memcpy(_MappedHashMap_Slot(m, path[j]), _MappedHashMap_Slot(m, path[j-1]), m->stride);
+        }
+
+        memset(_MappedHashMap_Slot(m, start), 0, m->stride);
+        return 1;
+
+    }
+
+    return 0;
+
+}
+
+bool MappedHashMap_Put(MappedHashMap* m, void* key, void* value) {
+
+    MappedHashMapHeader* header = m->header;
+
+    // If the load factor exceeds 0.5, grow the tables to improve performance
+    if (header->size > header->n / 2) {
+        if (!_MappedHashMap_Grow(m)) {return 0;}
+        header = m->header;
+    }
+
+    size_t n = header->n;
+    size_t left = _MappedHashMap_Left(m, key, n);
+    size_t right = n + _MappedHashMap_Right(m, key, n);
+    uint8_t* left_slot = _MappedHashMap_Slot(m, left);
+    uint8_t* right_slot = _MappedHashMap_Slot(m, right);
+
+    // If the key is already stored in either slot, update its value there.
+    uint8_t* slot = NULL;
+    if (_MappedHashMap_Holds(m, left_slot, key)) {slot = left_slot;}
+    else if (_MappedHashMap_Holds(m, right_slot, key)) {slot = right_slot;}
+    if (slot != NULL) {
+        memcpy(_MappedHashMap_Value(m, slot), value, header->value_size);
+        return 1;
+    }
+
+    // Otherwise take an empty slot, making one if needed.
+    if (!left_slot[0] || _MappedHashMap_Evict(m, left)) {slot = left_slot;}
+    else if (!right_slot[0] || _MappedHashMap_Evict(m, right)) {slot = right_slot;}
+
+    // Both eviction paths are too long, so grow and try again.
+    if (slot == NULL) {
+        if (!_MappedHashMap_Grow(m)) {return 0;}
+        return MappedHashMap_Put(m, key, value);
+    }
+
+    slot[0] = 1;
+    memcpy(_MappedHashMap_Key(slot), key, header->key_size);
+    memcpy(_MappedHashMap_Value(m, slot), value, header->value_size);
+    header->size++;
+    return 1;
+
+}
+
+bool MappedHashMap_Sync(MappedHashMap* m) {
+    return msync(m->header, m->length, MS_SYNC) == 0;
+}
+
+void MappedHashMap_Close(MappedHashMap* m) {
+    if (m->header != NULL) {munmap(m->header, m->length);}
+    close(m->fd);
+    m->header = NULL;
+    m->slots = NULL;
+    m->length = 0;
+    m->fd = -1;
+}
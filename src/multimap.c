@@ -0,0 +1,137 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include <stdbool.h>
+#include "multimap.h"
+
+// The table maps each key to a pointer to its run, so putting a value costs
+// one lookup and, when the run is full, one realloc which doubles it. Runs
+// start with room for a single value, as most keys of an index hold few.
+struct _MultiMapRun {
+    int length;
+    int size;
+    _Alignas(max_align_t) uint8_t values[];
+};
+
+static inline struct _MultiMapRun* _MultiMap_NewRun(MultiMap* m, int size) {
+    struct _MultiMapRun* run = malloc(sizeof(struct _MultiMapRun) + size * m->value_size);
+    run->length = 0;
+    run->size = size;
+    return run;
+}
+
+void MultiMap_Init(MultiMap* m, size_t key_size, size_t value_size) {
+    m->value_size = value_size;
+    m->size = 0;
+    HashMap_Init(&m->runs, key_size, sizeof(struct _MultiMapRun*));
+}
+
+int MultiMap_Size(MultiMap* m) {
+    return m->size;
+}
+
+int MultiMap_Keys(MultiMap* m) {
+    return HashMap_Size(&m->runs);
+}
+
+void MultiMap_Put(MultiMap* m, void* key, void* value) {
+
+    struct _MultiMapRun** reference = HashMap_Reference(&m->runs, key);
+    struct _MultiMapRun* run;
+
+    if (reference == NULL) {
+        run = _MultiMap_NewRun(m, 1);
+        HashMap_Put(&m->runs, key, &run);
+    }
+
+    else {
+        run = *reference;
+        if (run->length == run->size) {
+            run->size *= 2;
+            run = realloc(run, sizeof(struct _MultiMapRun) + run->size * m->value_size);
+            *reference = run;
+        }
+    }
+
+    memcpy(run->values + run->length * m->value_size, value, m->value_size);
+    run->length++;
+    m->size++;
+
+}
+
+void* MultiMap_Get(MultiMap* m, void* key, int* count) {
+
+    struct _MultiMapRun* run;
+    if (!HashMap_Get(&m->runs, key, &run)) {
+        if (count != NULL) {*count = 0;}
+        return NULL;
+    }
+
+    if (count != NULL) {*count = run->length;}
+    return run->values;
+
+}
+
+bool MultiMap_RemoveValue(MultiMap* m, void* key, void* value) {
+
+    struct _MultiMapRun** reference = HashMap_Reference(&m->runs, key);
+    if (reference == NULL) {return 0;}
+
+    struct _MultiMapRun* run = *reference;
+    for (int i = 0; i < run->length; i++) {
+
+        uint8_t* current = run->values + i * m->value_size;
+        if (memcmp(current, value, m->value_size) != 0) {continue;}
+
+        memmove(current, current + m->value_size, (run->length - i - 1) * m->value_size);
+        run->length--;
+        m->size--;
+
+        if (run->length == 0) {
+            free(run);
+            HashMap_Remove(&m->runs, key);
+        }
+        return 1;
+
+    }
+
+    return 0;
+
+}
+
+bool MultiMap_Remove(MultiMap* m, void* key) {
+
+    struct _MultiMapRun* run;
+    if (!HashMap_Get(&m->runs, key, &run)) {return 0;}
+
+    m->size -= run->length;
+    free(run);
+    HashMap_Remove(&m->runs, key);
+    return 1;
+
+}
+
+KeyValue* MultiMap_Elements(MultiMap* m) {
+    return HashMap_Elements(&m->runs);
+}
+
+void* MultiMap_Values(KeyValue* element, int* count) {
+    struct _MultiMapRun* run = *(struct _MultiMapRun**) element->value;
+    if (count != NULL) {*count = run->length;}
+    return run->values;
+}
+
+void MultiMap_Clear(MultiMap* m) {
+    size_t key_size = m->runs.key_size;
+    size_t value_size = m->value_size;
+    MultiMap_Free(m);
+    MultiMap_Init(m, key_size, value_size);
+}
+
+void MultiMap_Free(MultiMap* m) {
+    for (KeyValue* e = HashMap_Elements(&m->runs); e != NULL; e = e->next) {
+        free(*(struct _MultiMapRun**) e->value);
+    }
+    HashMap_Free(&m->runs);
+}
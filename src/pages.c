@@ -0,0 +1,127 @@
+#define _GNU_SOURCE
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "pages.h"
+
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
+#define PAGES_HUGE_SIZE (2 * 1024 * 1024)
+
+// The memory policies of the mbind system call, as in <numaif.h>.
+#define PAGES_MPOL_BIND 2
+#define PAGES_MPOL_INTERLEAVE 3
+#define PAGES_MPOL_F_MEMS_ALLOWED 4
+#define PAGES_MAX_NODES 1024
+
+static atomic_int _Pages_Options = 0;
+static atomic_int _Pages_Node = 0;
+
+void Pages_SetOptions(int options, int node) {
+    atomic_store(&_Pages_Options, options);
+    atomic_store(&_Pages_Node, node);
+}
+
+// Large allocations are whole huge pages long, so the reserved pool can back them.
+static inline size_t _Pages_Length(size_t size) {
+    return (size + PAGES_HUGE_SIZE - 1) / PAGES_HUGE_SIZE * PAGES_HUGE_SIZE;
+}
+
+#ifdef __linux__
+
+// Applies the NUMA options to a new mapping, before any of its pages are touched.
+static void _Pages_Place(void* memory, size_t length, int options) {
+
+#ifdef SYS_mbind
+    unsigned long nodes[PAGES_MAX_NODES / (8 * sizeof(unsigned long))] = {0};
+
+    if (options & PAGES_BIND) {
+        int node = atomic_load(&_Pages_Node);
+        if (node < 0 || node >= PAGES_MAX_NODES) {return;}
+        nodes[node / (8 * sizeof(unsigned long))] = 1UL << (node % (8 * sizeof(unsigned long)));
+        syscall(SYS_mbind, memory, length, PAGES_MPOL_BIND, nodes, PAGES_MAX_NODES, 0);
+    }
+
+    else if (options & PAGES_INTERLEAVE) {
+        int mode;
+        if (syscall(SYS_get_mempolicy, &mode, nodes, PAGES_MAX_NODES, NULL, PAGES_MPOL_F_MEMS_ALLOWED) != 0) {return;}
+        syscall(SYS_mbind, memory, length, PAGES_MPOL_INTERLEAVE, nodes, PAGES_MAX_NODES, 0);
+    }
+#else
+    (void) memory;
+    (void) length;
+    (void) options;
+#endif
+
+}
+
+void* Pages_Alloc(size_t size) {
+
+    if (size < PAGES_LARGE) {return malloc(size > 0 ? size : 1);}
+
+    size_t length = _Pages_Length(size);
+    int options = atomic_load(&_Pages_Options);
+    void* memory = MAP_FAILED;
+
+    // Try the reserved huge pages first, then ask for transparent ones.
+#ifdef MAP_HUGETLB
+    if (options & PAGES_HUGE) {
+        memory = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    }
+#endif
+
+    if (memory == MAP_FAILED) {
+        memory = mmap(NULL, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {return NULL;}
+#ifdef MADV_HUGEPAGE
+        if (options & PAGES_HUGE) {madvise(memory, length, MADV_HUGEPAGE);}
+#endif
+    }
+
+    _Pages_Place(memory, length, options);
+    return memory;
+
+}
+
+void Pages_Free(void* memory, size_t size) {
+    if (memory == NULL) {return;}
+    if (size < PAGES_LARGE) {free(memory);}
+    else {munmap(memory, _Pages_Length(size));}
+}
+
+#else
+
+void* Pages_Alloc(size_t size) {
+    if (size < PAGES_LARGE) {return malloc(size > 0 ? size : 1);}
+    return calloc(1, size);
+}
+
+void Pages_Free(void* memory, size_t size) {
+    (void) size;
+    free(memory);
+}
+
+#endif
+
+void* Pages_Realloc(void* memory, size_t old_size, size_t size) {
+
+    if (memory == NULL) {return Pages_Alloc(size);}
+
+    // Small allocations stay with malloc.
+    if (old_size < PAGES_LARGE && size < PAGES_LARGE) {return realloc(memory, size > 0 ? size : 1);}
+
+    // Large ones keep their mapping when it is already long enough.
+    if (old_size >= PAGES_LARGE && size >= PAGES_LARGE && _Pages_Length(old_size) == _Pages_Length(size)) {return memory;}
+
+    void* resized = Pages_Alloc(size);
+    if (resized == NULL) {return NULL;}
+    memcpy(resized, memory, old_size < size ? old_size : size);
+    Pages_Free(memory, old_size);
+    return resized;
+
+}
@@ -0,0 +1,235 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "priorityqueue.h"
+
+#define INITIAL_PRIORITYQUEUE_SIZE 16
+
+static inline uint8_t* _PriorityQueue_Element(PriorityQueue* pq, int i) {
+    return pq->elements + i * pq->element_size;
+}
+
+static inline void _PriorityQueue_Place(PriorityQueue* pq, int i, const void* element, int handle) {
+    memcpy(_PriorityQueue_Element(pq, i), element, pq->element_size);
+    pq->handles[i] = handle;
+    pq->positions[handle] = i;
+}
+
+void PriorityQueue_Init(PriorityQueue* pq, size_t element_size, int arity, int (*compare)(const void*, const void*)) {
+
+    pq->element_size = element_size;
+    pq->arity = arity < 2 ? 2 : arity;
+    pq->length = 0;
+    pq->size = INITIAL_PRIORITYQUEUE_SIZE;
+
+    pq->elements = malloc(INITIAL_PRIORITYQUEUE_SIZE * (element_size > 0 ? element_size : 1));
+    pq->handles = malloc(INITIAL_PRIORITYQUEUE_SIZE * sizeof(int));
+
+    pq->positions = malloc(INITIAL_PRIORITYQUEUE_SIZE * sizeof(int));
+    pq->handle_size = INITIAL_PRIORITYQUEUE_SIZE;
+    pq->free_handles = malloc(INITIAL_PRIORITYQUEUE_SIZE * sizeof(int));
+    pq->free_length = 0;
+    pq->next_handle = 0;
+
+    pq->compare = compare;
+    pq->buffer = malloc(element_size > 0 ? element_size : 1);
+
+}
+
+int PriorityQueue_Length(PriorityQueue* pq) {
+    return pq->length;
+}
+
+void _PriorityQueue_Reserve(PriorityQueue* pq, int length) {
+
+    if (length <= pq->size) {return;}
+
+    int size = pq->size;
+    while (size < length) {size *= 2;}
+
+    pq->elements = realloc(pq->elements, size * (pq->element_size > 0 ? pq->element_size : 1));
+    pq->handles = realloc(pq->handles, size * sizeof(int));
+    pq->size = size;
+
+}
+
+int _PriorityQueue_NewHandle(PriorityQueue* pq) {
+
+    // Reuse the handles of elements which have left the queue.
+    if (pq->free_length > 0) {return pq->free_handles[--pq->free_length];}
+
+    if (pq->next_handle == pq->handle_size) {
+        pq->handle_size *= 2;
+        pq->positions = realloc(pq->positions, pq->handle_size * sizeof(int));
+        pq->free_handles = realloc(pq->free_handles, pq->handle_size * sizeof(int));
+    }
+
+    return pq->next_handle++;
+
+}
+
+void _PriorityQueue_ReleaseHandle(PriorityQueue* pq, int handle) {
+    pq->positions[handle] = -1;
+    pq->free_handles[pq->free_length++] = handle;
+}
+
+// Moves the element at index i towards the root until its parent comes before it.
+void _PriorityQueue_SiftUp(PriorityQueue* pq, int i) {
+
+    int handle = pq->handles[i];
+    memcpy(pq->buffer, _PriorityQueue_Element(pq, i), pq->element_size);
+
+    while (i > 0) {
+        int parent = (i - 1) / pq->arity;
+        if (pq->compare(pq->buffer, _PriorityQueue_Element(pq, parent)) >= 0) {break;}
+        _PriorityQueue_Place(pq, i, _PriorityQueue_Element(pq, parent), pq->handles[parent]);
+        i = parent;
+    }
+
+    _PriorityQueue_Place(pq, i, pq->buffer, handle);
+
+}
+
+// Moves the element at index i away from the root until it comes before all its children.
+void _PriorityQueue_SiftDown(PriorityQueue* pq, int i) {
+
+    int handle = pq->handles[i];
+    memcpy(pq->buffer, _PriorityQueue_Element(pq, i), pq->element_size);
+
+    while (1) {
+
+        int first = i * pq->arity + 1;
+        if (first >= pq->length) {break;}
+
+        // Find the child which comes first.
+        int last = first + pq->arity < pq->length ? first + pq->arity : pq->length;
+        int best = first;
+        for (int child = first + 1; child < last; child++) {
+            if (pq->compare(_PriorityQueue_Element(pq, child), _PriorityQueue_Element(pq, best)) < 0) {best = child;}
+        }
+
+        if (pq->compare(_PriorityQueue_Element(pq, best), pq->buffer) >= 0) {break;}
+        _PriorityQueue_Place(pq, i, _PriorityQueue_Element(pq, best), pq->handles[best]);
+        i = best;
+
+    }
+
+    _PriorityQueue_Place(pq, i, pq->buffer, handle);
+
+}
+
+int PriorityQueue_Push(PriorityQueue* pq, void* element) {
+
+    _PriorityQueue_Reserve(pq, pq->length + 1);
+
+    int handle = _PriorityQueue_NewHandle(pq);
+    _PriorityQueue_Place(pq, pq->length, element, handle);
+    pq->length++;
+
+    _PriorityQueue_SiftUp(pq, pq->length - 1);
+    return handle;
+
+}
+
+bool PriorityQueue_Peek(PriorityQueue* pq, void* buffer) {
+    if (pq->length < 1 || buffer == NULL) {return 0;}
+    memcpy(buffer, _PriorityQueue_Element(pq, 0), pq->element_size);
+    return 1;
+}
+
+// Removes the element at index i by filling the hole with the last element.
+void _PriorityQueue_RemoveAt(PriorityQueue* pq, int i) {
+
+    _PriorityQueue_ReleaseHandle(pq, pq->handles[i]);
+    pq->length--;
+    if (i == pq->length) {return;}
+
+    _PriorityQueue_Place(pq, i, _PriorityQueue_Element(pq, pq->length), pq->handles[pq->length]);
+
+    // The moved element may need to go either way.
+    if (i > 0 && pq->compare(_PriorityQueue_Element(pq, i), _PriorityQueue_Element(pq, (i - 1) / pq->arity)) < 0) {
+        _PriorityQueue_SiftUp(pq, i);
+    } else {
+        _PriorityQueue_SiftDown(pq, i);
+    }
+
+}
+
+bool PriorityQueue_Pop(PriorityQueue* pq, void* buffer) {
+
+    if (pq->length < 1) {return 0;}
+    if (buffer != NULL) {memcpy(buffer, _PriorityQueue_Element(pq, 0), pq->element_size);}
+
+    _PriorityQueue_RemoveAt(pq, 0);
+    return 1;
+
+}
+
+static inline bool _PriorityQueue_Valid(PriorityQueue* pq, int handle) {
+    return handle >= 0 && handle < pq->next_handle && pq->positions[handle] >= 0;
+}
+
+bool PriorityQueue_Get(PriorityQueue* pq, int handle, void* buffer) {
+    if (!_PriorityQueue_Valid(pq, handle) || buffer == NULL) {return 0;}
+    memcpy(buffer, _PriorityQueue_Element(pq, pq->positions[handle]), pq->element_size);
+    return 1;
+}
+
+bool PriorityQueue_Update(PriorityQueue* pq, int handle, void* element) {
+
+    if (!_PriorityQueue_Valid(pq, handle)) {return 0;}
+
+    int i = pq->positions[handle];
+    bool earlier = pq->compare(element, _PriorityQueue_Element(pq, i)) < 0;
+    memcpy(_PriorityQueue_Element(pq, i), element, pq->element_size);
+
+    if (earlier) {_PriorityQueue_SiftUp(pq, i);}
+    else {_PriorityQueue_SiftDown(pq, i);}
+    return 1;
+
+}
+
+bool PriorityQueue_Remove(PriorityQueue* pq, int handle) {
+    if (!_PriorityQueue_Valid(pq, handle)) {return 0;}
+    _PriorityQueue_RemoveAt(pq, pq->positions[handle]);
+    return 1;
+}
+
+bool PriorityQueue_FromList(PriorityQueue* pq, List* l) {
+
+    if (l->element_size != pq->element_size) {return 0;}
+
+    int length = List_Length(l);
+    void** elements = List_Elements(l);
+    _PriorityQueue_Reserve(pq, pq->length + length);
+
+    for (int i = 0; i < length; i++) {
+        _PriorityQueue_Place(pq, pq->length, elements[i], _PriorityQueue_NewHandle(pq));
+        pq->length++;
+    }
+
+    // Heapify bottom up, starting from the last node with children.
+    if (pq->length > 1) {
+        for (int i = (pq->length - 2) / pq->arity; i >= 0; i--) {
+            _PriorityQueue_SiftDown(pq, i);
+        }
+    }
+
+    return 1;
+
+}
+
+void PriorityQueue_Clear(PriorityQueue* pq) {
+    pq->length = 0;
+    pq->free_length = 0;
+    pq->next_handle = 0;
+}
+
+void PriorityQueue_Free(PriorityQueue* pq) {
+    free(pq->elements);
+    free(pq->handles);
+    free(pq->positions);
+    free(pq->free_handles);
+    free(pq->buffer);
+}
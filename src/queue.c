@@ -0,0 +1,359 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "queue.h"
+
+#define QUEUE_SPINS 64
+
+static inline size_t _Queue_Capacity(size_t capacity) {
+    size_t n = 2;
+    while (n < capacity) {n *= 2;}
+    return n;
+}
+
+static inline void _Queue_Pause() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#endif
+}
+
+//-----------------------------------------------------------------------------
+// Waiting
+//
+// A waiting thread first spins, then registers itself and sleeps on a
+// condition variable. The other side only takes the mutex when it sees a
+// registered sleeper, so pushes and shifts stay lock-free while nobody waits.
+// Both sides fence between publishing their own progress and reading the
+// other's, so either the sleeper sees the progress or the waker sees the
+// sleeper. A sleeper holds its mutex from its last attempt until it sleeps,
+// so the waker cannot signal in between.
+//-----------------------------------------------------------------------------
+
+static void _Queue_InitWaiters(QueueWaiters* w) {
+    mtx_init(&w->push_mutex, mtx_plain);
+    cnd_init(&w->not_full);
+    atomic_init(&w->pushers, 0);
+    mtx_init(&w->shift_mutex, mtx_plain);
+    cnd_init(&w->not_empty);
+    atomic_init(&w->shifters, 0);
+}
+
+static void _Queue_FreeWaiters(QueueWaiters* w) {
+    mtx_destroy(&w->push_mutex);
+    cnd_destroy(&w->not_full);
+    mtx_destroy(&w->shift_mutex);
+    cnd_destroy(&w->not_empty);
+}
+
+// Called after elements were pushed.
+static void _Queue_WakeShifters(QueueWaiters* w) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&w->shifters, memory_order_relaxed) == 0) {return;}
+    mtx_lock(&w->shift_mutex);
+    cnd_broadcast(&w->not_empty);
+    mtx_unlock(&w->shift_mutex);
+}
+
+// Called after elements were shifted.
+static void _Queue_WakePushers(QueueWaiters* w) {
+    atomic_thread_fence(memory_order_seq_cst);
+    if (atomic_load_explicit(&w->pushers, memory_order_relaxed) == 0) {return;}
+    mtx_lock(&w->push_mutex);
+    cnd_broadcast(&w->not_full);
+    mtx_unlock(&w->push_mutex);
+}
+
+// Tries an operation until it moves one element, spinning first and then sleeping on the condition.
+// The operation must not wake anyone itself, since the mutex is held while it runs.
+static void _Queue_Wait(void* q, void* data, int (*attempt)(void*, void*, int), mtx_t* mutex, cnd_t* condition, atomic_int* waiters) {
+
+    for (int spins = 0; spins < QUEUE_SPINS; spins++) {
+        if (attempt(q, data, 1) == 1) {return;}
+        _Queue_Pause();
+    }
+
+    mtx_lock(mutex);
+    atomic_fetch_add_explicit(waiters, 1, memory_order_relaxed);
+    atomic_thread_fence(memory_order_seq_cst);
+    while (attempt(q, data, 1) != 1) {cnd_wait(condition, mutex);}
+    atomic_fetch_sub_explicit(waiters, 1, memory_order_relaxed);
+    mtx_unlock(mutex);
+
+}
+
+//-----------------------------------------------------------------------------
+// Multi-producer multi-consumer queue
+//
+// Every cell carries a sequence number which says whose turn it is: a cell
+// at position pos is free for the producer of pos when its sequence is pos,
+// and holds an element for the consumer of pos when its sequence is pos + 1.
+//-----------------------------------------------------------------------------
+
+static inline atomic_size_t* _Queue_Sequence(Queue* q, size_t pos) {
+    return (atomic_size_t*) (q->cells + (pos & q->mask) * q->stride);
+}
+
+static inline uint8_t* _Queue_Element(Queue* q, size_t pos) {
+    return q->cells + (pos & q->mask) * q->stride + sizeof(atomic_size_t);
+}
+
+void Queue_Init(Queue* q, size_t element_size, size_t capacity) {
+
+    size_t n = _Queue_Capacity(capacity);
+
+    q->element_size = element_size;
+    q->stride = (sizeof(atomic_size_t) + element_size + sizeof(atomic_size_t) - 1) & ~(sizeof(atomic_size_t) - 1);
+    q->mask = n - 1;
+    q->cells = malloc(n * q->stride);
+
+    for (size_t i = 0; i < n; i++) {
+        atomic_init(_Queue_Sequence(q, i), i);
+    }
+
+    atomic_init(&q->head, 0);
+    atomic_init(&q->tail, 0);
+    _Queue_InitWaiters(&q->waiters);
+
+}
+
+int Queue_Length(Queue* q) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    return head > tail ? (int) (head - tail) : 0;
+}
+
+// Claims up to count consecutive cells whose sequence is pos + offset.
+// Producers pass an offset of 0, consumers an offset of 1.
+static size_t _Queue_Claim(Queue* q, atomic_size_t* counter, size_t offset, size_t count, size_t* start) {
+
+    size_t pos = atomic_load_explicit(counter, memory_order_relaxed);
+
+    while (1) {
+
+        size_t ready = 0;
+        while (ready < count) {
+            size_t sequence = atomic_load_explicit(_Queue_Sequence(q, pos + ready), memory_order_acquire);
+            if (sequence != pos + ready + offset) {break;}
+            ready++;
+        }
+
+        if (ready == 0) {
+
+            // The first cell is behind us, so the queue is full or empty.
+            size_t sequence = atomic_load_explicit(_Queue_Sequence(q, pos), memory_order_acquire);
+            if ((intptr_t) (sequence - (pos + offset)) < 0) {return 0;}
+
+            // Another thread got there first, so try again from the new position.
+            pos = atomic_load_explicit(counter, memory_order_relaxed);
+            continue;
+
+        }
+
+        if (atomic_compare_exchange_weak_explicit(counter, &pos, pos + ready, memory_order_relaxed, memory_order_relaxed)) {
+            *start = pos;
+            return ready;
+        }
+
+    }
+
+}
+
+bool Queue_Push(Queue* q, void* element) {
+    return Queue_PushMany(q, element, 1) == 1;
+}
+
+bool Queue_Shift(Queue* q, void* buffer) {
+    return Queue_ShiftMany(q, buffer, 1) == 1;
+}
+
+static int _Queue_PushMany(void* queue, void* elements, int count) {
+
+    Queue* q = queue;
+
+    if (count <= 0) {return 0;}
+
+    size_t pos;
+    size_t claimed = _Queue_Claim(q, &q->head, 0, count, &pos);
+
+    // Fill each cell, then hand it over to the consumers.
+    uint8_t* element = elements;
+    for (size_t i = 0; i < claimed; i++) {
+        memcpy(_Queue_Element(q, pos + i), element, q->element_size);
+        atomic_store_explicit(_Queue_Sequence(q, pos + i), pos + i + 1, memory_order_release);
+        element += q->element_size;
+    }
+
+    return (int) claimed;
+
+}
+
+static int _Queue_ShiftMany(void* queue, void* buffer, int count) {
+
+    Queue* q = queue;
+
+    if (count <= 0) {return 0;}
+
+    size_t pos;
+    size_t claimed = _Queue_Claim(q, &q->tail, 1, count, &pos);
+
+    // Empty each cell, then hand it back to the producers one lap later.
+    uint8_t* element = buffer;
+    for (size_t i = 0; i < claimed; i++) {
+        if (element != NULL) {
+            memcpy(element, _Queue_Element(q, pos + i), q->element_size);
+            element += q->element_size;
+        }
+        atomic_store_explicit(_Queue_Sequence(q, pos + i), pos + i + q->mask + 1, memory_order_release);
+    }
+
+    return (int) claimed;
+
+}
+
+int Queue_PushMany(Queue* q, void* elements, int count) {
+    int pushed = _Queue_PushMany(q, elements, count);
+    if (pushed > 0) {_Queue_WakeShifters(&q->waiters);}
+    return pushed;
+}
+
+int Queue_ShiftMany(Queue* q, void* buffer, int count) {
+    int shifted = _Queue_ShiftMany(q, buffer, count);
+    if (shifted > 0) {_Queue_WakePushers(&q->waiters);}
+    return shifted;
+}
+
+void Queue_PushWait(Queue* q, void* element) {
+    _Queue_Wait(q, element, _Queue_PushMany, &q->waiters.push_mutex, &q->waiters.not_full, &q->waiters.pushers);
+    _Queue_WakeShifters(&q->waiters);
+}
+
+void Queue_ShiftWait(Queue* q, void* buffer) {
+    _Queue_Wait(q, buffer, _Queue_ShiftMany, &q->waiters.shift_mutex, &q->waiters.not_empty, &q->waiters.shifters);
+    _Queue_WakePushers(&q->waiters);
+}
+
+void Queue_Free(Queue* q) {
+    free(q->cells);
+    _Queue_FreeWaiters(&q->waiters);
+}
+
+//-----------------------------------------------------------------------------
+// Single-producer single-consumer queue
+//
+// Each side owns one counter and keeps a cached copy of the other side's
+// counter, so it only touches the other side's cache line when the cached
+// copy says the queue is full or empty.
+//-----------------------------------------------------------------------------
+
+void SPSCQueue_Init(SPSCQueue* q, size_t element_size, size_t capacity) {
+
+    size_t n = _Queue_Capacity(capacity);
+
+    q->element_size = element_size;
+    q->mask = n - 1;
+    q->elements = malloc(n * (element_size > 0 ? element_size : 1));
+
+    atomic_init(&q->head, 0);
+    q->cached_tail = 0;
+    atomic_init(&q->tail, 0);
+    q->cached_head = 0;
+    _Queue_InitWaiters(&q->waiters);
+
+}
+
+int SPSCQueue_Length(SPSCQueue* q) {
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    return head > tail ? (int) (head - tail) : 0;
+}
+
+bool SPSCQueue_Push(SPSCQueue* q, void* element) {
+    return SPSCQueue_PushMany(q, element, 1) == 1;
+}
+
+bool SPSCQueue_Shift(SPSCQueue* q, void* buffer) {
+    return SPSCQueue_ShiftMany(q, buffer, 1) == 1;
+}
+
+static int _SPSCQueue_PushMany(void* queue, void* elements, int count) {
+
+    SPSCQueue* q = queue;
+
+    if (count <= 0) {return 0;}
+
+    size_t head = atomic_load_explicit(&q->head, memory_order_relaxed);
+    size_t capacity = q->mask + 1;
+
+    if (head - q->cached_tail + count > capacity) {
+        q->cached_tail = atomic_load_explicit(&q->tail, memory_order_acquire);
+    }
+
+    size_t space = capacity - (head - q->cached_tail);
+    size_t pushed = (size_t) count < space ? (size_t) count : space;
+
+    uint8_t* element = elements;
+    for (size_t i = 0; i < pushed; i++) {
+        memcpy(q->elements + ((head + i) & q->mask) * q->element_size, element, q->element_size);
+        element += q->element_size;
+    }
+
+    // Publish the whole batch with a single store.
+    if (pushed > 0) {atomic_store_explicit(&q->head, head + pushed, memory_order_release);}
+    return (int) pushed;
+
+}
+
+static int _SPSCQueue_ShiftMany(void* queue, void* buffer, int count) {
+
+    SPSCQueue* q = queue;
+
+    if (count <= 0) {return 0;}
+
+    size_t tail = atomic_load_explicit(&q->tail, memory_order_relaxed);
+    if (q->cached_head - tail < (size_t) count) {
+        q->cached_head = atomic_load_explicit(&q->head, memory_order_acquire);
+    }
+
+    size_t available = q->cached_head - tail;
+    size_t shifted = (size_t) count < available ? (size_t) count : available;
+
+    uint8_t* element = buffer;
+    for (size_t i = 0; element != NULL && i < shifted; i++) {
+        memcpy(element, q->elements + ((tail + i) & q->mask) * q->element_size, q->element_size);
+        element += q->element_size;
+    }
+
+    if (shifted > 0) {atomic_store_explicit(&q->tail, tail + shifted, memory_order_release);}
+    return (int) shifted;
+
+}
+
+int SPSCQueue_PushMany(SPSCQueue* q, void* elements, int count) {
+    int pushed = _SPSCQueue_PushMany(q, elements, count);
+    if (pushed > 0) {_Queue_WakeShifters(&q->waiters);}
+    return pushed;
+}
+
+int SPSCQueue_ShiftMany(SPSCQueue* q, void* buffer, int count) {
+    int shifted = _SPSCQueue_ShiftMany(q, buffer, count);
+    if (shifted > 0) {_Queue_WakePushers(&q->waiters);}
+    return shifted;
+}
+
+void SPSCQueue_PushWait(SPSCQueue* q, void* element) {
+    _Queue_Wait(q, element, _SPSCQueue_PushMany, &q->waiters.push_mutex, &q->waiters.not_full, &q->waiters.pushers);
+    _Queue_WakeShifters(&q->waiters);
+}
+
+void SPSCQueue_ShiftWait(SPSCQueue* q, void* buffer) {
+    _Queue_Wait(q, buffer, _SPSCQueue_ShiftMany, &q->waiters.shift_mutex, &q->waiters.not_empty, &q->waiters.shifters);
+    _Queue_WakePushers(&q->waiters);
+}
+
+void SPSCQueue_Free(SPSCQueue* q) {
+    free(q->elements);
+    _Queue_FreeWaiters(&q->waiters);
+}
@@ -0,0 +1,716 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "radixtree.h"
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#define RADIXTREE_PREFIX_BYTES 8
+
+// Children are either nodes or leaves, with leaves told apart by setting the
+// lowest bit of their address. A node holds the bytes its children have in
+// common as a prefix, and the leaf of the key which ends at the node if there
+// is one, so every node has at least two children or a child and a leaf.
+// Leaves hang below the first byte which tells them apart, and hold their
+// whole key, so a search ends by comparing the key with the leaf's.
+//
+// Nodes come in four sizes. Node4 and Node16 keep their key bytes sorted,
+// and Node16 compares a byte with all sixteen at once. Node48 maps each byte
+// to one of 48 children, and Node256 has a child for every byte.
+
+enum {_RADIXTREE_NODE4, _RADIXTREE_NODE16, _RADIXTREE_NODE48, _RADIXTREE_NODE256};
+
+struct _RadixNode {
+    uint8_t type;
+    uint16_t count;
+    size_t prefix_length;
+    union {
+        uint8_t bytes[RADIXTREE_PREFIX_BYTES];
+        uint8_t* heap;
+    } prefix;
+    RadixLeaf* leaf;
+};
+typedef struct _RadixNode _RadixNode;
+
+typedef struct {_RadixNode node; uint8_t keys[4]; void* children[4];} _RadixNode4;
+typedef struct {_RadixNode node; uint8_t keys[16]; void* children[16];} _RadixNode16;
+typedef struct {_RadixNode node; uint8_t index[256]; void* children[48];} _RadixNode48;
+typedef struct {_RadixNode node; void* children[256];} _RadixNode256;
+
+static const size_t _RadixNode_Bytes[] = {sizeof(_RadixNode4), sizeof(_RadixNode16), sizeof(_RadixNode48), sizeof(_RadixNode256)};
+static const int _RadixNode_Capacity[] = {4, 16, 48, 256};
+
+//-----------------------------------------------------------------------------
+// Leaves
+//-----------------------------------------------------------------------------
+
+static inline bool _RadixTree_IsLeaf(void* child) {
+    return (uintptr_t) child & 1;
+}
+
+static inline RadixLeaf* _RadixTree_Leaf(void* child) {
+    return (RadixLeaf*) ((uintptr_t) child & ~(uintptr_t) 1);
+}
+
+static inline void* _RadixTree_Tag(RadixLeaf* leaf) {
+    return (void*) ((uintptr_t) leaf | 1);
+}
+
+static inline uint8_t* _RadixTree_Key(RadixTree* t, RadixLeaf* leaf) {
+    return leaf->data + t->value_size;
+}
+
+static RadixLeaf* _RadixTree_NewLeaf(RadixTree* t, const uint8_t* key, size_t length, void* value) {
+    RadixLeaf* leaf = malloc(sizeof(RadixLeaf) + t->value_size + length);
+    leaf->length = length;
+    memcpy(leaf->data, value, t->value_size);
+    if (length > 0) {memcpy(_RadixTree_Key(t, leaf), key, length);}
+    return leaf;
+}
+
+// Orders byte strings byte by byte, with a string before any longer one it is a prefix of.
+static int _RadixTree_Compare(const uint8_t* a, size_t a_length, const uint8_t* b, size_t b_length) {
+    size_t shared = a_length < b_length ? a_length : b_length;
+    int order = shared > 0 ? memcmp(a, b, shared) : 0;
+    if (order != 0) {return order;}
+    return (a_length > b_length) - (a_length < b_length);
+}
+
+static inline bool _RadixTree_Matches(RadixTree* t, RadixLeaf* leaf, const uint8_t* key, size_t length) {
+    return leaf->length == length && (length == 0 || memcmp(_RadixTree_Key(t, leaf), key, length) == 0);
+}
+
+//-----------------------------------------------------------------------------
+// Nodes
+//-----------------------------------------------------------------------------
+
+static _RadixNode* _RadixNode_New(int type) {
+    _RadixNode* n = calloc(1, _RadixNode_Bytes[type]);
+    n->type = type;
+    return n;
+}
+
+static inline uint8_t* _RadixNode_Prefix(_RadixNode* n) {
+    return n->prefix_length > RADIXTREE_PREFIX_BYTES ? n->prefix.heap : n->prefix.bytes;
+}
+
+// Sets the prefix of a node, which may be taken from the node's own prefix.
+static void _RadixNode_SetPrefix(_RadixNode* n, const uint8_t* bytes, size_t length) {
+
+    uint8_t* heap = n->prefix_length > RADIXTREE_PREFIX_BYTES ? n->prefix.heap : NULL;
+
+    if (length > RADIXTREE_PREFIX_BYTES) {
+        uint8_t* copy = malloc(length);
+        memcpy(copy, bytes, length);
+        n->prefix.heap = copy;
+    }
+    else if (length > 0) {memmove(n->prefix.bytes, bytes, length);}
+
+    n->prefix_length = length;
+    free(heap);
+
+}
+
+// Frees a node, whose children and leaf have been freed or moved elsewhere.
+static void _RadixNode_Free(_RadixNode* n) {
+    if (n->prefix_length > RADIXTREE_PREFIX_BYTES) {free(n->prefix.heap);}
+    free(n);
+}
+
+static inline void _RadixNode_Sorted(_RadixNode* n, uint8_t** keys, void*** children) {
+    if (n->type == _RADIXTREE_NODE4) {
+        *keys = ((_RadixNode4*) n)->keys;
+        *children = ((_RadixNode4*) n)->children;
+    }
+    else {
+        *keys = ((_RadixNode16*) n)->keys;
+        *children = ((_RadixNode16*) n)->children;
+    }
+}
+
+// Returns the address of the child under a byte, or NULL if there is none.
+static void** _RadixNode_Find(_RadixNode* n, uint8_t byte) {
+
+    switch (n->type) {
+
+        case _RADIXTREE_NODE4: {
+            _RadixNode4* m = (_RadixNode4*) n;
+            for (int i = 0; i < n->count; i++) {
+                if (m->keys[i] == byte) {return &m->children[i];}
+            }
+            return NULL;
+        }
+
+        case _RADIXTREE_NODE16: {
+            _RadixNode16* m = (_RadixNode16*) n;
+#ifdef __SSE2__
+            __m128i matches = _mm_cmpeq_epi8(_mm_set1_epi8((char) byte), _mm_loadu_si128((const __m128i*) m->keys));
+            int mask = _mm_movemask_epi8(matches) & ((1 << n->count) - 1);
+            return mask != 0 ? &m->children[__builtin_ctz(mask)] : NULL;
+#else
+            for (int i = 0; i < n->count; i++) {
+                if (m->keys[i] == byte) {return &m->children[i];}
+            }
+            return NULL;
+#endif
+        }
+
+        case _RADIXTREE_NODE48: {
+            _RadixNode48* m = (_RadixNode48*) n;
+            return m->index[byte] != 0 ? &m->children[m->index[byte] - 1] : NULL;
+        }
+
+        default: {
+            _RadixNode256* m = (_RadixNode256*) n;
+            return m->children[byte] != NULL ? &m->children[byte] : NULL;
+        }
+
+    }
+
+}
+
+// Returns the child under the smallest byte not less than from, or NULL if there is none.
+static void* _RadixNode_Next(_RadixNode* n, int from, uint8_t* byte) {
+
+    switch (n->type) {
+
+        case _RADIXTREE_NODE4:
+        case _RADIXTREE_NODE16: {
+            uint8_t* keys;
+            void** children;
+            _RadixNode_Sorted(n, &keys, &children);
+            for (int i = 0; i < n->count; i++) {
+                if (keys[i] >= from) {
+                    *byte = keys[i];
+                    return children[i];
+                }
+            }
+            return NULL;
+        }
+
+        case _RADIXTREE_NODE48: {
+            _RadixNode48* m = (_RadixNode48*) n;
+            for (int b = from; b < 256; b++) {
+                if (m->index[b] != 0) {
+                    *byte = (uint8_t) b;
+                    return m->children[m->index[b] - 1];
+                }
+            }
+            return NULL;
+        }
+
+        default: {
+            _RadixNode256* m = (_RadixNode256*) n;
+            for (int b = from; b < 256; b++) {
+                if (m->children[b] != NULL) {
+                    *byte = (uint8_t) b;
+                    return m->children[b];
+                }
+            }
+            return NULL;
+        }
+
+    }
+
+}
+
+// Adds a child under a byte to a node which has room for it.
+static void _RadixNode_Insert(_RadixNode* n, uint8_t byte, void* child) {
+
+    switch (n->type) {
+
+        case _RADIXTREE_NODE4:
+        case _RADIXTREE_NODE16: {
+            uint8_t* keys;
+            void** children;
+            _RadixNode_Sorted(n, &keys, &children);
+            int i = 0;
+            while (i < n->count && keys[i] < byte) {i++;}
+            memmove(keys + i + 1, keys + i, (n->count - i) * sizeof(uint8_t));
+            memmove(children + i + 1, children + i, (n->count - i) * sizeof(void*));
+            keys[i] = byte;
+            children[i] = child;
+            break;
+        }
+
+        case _RADIXTREE_NODE48: {
+            _RadixNode48* m = (_RadixNode48*) n;
+            m->children[n->count] = child;
+            m->index[byte] = (uint8_t) (n->count + 1);
+            break;
+        }
+
+        default:
+            ((_RadixNode256*) n)->children[byte] = child;
+
+    }
+
+    n->count++;
+
+}
+
+// Moves the prefix, leaf and children of a node into a new node of another size.
+static _RadixNode* _RadixNode_Convert(_RadixNode* n, int type) {
+
+    _RadixNode* m = _RadixNode_New(type);
+    m->prefix_length = n->prefix_length;
+    m->prefix = n->prefix;
+    m->leaf = n->leaf;
+
+    uint8_t byte;
+    void* child;
+    for (int from = 0; from < 256 && (child = _RadixNode_Next(n, from, &byte)) != NULL; from = byte + 1) {
+        _RadixNode_Insert(m, byte, child);
+    }
+
+    free(n);
+    return m;
+
+}
+
+// Adds a child under a byte to the node at ref, growing the node if it is full.
+static void _RadixNode_Add(void** ref, uint8_t byte, void* child) {
+    _RadixNode* n = *ref;
+    if (n->count == _RadixNode_Capacity[n->type]) {*ref = n = _RadixNode_Convert(n, n->type + 1);}
+    _RadixNode_Insert(n, byte, child);
+}
+
+static void _RadixNode_Delete(_RadixNode* n, uint8_t byte) {
+
+    switch (n->type) {
+
+        case _RADIXTREE_NODE4:
+        case _RADIXTREE_NODE16: {
+            uint8_t* keys;
+            void** children;
+            _RadixNode_Sorted(n, &keys, &children);
+            int i = 0;
+            while (keys[i] != byte) {i++;}
+            memmove(keys + i, keys + i + 1, (n->count - i - 1) * sizeof(uint8_t));
+            memmove(children + i, children + i + 1, (n->count - i - 1) * sizeof(void*));
+            break;
+        }
+
+        // The last child fills the hole, so the children stay packed.
+        case _RADIXTREE_NODE48: {
+            _RadixNode48* m = (_RadixNode48*) n;
+            int slot = m->index[byte] - 1;
+            int last = n->count - 1;
+            m->index[byte] = 0;
+            if (slot != last) {
+                m->children[slot] = m->children[last];
+                for (int b = 0; b < 256; b++) {
+                    if (m->index[b] == last + 1) {
+                        m->index[b] = (uint8_t) (slot + 1);
+                        break;
+                    }
+                }
+            }
+            m->children[last] = NULL;
+            break;
+        }
+
+        default:
+            ((_RadixNode256*) n)->children[byte] = NULL;
+
+    }
+
+    n->count--;
+
+}
+
+// Restores the shape of the node at ref after it lost its leaf or a child. A node left with only
+// a leaf becomes the leaf, one left with a single child merges into it, and sparse nodes shrink.
+static void _RadixNode_Shrink(void** ref) {
+
+    _RadixNode* n = *ref;
+
+    if (n->count == 0) {
+        *ref = _RadixTree_Tag(n->leaf);
+        _RadixNode_Free(n);
+        return;
+    }
+
+    if (n->count == 1 && n->leaf == NULL) {
+        uint8_t byte;
+        void* child = _RadixNode_Next(n, 0, &byte);
+        if (!_RadixTree_IsLeaf(child)) {
+            _RadixNode* c = child;
+            size_t length = n->prefix_length + 1 + c->prefix_length;
+            uint8_t* prefix = malloc(length);
+            memcpy(prefix, _RadixNode_Prefix(n), n->prefix_length);
+            prefix[n->prefix_length] = byte;
+            memcpy(prefix + n->prefix_length + 1, _RadixNode_Prefix(c), c->prefix_length);
+            _RadixNode_SetPrefix(c, prefix, length);
+            free(prefix);
+        }
+        *ref = child;
+        _RadixNode_Free(n);
+        return;
+    }
+
+    // Shrink well below the next size down, so a node on the boundary does not keep changing size.
+    if (n->type == _RADIXTREE_NODE256 && n->count <= 36) {*ref = _RadixNode_Convert(n, _RADIXTREE_NODE48);}
+    else if (n->type == _RADIXTREE_NODE48 && n->count <= 12) {*ref = _RadixNode_Convert(n, _RADIXTREE_NODE16);}
+    else if (n->type == _RADIXTREE_NODE16 && n->count <= 3) {*ref = _RadixNode_Convert(n, _RADIXTREE_NODE4);}
+
+}
+
+// Puts a leaf under a node whose prefix ends at depth.
+static void _RadixNode_Attach(RadixTree* t, _RadixNode* n, RadixLeaf* leaf, size_t depth) {
+    if (leaf->length == depth) {n->leaf = leaf;}
+    else {_RadixNode_Insert(n, _RadixTree_Key(t, leaf)[depth], _RadixTree_Tag(leaf));}
+}
+
+// Returns how many bytes of a node's prefix match the key from depth onwards.
+static inline size_t _RadixNode_Match(_RadixNode* n, const uint8_t* key, size_t length, size_t depth) {
+    uint8_t* prefix = _RadixNode_Prefix(n);
+    size_t limit = n->prefix_length < length - depth ? n->prefix_length : length - depth;
+    size_t i = 0;
+    while (i < limit && prefix[i] == key[depth + i]) {i++;}
+    return i;
+}
+
+static void _RadixTree_FreeChild(void* child) {
+
+    if (child == NULL) {return;}
+    if (_RadixTree_IsLeaf(child)) {
+        free(_RadixTree_Leaf(child));
+        return;
+    }
+
+    _RadixNode* n = child;
+    uint8_t byte;
+    void* next;
+    for (int from = 0; from < 256 && (next = _RadixNode_Next(n, from, &byte)) != NULL; from = byte + 1) {
+        _RadixTree_FreeChild(next);
+    }
+    free(n->leaf);
+    _RadixNode_Free(n);
+
+}
+
+//-----------------------------------------------------------------------------
+// Tree
+//-----------------------------------------------------------------------------
+
+void RadixTree_Init(RadixTree* t, size_t value_size) {
+    t->value_size = value_size;
+    t->size = 0;
+    t->root = NULL;
+}
+
+size_t RadixTree_Size(RadixTree* t) {
+    return t->size;
+}
+
+static RadixLeaf* _RadixTree_Lookup(RadixTree* t, const uint8_t* key, size_t length) {
+
+    void* child = t->root;
+    size_t depth = 0;
+
+    while (child != NULL) {
+
+        if (_RadixTree_IsLeaf(child)) {
+            RadixLeaf* leaf = _RadixTree_Leaf(child);
+            return _RadixTree_Matches(t, leaf, key, length) ? leaf : NULL;
+        }
+
+        _RadixNode* n = child;
+        if (_RadixNode_Match(n, key, length, depth) != n->prefix_length) {return NULL;}
+        depth += n->prefix_length;
+        if (depth == length) {return n->leaf;}
+
+        void** next = _RadixNode_Find(n, key[depth]);
+        if (next == NULL) {return NULL;}
+        child = *next;
+        depth++;
+
+    }
+
+    return NULL;
+
+}
+
+bool RadixTree_Get(RadixTree* t, const void* key, size_t length, void* buffer) {
+    RadixLeaf* leaf = _RadixTree_Lookup(t, key, length);
+    if (leaf == NULL) {return 0;}
+    memcpy(buffer, leaf->data, t->value_size);
+    return 1;
+}
+
+void RadixTree_Put(RadixTree* t, const void* bytes, size_t length, void* value) {
+
+    const uint8_t* key = bytes;
+    void** ref = &t->root;
+    size_t depth = 0;
+
+    while (1) {
+
+        if (*ref == NULL) {
+            *ref = _RadixTree_Tag(_RadixTree_NewLeaf(t, key, length, value));
+            t->size++;
+            return;
+        }
+
+        // A leaf with another key is split into a node holding both, with the bytes they share as its prefix.
+        if (_RadixTree_IsLeaf(*ref)) {
+
+            RadixLeaf* leaf = _RadixTree_Leaf(*ref);
+            if (_RadixTree_Matches(t, leaf, key, length)) {
+                memcpy(leaf->data, value, t->value_size);
+                return;
+            }
+
+            uint8_t* other = _RadixTree_Key(t, leaf);
+            size_t limit = (leaf->length < length ? leaf->length : length) - depth;
+            size_t common = 0;
+            while (common < limit && other[depth + common] == key[depth + common]) {common++;}
+
+            _RadixNode* n = _RadixNode_New(_RADIXTREE_NODE4);
+            _RadixNode_SetPrefix(n, key + depth, common);
+            _RadixNode_Attach(t, n, leaf, depth + common);
+            _RadixNode_Attach(t, n, _RadixTree_NewLeaf(t, key, length, value), depth + common);
+            *ref = n;
+            t->size++;
+            return;
+
+        }
+
+        // A node whose prefix differs from the key gets a new parent holding the part that matches.
+        _RadixNode* n = *ref;
+        size_t match = _RadixNode_Match(n, key, length, depth);
+        if (match < n->prefix_length) {
+
+            uint8_t* prefix = _RadixNode_Prefix(n);
+            _RadixNode* parent = _RadixNode_New(_RADIXTREE_NODE4);
+            _RadixNode_SetPrefix(parent, prefix, match);
+
+            uint8_t byte = prefix[match];
+            _RadixNode_SetPrefix(n, prefix + match + 1, n->prefix_length - match - 1);
+            _RadixNode_Insert(parent, byte, n);
+            _RadixNode_Attach(t, parent, _RadixTree_NewLeaf(t, key, length, value), depth + match);
+
+            *ref = parent;
+            t->size++;
+            return;
+
+        }
+
+        depth += n->prefix_length;
+        if (depth == length) {
+            if (n->leaf != NULL) {memcpy(n->leaf->data, value, t->value_size);}
+            else {
+                n->leaf = _RadixTree_NewLeaf(t, key, length, value);
+                t->size++;
+            }
+            return;
+        }
+
+        void** next = _RadixNode_Find(n, key[depth]);
+        if (next == NULL) {
+            _RadixNode_Add(ref, key[depth], _RadixTree_Tag(_RadixTree_NewLeaf(t, key, length, value)));
+            t->size++;
+            return;
+        }
+
+        ref = next;
+        depth++;
+
+    }
+
+}
+
+bool RadixTree_Remove(RadixTree* t, const void* bytes, size_t length) {
+
+    const uint8_t* key = bytes;
+    void** ref = &t->root;
+    size_t depth = 0;
+
+    if (*ref == NULL) {return 0;}
+    if (_RadixTree_IsLeaf(*ref)) {
+        RadixLeaf* leaf = _RadixTree_Leaf(*ref);
+        if (!_RadixTree_Matches(t, leaf, key, length)) {return 0;}
+        free(leaf);
+        *ref = NULL;
+        t->size--;
+        return 1;
+    }
+
+    // Only the node which loses the key changes shape, the nodes above it keep their children.
+    while (1) {
+
+        _RadixNode* n = *ref;
+        if (_RadixNode_Match(n, key, length, depth) != n->prefix_length) {return 0;}
+        depth += n->prefix_length;
+
+        if (depth == length) {
+            if (n->leaf == NULL) {return 0;}
+            free(n->leaf);
+            n->leaf = NULL;
+            break;
+        }
+
+        void** next = _RadixNode_Find(n, key[depth]);
+        if (next == NULL) {return 0;}
+
+        if (_RadixTree_IsLeaf(*next)) {
+            RadixLeaf* leaf = _RadixTree_Leaf(*next);
+            if (!_RadixTree_Matches(t, leaf, key, length)) {return 0;}
+            free(leaf);
+            _RadixNode_Delete(n, key[depth]);
+            break;
+        }
+
+        ref = next;
+        depth++;
+
+    }
+
+    _RadixNode_Shrink(ref);
+    t->size--;
+    return 1;
+
+}
+
+bool RadixTree_LongestPrefix(RadixTree* t, const void* bytes, size_t length, size_t* match, void* buffer) {
+
+    const uint8_t* key = bytes;
+    RadixLeaf* best = NULL;
+    void* child = t->root;
+    size_t depth = 0;
+
+    while (child != NULL) {
+
+        if (_RadixTree_IsLeaf(child)) {
+            RadixLeaf* leaf = _RadixTree_Leaf(child);
+            if (leaf->length <= length && (leaf->length == 0 || memcmp(_RadixTree_Key(t, leaf), key, leaf->length) == 0)) {best = leaf;}
+            break;
+        }
+
+        _RadixNode* n = child;
+        if (_RadixNode_Match(n, key, length, depth) != n->prefix_length) {break;}
+        depth += n->prefix_length;
+        if (n->leaf != NULL) {best = n->leaf;}
+        if (depth == length) {break;}
+
+        void** next = _RadixNode_Find(n, key[depth]);
+        if (next == NULL) {break;}
+        child = *next;
+        depth++;
+
+    }
+
+    if (best == NULL) {return 0;}
+    if (match != NULL) {*match = best->length;}
+    memcpy(buffer, best->data, t->value_size);
+    return 1;
+
+}
+
+static RadixLeaf* _RadixTree_Minimum(void* child) {
+    uint8_t byte;
+    while (!_RadixTree_IsLeaf(child)) {
+        _RadixNode* n = child;
+        if (n->leaf != NULL) {return n->leaf;}
+        child = _RadixNode_Next(n, 0, &byte);
+    }
+    return _RadixTree_Leaf(child);
+}
+
+// Returns the smallest leaf below child whose key is greater than, or equal to if inclusive, the given key,
+// where every key below child shares the first depth bytes of the given key.
+static RadixLeaf* _RadixTree_Bound(RadixTree* t, void* child, const uint8_t* key, size_t length, size_t depth, bool inclusive) {
+
+    if (child == NULL) {return NULL;}
+    if (_RadixTree_IsLeaf(child)) {
+        RadixLeaf* leaf = _RadixTree_Leaf(child);
+        int order = _RadixTree_Compare(_RadixTree_Key(t, leaf), leaf->length, key, length);
+        return order > 0 || (inclusive && order == 0) ? leaf : NULL;
+    }
+
+    // Past the first byte where the prefix and key differ, the whole node is either above or below the key.
+    _RadixNode* n = child;
+    size_t match = _RadixNode_Match(n, key, length, depth);
+    if (match < n->prefix_length) {
+        if (depth + match == length || _RadixNode_Prefix(n)[match] > key[depth + match]) {return _RadixTree_Minimum(n);}
+        return NULL;
+    }
+    depth += n->prefix_length;
+
+    uint8_t byte;
+    if (depth == length) {
+        if (n->leaf != NULL && inclusive) {return n->leaf;}
+        return _RadixTree_Minimum(_RadixNode_Next(n, 0, &byte));
+    }
+
+    void** next = _RadixNode_Find(n, key[depth]);
+    if (next != NULL) {
+        RadixLeaf* leaf = _RadixTree_Bound(t, *next, key, length, depth + 1, inclusive);
+        if (leaf != NULL) {return leaf;}
+    }
+
+    void* after = _RadixNode_Next(n, key[depth] + 1, &byte);
+    return after != NULL ? _RadixTree_Minimum(after) : NULL;
+
+}
+
+RadixTreeIterator RadixTree_First(RadixTree* t) {
+    return RadixTree_Prefix(t, NULL, 0);
+}
+
+RadixTreeIterator RadixTree_Prefix(RadixTree* t, const void* prefix, size_t length) {
+
+    RadixTreeIterator it = {t, _RadixTree_Bound(t, t->root, prefix, length, 0, 1), length};
+
+    if (it.leaf != NULL && length > 0) {
+        if (it.leaf->length < length || memcmp(_RadixTree_Key(t, it.leaf), prefix, length) != 0) {it.leaf = NULL;}
+    }
+    return it;
+
+}
+
+RadixTreeIterator RadixTree_LowerBound(RadixTree* t, const void* key, size_t length) {
+    RadixTreeIterator it = {t, _RadixTree_Bound(t, t->root, key, length, 0, 1), 0};
+    return it;
+}
+
+bool RadixTreeIterator_Valid(RadixTreeIterator* it) {
+    return it->leaf != NULL;
+}
+
+void RadixTreeIterator_Next(RadixTreeIterator* it) {
+
+    RadixTree* t = it->tree;
+    RadixLeaf* current = it->leaf;
+    RadixLeaf* next = _RadixTree_Bound(t, t->root, _RadixTree_Key(t, current), current->length, 0, 0);
+
+    // The keys with the prefix are contiguous, so the first one without it ends the iteration.
+    if (next != NULL && it->prefix_length > 0) {
+        if (next->length < it->prefix_length || memcmp(_RadixTree_Key(t, next), _RadixTree_Key(t, current), it->prefix_length) != 0) {next = NULL;}
+    }
+    it->leaf = next;
+
+}
+
+const void* RadixTreeIterator_Key(RadixTreeIterator* it, size_t* length) {
+    if (length != NULL) {*length = it->leaf->length;}
+    return _RadixTree_Key(it->tree, it->leaf);
+}
+
+void* RadixTreeIterator_Value(RadixTreeIterator* it) {
+    return it->leaf->data;
+}
+
+void RadixTree_Clear(RadixTree* t) {
+    size_t value_size = t->value_size;
+    RadixTree_Free(t);
+    RadixTree_Init(t, value_size);
+}
+
+void RadixTree_Free(RadixTree* t) {
+    _RadixTree_FreeChild(t->root);
+}
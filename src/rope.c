@@ -0,0 +1,374 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "rope.h"
+
+#define ROPE_CHUNK_BYTES 1024
+#define ROPE_MIN_CHUNK 4
+
+static inline int _Rope_Total(RopeNode* node) {
+    return node == NULL ? 0 : node->total;
+}
+
+static inline void _Rope_Update(RopeNode* node) {
+    node->total = node->count + _Rope_Total(node->left) + _Rope_Total(node->right);
+}
+
+static inline uint8_t* _Rope_Element(Rope* r, RopeNode* node, int i) {
+    return node->data + i * r->element_size;
+}
+
+uint64_t _Rope_Random(Rope* r) {
+    r->state ^= r->state << 13;
+    r->state ^= r->state >> 7;
+    r->state ^= r->state << 17;
+    return r->state;
+}
+
+RopeNode* _Rope_NewNode(Rope* r, uint64_t priority) {
+    RopeNode* node = malloc(sizeof(RopeNode) + r->chunk * r->element_size);
+    node->left = NULL;
+    node->right = NULL;
+    node->priority = priority;
+    node->count = 0;
+    node->total = 0;
+    return node;
+}
+
+// Frees a treap without recursing, by rotating each left child up until the node has none.
+void _Rope_FreeNode(RopeNode* node) {
+    while (node != NULL) {
+        RopeNode* next = node->left;
+        if (next == NULL) {
+            next = node->right;
+            free(node);
+        } else {
+            node->left = next->right;
+            next->right = node;
+        }
+        node = next;
+    }
+}
+
+// Joins two treaps, where every element of a comes before every element of b.
+RopeNode* _Rope_Merge(RopeNode* a, RopeNode* b) {
+
+    if (a == NULL) {return b;}
+    if (b == NULL) {return a;}
+
+    if (a->priority > b->priority) {
+        a->right = _Rope_Merge(a->right, b);
+        _Rope_Update(a);
+        return a;
+    }
+
+    b->left = _Rope_Merge(a, b->left);
+    _Rope_Update(b);
+    return b;
+
+}
+
+// Splits a treap so the first index elements end up in left, and the rest in right.
+void _Rope_Split(Rope* r, RopeNode* node, int index, RopeNode** left, RopeNode** right) {
+
+    if (node == NULL) {
+        *left = NULL;
+        *right = NULL;
+        return;
+    }
+
+    int before = _Rope_Total(node->left);
+
+    if (index <= before) {
+        _Rope_Split(r, node->left, index, left, &node->left);
+        _Rope_Update(node);
+        *right = node;
+    }
+
+    else if (index >= before + node->count) {
+        _Rope_Split(r, node->right, index - before - node->count, &node->right, right);
+        _Rope_Update(node);
+        *left = node;
+    }
+
+    // The split falls inside this chunk, so cut the chunk in two. The new node gets a
+    // priority of its own, as copying one would leave every chunk with the same priority
+    // and the treap a chain, and is merged in front of the right subtree.
+    else {
+        int offset = index - before;
+        RopeNode* tail = _Rope_NewNode(r, _Rope_Random(r));
+        tail->count = node->count - offset;
+        memcpy(tail->data, _Rope_Element(r, node, offset), tail->count * r->element_size);
+        _Rope_Update(tail);
+
+        RopeNode* rest = node->right;
+        node->count = offset;
+        node->right = NULL;
+        _Rope_Update(node);
+
+        *left = node;
+        *right = _Rope_Merge(tail, rest);
+    }
+
+}
+
+// Finds the chunk holding an index, and the index of the first element of that chunk.
+RopeNode* _Rope_Locate(Rope* r, int index, int* start) {
+
+    RopeNode* node = r->root;
+    *start = 0;
+    while (node != NULL) {
+        int before = _Rope_Total(node->left);
+        if (index < before) {node = node->left;}
+        else if (index < before + node->count) {
+            *start += before;
+            return node;
+        }
+        else {
+            index -= before + node->count;
+            *start += before + node->count;
+            node = node->right;
+        }
+    }
+
+    return NULL;
+
+}
+
+// Finds the chunk holding an index.
+RopeNode* _Rope_Find(Rope* r, int index, int* offset) {
+
+    RopeNode* node = r->root;
+    while (node != NULL) {
+        int before = _Rope_Total(node->left);
+        if (index < before) {node = node->left;}
+        else if (index < before + node->count) {
+            *offset = index - before;
+            return node;
+        }
+        else {
+            index -= before + node->count;
+            node = node->right;
+        }
+    }
+
+    return NULL;
+
+}
+
+void Rope_Init(Rope* r, size_t element_size) {
+
+    r->element_size = element_size;
+    r->chunk = element_size > 0 ? ROPE_CHUNK_BYTES / element_size : ROPE_CHUNK_BYTES;
+    if (r->chunk < ROPE_MIN_CHUNK) {r->chunk = ROPE_MIN_CHUNK;}
+
+    r->root = NULL;
+    r->state = (uint64_t) (uintptr_t) r ^ UINT64_C(0x9e3779b97f4a7c15);
+    if (r->state == 0) {r->state = 1;}
+
+}
+
+int Rope_Length(Rope* r) {
+    return _Rope_Total(r->root);
+}
+
+bool Rope_Get(Rope* r, int index, void* buffer) {
+    if (index < 0 || index >= Rope_Length(r) || buffer == NULL) {return 0;}
+    int offset = 0;
+    RopeNode* node = _Rope_Find(r, index, &offset);
+    memcpy(buffer, _Rope_Element(r, node, offset), r->element_size);
+    return 1;
+}
+
+bool Rope_Set(Rope* r, int index, void* element) {
+    if (index < 0 || index >= Rope_Length(r)) {return 0;}
+    int offset = 0;
+    RopeNode* node = _Rope_Find(r, index, &offset);
+    memcpy(_Rope_Element(r, node, offset), element, r->element_size);
+    return 1;
+}
+
+void* Rope_Chunk(Rope* r, int index, int* count) {
+
+    if (index < 0 || index >= Rope_Length(r)) {
+        if (count != NULL) {*count = 0;}
+        return NULL;
+    }
+
+    int offset = 0;
+    RopeNode* node = _Rope_Find(r, index, &offset);
+
+    if (count != NULL) {*count = node->count - offset;}
+    return _Rope_Element(r, node, offset);
+
+}
+
+// Inserts into the chunk holding the index if it has room, and fixes the totals on the way out.
+// An index just past the end of a chunk may be appended to it. If the chunk is full,
+// full is set to the index of its middle element and nothing is inserted.
+bool _Rope_InsertInPlace(Rope* r, RopeNode* node, int index, void* element, int start, int* full) {
+
+    int before = _Rope_Total(node->left);
+    bool inserted;
+
+    if (index < before) {inserted = _Rope_InsertInPlace(r, node->left, index, element, start, full);}
+    else if (index <= before + node->count) {
+        if (node->count == r->chunk) {
+            *full = start + before + node->count / 2;
+            return 0;
+        }
+        int offset = index - before;
+        memmove(_Rope_Element(r, node, offset + 1), _Rope_Element(r, node, offset), (node->count - offset) * r->element_size);
+        memcpy(_Rope_Element(r, node, offset), element, r->element_size);
+        node->count++;
+        inserted = 1;
+    }
+    else {inserted = _Rope_InsertInPlace(r, node->right, index - before - node->count, element, start + before + node->count, full);}
+
+    if (inserted) {node->total++;}
+    return inserted;
+
+}
+
+bool Rope_Add(Rope* r, int index, void* element) {
+
+    if (index < 0 || index > Rope_Length(r)) {return 0;}
+
+    if (r->root == NULL) {
+        r->root = _Rope_NewNode(r, _Rope_Random(r));
+        memcpy(r->root->data, element, r->element_size);
+        r->root->count = 1;
+        r->root->total = 1;
+        return 1;
+    }
+
+    // A full chunk is cut in half, which leaves room on both sides of the index.
+    int full;
+    while (!_Rope_InsertInPlace(r, r->root, index, element, 0, &full)) {
+        RopeNode* left;
+        RopeNode* right;
+        _Rope_Split(r, r->root, full, &left, &right);
+        r->root = _Rope_Merge(left, right);
+    }
+
+    return 1;
+
+}
+
+void Rope_Push(Rope* r, void* element) {
+    Rope_Add(r, Rope_Length(r), element);
+}
+
+RopeNode* _Rope_RemoveAt(Rope* r, RopeNode* node, int index) {
+
+    int before = _Rope_Total(node->left);
+
+    if (index < before) {node->left = _Rope_RemoveAt(r, node->left, index);}
+    else if (index >= before + node->count) {node->right = _Rope_RemoveAt(r, node->right, index - before - node->count);}
+    else {
+
+        int offset = index - before;
+        memmove(_Rope_Element(r, node, offset), _Rope_Element(r, node, offset + 1), (node->count - offset - 1) * r->element_size);
+        node->count--;
+
+        // Empty chunks are dropped from the tree.
+        if (node->count == 0) {
+            RopeNode* merged = _Rope_Merge(node->left, node->right);
+            free(node);
+            return merged;
+        }
+
+    }
+
+    _Rope_Update(node);
+    return node;
+
+}
+
+// Joins two neighbouring chunks into the first, given where the first starts and how long both are.
+void _Rope_Join(Rope* r, int start, int first_count, int second_count) {
+
+    RopeNode* left;
+    RopeNode* first;
+    RopeNode* second;
+    RopeNode* rest;
+
+    // Every cut falls on a chunk boundary, so the middle treaps are single chunks.
+    _Rope_Split(r, r->root, start, &left, &rest);
+    _Rope_Split(r, rest, first_count, &first, &rest);
+    _Rope_Split(r, rest, second_count, &second, &rest);
+
+    memcpy(_Rope_Element(r, first, first->count), second->data, second->count * r->element_size);
+    first->count += second->count;
+    _Rope_Update(first);
+    free(second);
+
+    r->root = _Rope_Merge(_Rope_Merge(left, first), rest);
+
+}
+
+// Once the chunk around an index falls below a quarter full, joins it with a neighbour it fits in.
+void _Rope_Rebalance(Rope* r, int index) {
+
+    int length = Rope_Length(r);
+    if (length == 0) {return;}
+    if (index >= length) {index = length - 1;}
+
+    int start;
+    RopeNode* node = _Rope_Locate(r, index, &start);
+    if (node->count >= r->chunk / 4) {return;}
+
+    int other_start;
+    if (start + node->count < length) {
+        RopeNode* next = _Rope_Locate(r, start + node->count, &other_start);
+        if (node->count + next->count <= r->chunk) {
+            _Rope_Join(r, start, node->count, next->count);
+            return;
+        }
+    }
+
+    if (start > 0) {
+        RopeNode* prev = _Rope_Locate(r, start - 1, &other_start);
+        if (prev->count + node->count <= r->chunk) {_Rope_Join(r, other_start, prev->count, node->count);}
+    }
+
+}
+
+bool Rope_Remove(Rope* r, int index) {
+
+    if (index < 0 || index >= Rope_Length(r)) {return 0;}
+    r->root = _Rope_RemoveAt(r, r->root, index);
+    _Rope_Rebalance(r, index);
+    return 1;
+
+}
+
+bool Rope_Split(Rope* r, int index, Rope* right) {
+
+    if (index < 0 || index > Rope_Length(r)) {return 0;}
+
+    Rope_Init(right, r->element_size);
+    _Rope_Split(r, r->root, index, &r->root, &right->root);
+    return 1;
+
+}
+
+bool Rope_Concat(Rope* r, Rope* other) {
+
+    if (r == other || r->element_size != other->element_size) {return 0;}
+
+    r->root = _Rope_Merge(r->root, other->root);
+    other->root = NULL;
+    return 1;
+
+}
+
+void Rope_Clear(Rope* r) {
+    _Rope_FreeNode(r->root);
+    r->root = NULL;
+}
+
+void Rope_Free(Rope* r) {
+    _Rope_FreeNode(r->root);
+}
@@ -0,0 +1,206 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include <unistd.h>
+#include "threadpool.h"
+
+// The pool is a single process wide set of workers. Callers are serialised by
+// the lock, and every call to ThreadPool_ParallelFor is one generation: the
+// caller publishes the job, wakes the workers, drains task indices alongside
+// them, then waits until every worker has finished its share.
+static struct {
+
+    once_flag once;
+    mtx_t lock;
+    mtx_t mutex;
+    cnd_t wake;
+    cnd_t done;
+
+    thrd_t* workers;
+    int workers_length;
+    int threads;
+    bool started;
+    bool stop;
+
+    uint64_t generation;
+    uint64_t started_generation;
+    int busy;
+    int tasks;
+    void (*task)(int, void*);
+    void* arg;
+    atomic_int next;
+
+} _ThreadPool = {.once = ONCE_FLAG_INIT};
+
+// Set on threads which are running tasks, so nested calls run in place.
+static _Thread_local bool _ThreadPool_Inside = 0;
+
+static void _ThreadPool_Init() {
+    mtx_init(&_ThreadPool.lock, mtx_plain);
+    mtx_init(&_ThreadPool.mutex, mtx_plain);
+    cnd_init(&_ThreadPool.wake);
+    cnd_init(&_ThreadPool.done);
+    _ThreadPool.threads = 0;
+}
+
+static int _ThreadPool_Default() {
+#ifdef _SC_NPROCESSORS_ONLN
+    long processors = sysconf(_SC_NPROCESSORS_ONLN);
+    if (processors > 0) {return (int) processors;}
+#endif
+    return 1;
+}
+
+static void _ThreadPool_Drain(int tasks, void (*task)(int, void*), void* arg) {
+    int index;
+    while ((index = atomic_fetch_add_explicit(&_ThreadPool.next, 1, memory_order_relaxed)) < tasks) {
+        task(index, arg);
+    }
+}
+
+static int _ThreadPool_Worker(void* unused) {
+
+    (void) unused;
+    _ThreadPool_Inside = 1;
+
+    // Only jobs published after the pool started belong to this worker.
+    mtx_lock(&_ThreadPool.mutex);
+    uint64_t seen = _ThreadPool.started_generation;
+
+    while (1) {
+
+        while (!_ThreadPool.stop && _ThreadPool.generation == seen) {
+            cnd_wait(&_ThreadPool.wake, &_ThreadPool.mutex);
+        }
+        if (_ThreadPool.stop) {break;}
+
+        seen = _ThreadPool.generation;
+        int tasks = _ThreadPool.tasks;
+        void (*task)(int, void*) = _ThreadPool.task;
+        void* arg = _ThreadPool.arg;
+        mtx_unlock(&_ThreadPool.mutex);
+
+        _ThreadPool_Drain(tasks, task, arg);
+
+        mtx_lock(&_ThreadPool.mutex);
+        _ThreadPool.busy--;
+        if (_ThreadPool.busy == 0) {cnd_signal(&_ThreadPool.done);}
+
+    }
+
+    mtx_unlock(&_ThreadPool.mutex);
+    return 0;
+
+}
+
+// Stops and joins every worker. The caller must hold the lock.
+static void _ThreadPool_Stop() {
+
+    if (!_ThreadPool.started) {return;}
+
+    mtx_lock(&_ThreadPool.mutex);
+    _ThreadPool.stop = 1;
+    cnd_broadcast(&_ThreadPool.wake);
+    mtx_unlock(&_ThreadPool.mutex);
+
+    for (int i = 0; i < _ThreadPool.workers_length; i++) {
+        thrd_join(_ThreadPool.workers[i], NULL);
+    }
+
+    free(_ThreadPool.workers);
+    _ThreadPool.workers = NULL;
+    _ThreadPool.workers_length = 0;
+    _ThreadPool.stop = 0;
+    _ThreadPool.started = 0;
+
+}
+
+// Starts the workers if they are not running yet. The caller must hold the lock.
+static void _ThreadPool_Start() {
+
+    if (_ThreadPool.started) {return;}
+    if (_ThreadPool.threads < 1) {_ThreadPool.threads = _ThreadPool_Default();}
+
+    int length = _ThreadPool.threads - 1;
+    _ThreadPool.workers = malloc((length > 0 ? length : 1) * sizeof(thrd_t));
+    _ThreadPool.workers_length = 0;
+    _ThreadPool.started_generation = _ThreadPool.generation;
+
+    for (int i = 0; i < length; i++) {
+        if (thrd_create(&_ThreadPool.workers[i], _ThreadPool_Worker, NULL) != thrd_success) {break;}
+        _ThreadPool.workers_length++;
+    }
+
+    _ThreadPool.started = 1;
+
+}
+
+void ThreadPool_SetThreads(int threads) {
+
+    call_once(&_ThreadPool.once, _ThreadPool_Init);
+
+    mtx_lock(&_ThreadPool.lock);
+    _ThreadPool_Stop();
+    _ThreadPool.threads = threads > 0 ? threads : _ThreadPool_Default();
+    mtx_unlock(&_ThreadPool.lock);
+
+}
+
+int ThreadPool_Threads() {
+
+    call_once(&_ThreadPool.once, _ThreadPool_Init);
+
+    mtx_lock(&_ThreadPool.lock);
+    if (_ThreadPool.threads < 1) {_ThreadPool.threads = _ThreadPool_Default();}
+    int threads = _ThreadPool.threads;
+    mtx_unlock(&_ThreadPool.lock);
+
+    return threads;
+
+}
+
+void ThreadPool_ParallelFor(int tasks, void (*task)(int, void*), void* arg) {
+
+    if (tasks <= 0) {return;}
+
+    // Small jobs and nested calls are not worth waking anyone for.
+    if (tasks == 1 || _ThreadPool_Inside) {
+        for (int i = 0; i < tasks; i++) {task(i, arg);}
+        return;
+    }
+
+    call_once(&_ThreadPool.once, _ThreadPool_Init);
+    mtx_lock(&_ThreadPool.lock);
+    _ThreadPool_Start();
+
+    if (_ThreadPool.workers_length == 0) {
+        mtx_unlock(&_ThreadPool.lock);
+        for (int i = 0; i < tasks; i++) {task(i, arg);}
+        return;
+    }
+
+    // Publish the job and wake the workers.
+    mtx_lock(&_ThreadPool.mutex);
+    _ThreadPool.tasks = tasks;
+    _ThreadPool.task = task;
+    _ThreadPool.arg = arg;
+    atomic_store_explicit(&_ThreadPool.next, 0, memory_order_relaxed);
+    _ThreadPool.busy = _ThreadPool.workers_length;
+    _ThreadPool.generation++;
+    cnd_broadcast(&_ThreadPool.wake);
+    mtx_unlock(&_ThreadPool.mutex);
+
+    _ThreadPool_Inside = 1;
+    _ThreadPool_Drain(tasks, task, arg);
+    _ThreadPool_Inside = 0;
+
+    // Wait for the workers to finish the tasks they took.
+    mtx_lock(&_ThreadPool.mutex);
+    while (_ThreadPool.busy > 0) {cnd_wait(&_ThreadPool.done, &_ThreadPool.mutex);}
+    mtx_unlock(&_ThreadPool.mutex);
+
+    mtx_unlock(&_ThreadPool.lock);
+
+}
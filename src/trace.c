@@ -0,0 +1,36 @@
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include "trace.h"
+
+struct _TraceHook _Trace_Hooks[TRACE_EVENTS];
+
+void Trace_Register(TraceEvent event, TraceCallback callback, void* arg) {
+    _Trace_Hooks[event].callback = callback;
+    _Trace_Hooks[event].arg = arg;
+}
+
+bool Trace_Enabled(void) {
+#ifdef CDSL_TRACE
+    return 1;
+#else
+    return 0;
+#endif
+}
+
+uint64_t _Trace_Now(void) {
+    struct timespec ts;
+    timespec_get(&ts, TIME_UTC);
+    return (uint64_t) ts.tv_sec * 1000000000 + ts.tv_nsec;
+}
+
+void _Trace_Fire(struct _TraceSpan* span, TraceEvent event, const void* object, size_t size, size_t after) {
+
+    // The function may have been removed since the event began.
+    struct _TraceHook hook = _Trace_Hooks[event];
+    if (hook.callback == NULL) {return;}
+
+    TraceRecord record = {event, object, size, span->before, after, _Trace_Now() - span->start};
+    hook.callback(&record, hook.arg);
+
+}
@@ -0,0 +1,472 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <stdbool.h>
+#include "treemap.h"
+
+#define TREEMAP_NODE_BYTES 512
+#define TREEMAP_MIN_ORDER 4
+#define TREEMAP_MAX_ORDER 64
+
+static inline uint8_t* _TreeMap_Key(TreeMap* t, TreeNode* node, int i) {
+    return node->data + i * t->key_size;
+}
+
+static inline uint8_t* _TreeMap_Value(TreeMap* t, TreeNode* node, int i) {
+    return node->data + t->keys_bytes + i * t->value_size;
+}
+
+static inline TreeNode** _TreeMap_Children(TreeMap* t, TreeNode* node) {
+    return (TreeNode**) (node->data + t->keys_bytes);
+}
+
+static inline int _TreeMap_Min(TreeMap* t) {
+    return t->order / 2;
+}
+
+TreeNode* _TreeMap_NewNode(TreeMap* t, bool leaf) {
+
+    // Nodes have room for one extra key, so they can overflow before being split.
+    size_t payload = leaf ? (t->order + 1) * t->value_size : (t->order + 2) * sizeof(TreeNode*);
+    TreeNode* node = malloc(sizeof(TreeNode) + t->keys_bytes + payload);
+
+    node->leaf = leaf;
+    node->count = 0;
+    node->next = NULL;
+    node->prev = NULL;
+    return node;
+
+}
+
+void _TreeMap_FreeNode(TreeMap* t, TreeNode* node) {
+    if (!node->leaf) {
+        TreeNode** children = _TreeMap_Children(t, node);
+        for (int i = 0; i <= node->count; i++) {_TreeMap_FreeNode(t, children[i]);}
+    }
+    free(node);
+}
+
+// Returns the first index whose key is not less than the given key.
+int _TreeMap_LowerIndex(TreeMap* t, TreeNode* node, const void* key) {
+    int low = 0;
+    int high = node->count;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (t->compare(_TreeMap_Key(t, node, mid), key) < 0) {low = mid + 1;}
+        else {high = mid;}
+    }
+    return low;
+}
+
+// Returns the first index whose key is greater than the given key.
+int _TreeMap_UpperIndex(TreeMap* t, TreeNode* node, const void* key) {
+    int low = 0;
+    int high = node->count;
+    while (low < high) {
+        int mid = (low + high) / 2;
+        if (t->compare(_TreeMap_Key(t, node, mid), key) <= 0) {low = mid + 1;}
+        else {high = mid;}
+    }
+    return low;
+}
+
+TreeNode* _TreeMap_FindLeaf(TreeMap* t, const void* key) {
+    TreeNode* node = t->root;
+    while (!node->leaf) {
+        node = _TreeMap_Children(t, node)[_TreeMap_UpperIndex(t, node, key)];
+    }
+    return node;
+}
+
+void TreeMap_Init(TreeMap* t, size_t key_size, size_t value_size, int (*compare)(const void*, const void*)) {
+
+    t->key_size = key_size;
+    t->value_size = value_size;
+    t->size = 0;
+    t->compare = compare;
+
+    // Size nodes so their keys span a handful of cache lines.
+    size_t order = TREEMAP_NODE_BYTES / (key_size > 0 ? key_size : 1);
+    if (order < TREEMAP_MIN_ORDER) {order = TREEMAP_MIN_ORDER;}
+    if (order > TREEMAP_MAX_ORDER) {order = TREEMAP_MAX_ORDER;}
+    t->order = (int) order & ~1;
+
+    // Keep the children of internal nodes pointer aligned.
+    t->keys_bytes = ((t->order + 1) * key_size + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+
+    t->root = _TreeMap_NewNode(t, 1);
+    t->buffer = malloc(key_size > 0 ? key_size : 1);
+
+}
+
+int TreeMap_Size(TreeMap* t) {
+    return t->size;
+}
+
+bool TreeMap_Get(TreeMap* t, void* key, void* buffer) {
+
+    // If the buffer is null, we cannot write to it, return 0.
+    if (buffer == NULL) {return 0;}
+
+    TreeNode* leaf = _TreeMap_FindLeaf(t, key);
+    int i = _TreeMap_LowerIndex(t, leaf, key);
+    if (i == leaf->count || t->compare(_TreeMap_Key(t, leaf, i), key) != 0) {return 0;}
+
+    memcpy(buffer, _TreeMap_Value(t, leaf, i), t->value_size);
+    return 1;
+
+}
+
+// Inserts into the subtree, and returns the new right sibling if the node was split.
+// The key separating the two halves is left in t->buffer.
+TreeNode* _TreeMap_Insert(TreeMap* t, TreeNode* node, void* key, void* value) {
+
+    if (node->leaf) {
+
+        int i = _TreeMap_LowerIndex(t, node, key);
+
+        // If the key already exists, update its value.
+        if (i < node->count && t->compare(_TreeMap_Key(t, node, i), key) == 0) {
+            memcpy(_TreeMap_Value(t, node, i), value, t->value_size);
+            return NULL;
+        }
+
+        memmove(_TreeMap_Key(t, node, i + 1), _TreeMap_Key(t, node, i), (node->count - i) * t->key_size);
+        memmove(_TreeMap_Value(t, node, i + 1), _TreeMap_Value(t, node, i), (node->count - i) * t->value_size);
+        memcpy(_TreeMap_Key(t, node, i), key, t->key_size);
+        memcpy(_TreeMap_Value(t, node, i), value, t->value_size);
+        node->count++;
+        t->size++;
+
+        if (node->count <= t->order) {return NULL;}
+
+        // Split the leaf in half, the right half starts with the separator.
+        TreeNode* right = _TreeMap_NewNode(t, 1);
+        int mid = node->count / 2;
+        right->count = node->count - mid;
+        memcpy(_TreeMap_Key(t, right, 0), _TreeMap_Key(t, node, mid), right->count * t->key_size);
+        memcpy(_TreeMap_Value(t, right, 0), _TreeMap_Value(t, node, mid), right->count * t->value_size);
+        node->count = mid;
+
+        right->next = node->next;
+        right->prev = node;
+        if (node->next != NULL) {node->next->prev = right;}
+        node->next = right;
+
+        memcpy(t->buffer, _TreeMap_Key(t, right, 0), t->key_size);
+        return right;
+
+    }
+
+    int i = _TreeMap_UpperIndex(t, node, key);
+    TreeNode** children = _TreeMap_Children(t, node);
+    TreeNode* split = _TreeMap_Insert(t, children[i], key, value);
+    if (split == NULL) {return NULL;}
+
+    // Insert the separator and new child which came up from below.
+    memmove(_TreeMap_Key(t, node, i + 1), _TreeMap_Key(t, node, i), (node->count - i) * t->key_size);
+    memmove(children + i + 2, children + i + 1, (node->count - i) * sizeof(TreeNode*));
+    memcpy(_TreeMap_Key(t, node, i), t->buffer, t->key_size);
+    children[i + 1] = split;
+    node->count++;
+
+    if (node->count <= t->order) {return NULL;}
+
+    // Split the internal node, the middle key moves up to the parent.
+    TreeNode* right = _TreeMap_NewNode(t, 0);
+    int mid = node->count / 2;
+    right->count = node->count - mid - 1;
+    memcpy(_TreeMap_Key(t, right, 0), _TreeMap_Key(t, node, mid + 1), right->count * t->key_size);
+    memcpy(_TreeMap_Children(t, right), children + mid + 1, (right->count + 1) * sizeof(TreeNode*));
+    memcpy(t->buffer, _TreeMap_Key(t, node, mid), t->key_size);
+    node->count = mid;
+
+    return right;
+
+}
+
+void TreeMap_Put(TreeMap* t, void* key, void* value) {
+
+    TreeNode* split = _TreeMap_Insert(t, t->root, key, value);
+    if (split == NULL) {return;}
+
+    // The root was split, so the tree grows by one level.
+    TreeNode* root = _TreeMap_NewNode(t, 0);
+    root->count = 1;
+    memcpy(_TreeMap_Key(t, root, 0), t->buffer, t->key_size);
+    _TreeMap_Children(t, root)[0] = t->root;
+    _TreeMap_Children(t, root)[1] = split;
+    t->root = root;
+
+}
+
+// Removes the separator at index i and the child to its right.
+void _TreeMap_RemoveSeparator(TreeMap* t, TreeNode* node, int i) {
+    TreeNode** children = _TreeMap_Children(t, node);
+    memmove(_TreeMap_Key(t, node, i), _TreeMap_Key(t, node, i + 1), (node->count - i - 1) * t->key_size);
+    memmove(children + i + 1, children + i + 2, (node->count - i - 1) * sizeof(TreeNode*));
+    node->count--;
+}
+
+// Appends the right sibling to the left one, and frees the right sibling.
+void _TreeMap_Merge(TreeMap* t, TreeNode* parent, int i) {
+
+    TreeNode** children = _TreeMap_Children(t, parent);
+    TreeNode* left = children[i];
+    TreeNode* right = children[i + 1];
+
+    if (left->leaf) {
+        memcpy(_TreeMap_Key(t, left, left->count), _TreeMap_Key(t, right, 0), right->count * t->key_size);
+        memcpy(_TreeMap_Value(t, left, left->count), _TreeMap_Value(t, right, 0), right->count * t->value_size);
+        left->count += right->count;
+        left->next = right->next;
+        if (right->next != NULL) {right->next->prev = left;}
+    }
+
+    else {
+        // The separator comes down between the two halves.
+        memcpy(_TreeMap_Key(t, left, left->count), _TreeMap_Key(t, parent, i), t->key_size);
+        memcpy(_TreeMap_Key(t, left, left->count + 1), _TreeMap_Key(t, right, 0), right->count * t->key_size);
+        memcpy(_TreeMap_Children(t, left) + left->count + 1, _TreeMap_Children(t, right), (right->count + 1) * sizeof(TreeNode*));
+        left->count += right->count + 1;
+    }
+
+    _TreeMap_RemoveSeparator(t, parent, i);
+    free(right);
+
+}
+
+// Restores the minimum occupancy of the child at index i.
+void _TreeMap_Rebalance(TreeMap* t, TreeNode* parent, int i) {
+
+    TreeNode** children = _TreeMap_Children(t, parent);
+    TreeNode* child = children[i];
+    TreeNode* left = i > 0 ? children[i - 1] : NULL;
+    TreeNode* right = i < parent->count ? children[i + 1] : NULL;
+
+    // Borrow the last element of the left sibling.
+    if (left != NULL && left->count > _TreeMap_Min(t)) {
+
+        memmove(_TreeMap_Key(t, child, 1), _TreeMap_Key(t, child, 0), child->count * t->key_size);
+
+        if (child->leaf) {
+            memmove(_TreeMap_Value(t, child, 1), _TreeMap_Value(t, child, 0), child->count * t->value_size);
+            memcpy(_TreeMap_Key(t, child, 0), _TreeMap_Key(t, left, left->count - 1), t->key_size);
+            memcpy(_TreeMap_Value(t, child, 0), _TreeMap_Value(t, left, left->count - 1), t->value_size);
+            memcpy(_TreeMap_Key(t, parent, i - 1), _TreeMap_Key(t, child, 0), t->key_size);
+        } else {
+            TreeNode** grandchildren = _TreeMap_Children(t, child);
+            memmove(grandchildren + 1, grandchildren, (child->count + 1) * sizeof(TreeNode*));
+            grandchildren[0] = _TreeMap_Children(t, left)[left->count];
+            memcpy(_TreeMap_Key(t, child, 0), _TreeMap_Key(t, parent, i - 1), t->key_size);
+            memcpy(_TreeMap_Key(t, parent, i - 1), _TreeMap_Key(t, left, left->count - 1), t->key_size);
+        }
+
+        child->count++;
+        left->count--;
+
+    }
+
+    // Borrow the first element of the right sibling.
+    else if (right != NULL && right->count > _TreeMap_Min(t)) {
+
+        if (child->leaf) {
+            memcpy(_TreeMap_Key(t, child, child->count), _TreeMap_Key(t, right, 0), t->key_size);
+            memcpy(_TreeMap_Value(t, child, child->count), _TreeMap_Value(t, right, 0), t->value_size);
+            memmove(_TreeMap_Value(t, right, 0), _TreeMap_Value(t, right, 1), (right->count - 1) * t->value_size);
+            memmove(_TreeMap_Key(t, right, 0), _TreeMap_Key(t, right, 1), (right->count - 1) * t->key_size);
+            memcpy(_TreeMap_Key(t, parent, i), _TreeMap_Key(t, right, 0), t->key_size);
+        } else {
+            TreeNode** grandchildren = _TreeMap_Children(t, right);
+            memcpy(_TreeMap_Key(t, child, child->count), _TreeMap_Key(t, parent, i), t->key_size);
+            _TreeMap_Children(t, child)[child->count + 1] = grandchildren[0];
+            memcpy(_TreeMap_Key(t, parent, i), _TreeMap_Key(t, right, 0), t->key_size);
+            memmove(_TreeMap_Key(t, right, 0), _TreeMap_Key(t, right, 1), (right->count - 1) * t->key_size);
+            memmove(grandchildren, grandchildren + 1, right->count * sizeof(TreeNode*));
+        }
+
+        child->count++;
+        right->count--;
+
+    }
+
+    // Neither sibling can spare an element, so merge with one of them.
+    else if (left != NULL) {_TreeMap_Merge(t, parent, i - 1);}
+    else {_TreeMap_Merge(t, parent, i);}
+
+}
+
+bool _TreeMap_Delete(TreeMap* t, TreeNode* node, void* key) {
+
+    if (node->leaf) {
+
+        int i = _TreeMap_LowerIndex(t, node, key);
+        if (i == node->count || t->compare(_TreeMap_Key(t, node, i), key) != 0) {return 0;}
+
+        memmove(_TreeMap_Key(t, node, i), _TreeMap_Key(t, node, i + 1), (node->count - i - 1) * t->key_size);
+        memmove(_TreeMap_Value(t, node, i), _TreeMap_Value(t, node, i + 1), (node->count - i - 1) * t->value_size);
+        node->count--;
+        t->size--;
+        return 1;
+
+    }
+
+    int i = _TreeMap_UpperIndex(t, node, key);
+    TreeNode* child = _TreeMap_Children(t, node)[i];
+    if (!_TreeMap_Delete(t, child, key)) {return 0;}
+
+    if (child->count < _TreeMap_Min(t)) {_TreeMap_Rebalance(t, node, i);}
+    return 1;
+
+}
+
+bool TreeMap_Remove(TreeMap* t, void* key) {
+
+    if (!_TreeMap_Delete(t, t->root, key)) {return 0;}
+
+    // If the root has a single child left, the tree shrinks by one level.
+    if (!t->root->leaf && t->root->count == 0) {
+        TreeNode* root = t->root;
+        t->root = _TreeMap_Children(t, root)[0];
+        free(root);
+    }
+
+    return 1;
+
+}
+
+bool TreeMap_Load(TreeMap* t, void* keys, void* values, int count) {
+
+    if (t->size != 0) {return 0;}
+
+    uint8_t* k = keys;
+    uint8_t* v = values;
+    for (int i = 1; i < count; i++) {
+        if (t->compare(k + (i - 1) * t->key_size, k + i * t->key_size) >= 0) {return 0;}
+    }
+    if (count <= 0) {return 1;}
+
+    // Spread the keys evenly so every leaf is at least half full.
+    int nodes = (count + t->order - 1) / t->order;
+    TreeNode** level = malloc(nodes * sizeof(TreeNode*));
+    uint8_t** lows = malloc(nodes * sizeof(uint8_t*));
+
+    int start = 0;
+    for (int j = 0; j < nodes; j++) {
+
+        int end = (int) ((int64_t) count * (j + 1) / nodes);
+        TreeNode* leaf = _TreeMap_NewNode(t, 1);
+        leaf->count = end - start;
+        memcpy(_TreeMap_Key(t, leaf, 0), k + start * t->key_size, leaf->count * t->key_size);
+        memcpy(_TreeMap_Value(t, leaf, 0), v + start * t->value_size, leaf->count * t->value_size);
+
+        if (j > 0) {
+            leaf->prev = level[j - 1];
+            level[j - 1]->next = leaf;
+        }
+
+        level[j] = leaf;
+        lows[j] = k + start * t->key_size;
+        start = end;
+
+    }
+
+    // Build the internal levels bottom up, each child's smallest key is its separator.
+    while (nodes > 1) {
+
+        int parents = (nodes + t->order) / (t->order + 1);
+        int first = 0;
+
+        for (int j = 0; j < parents; j++) {
+
+            int last = (int) ((int64_t) nodes * (j + 1) / parents);
+            TreeNode* node = _TreeMap_NewNode(t, 0);
+            node->count = last - first - 1;
+
+            for (int c = first; c < last; c++) {
+                _TreeMap_Children(t, node)[c - first] = level[c];
+                if (c > first) {memcpy(_TreeMap_Key(t, node, c - first - 1), lows[c], t->key_size);}
+            }
+
+            level[j] = node;
+            lows[j] = lows[first];
+            first = last;
+
+        }
+
+        nodes = parents;
+
+    }
+
+    free(t->root);
+    t->root = level[0];
+    t->size = count;
+
+    free(level);
+    free(lows);
+    return 1;
+
+}
+
+// Moves an iterator past the end of its leaf onto the next leaf.
+void _TreeMapIterator_Settle(TreeMapIterator* it) {
+    if (it->node != NULL && it->index >= it->node->count) {
+        it->node = it->node->next;
+        it->index = 0;
+    }
+}
+
+TreeMapIterator TreeMap_First(TreeMap* t) {
+
+    TreeNode* node = t->root;
+    while (!node->leaf) {node = _TreeMap_Children(t, node)[0];}
+
+    TreeMapIterator it = {t, node, 0};
+    _TreeMapIterator_Settle(&it);
+    return it;
+
+}
+
+TreeMapIterator TreeMap_LowerBound(TreeMap* t, void* key) {
+    TreeNode* leaf = _TreeMap_FindLeaf(t, key);
+    TreeMapIterator it = {t, leaf, _TreeMap_LowerIndex(t, leaf, key)};
+    _TreeMapIterator_Settle(&it);
+    return it;
+}
+
+TreeMapIterator TreeMap_UpperBound(TreeMap* t, void* key) {
+    TreeNode* leaf = _TreeMap_FindLeaf(t, key);
+    TreeMapIterator it = {t, leaf, _TreeMap_UpperIndex(t, leaf, key)};
+    _TreeMapIterator_Settle(&it);
+    return it;
+}
+
+bool TreeMapIterator_Valid(TreeMapIterator* it) {
+    return it->node != NULL;
+}
+
+void TreeMapIterator_Next(TreeMapIterator* it) {
+    it->index++;
+    _TreeMapIterator_Settle(it);
+}
+
+void* TreeMapIterator_Key(TreeMapIterator* it) {
+    return _TreeMap_Key(it->map, it->node, it->index);
+}
+
+void* TreeMapIterator_Value(TreeMapIterator* it) {
+    return _TreeMap_Value(it->map, it->node, it->index);
+}
+
+void TreeMap_Clear(TreeMap* t) {
+    size_t key_size = t->key_size;
+    size_t value_size = t->value_size;
+    int (*compare)(const void*, const void*) = t->compare;
+    TreeMap_Free(t);
+    TreeMap_Init(t, key_size, value_size, compare);
+}
+
+void TreeMap_Free(TreeMap* t) {
+    _TreeMap_FreeNode(t, t->root);
+    free(t->buffer);
+}
@@ -0,0 +1,153 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "bitset.h"
+
+#define NUM_BITS 100000
+#define NUM_VALUES 200000
+
+int main() {
+
+    // Initialise the sets
+    int flag = 0;
+    Bitset a;
+    Bitset b;
+    Bitset_Init(&a);
+    Bitset_Init(&b);
+
+    // Put the multiples of 3 in one set and of 5 in the other.
+    for (size_t i = 0; i < NUM_BITS; i += 3) {Bitset_Set(&a, i);}
+    for (size_t i = 0; i < 2 * NUM_BITS; i += 5) {Bitset_Set(&b, i);}
+    if (Bitset_Count(&a) != (NUM_BITS + 2) / 3 || Bitset_Count(&b) != 2 * NUM_BITS / 5) {flag = 1;}
+    if (!Bitset_Get(&a, 99) || Bitset_Get(&a, 100) || Bitset_Get(&a, 10 * NUM_BITS)) {flag = 1;}
+
+    // Rank and select undo each other.
+    for (size_t i = 0; i < NUM_BITS; i += 7) {
+        if (Bitset_Rank(&a, i) != (i + 2) / 3) {flag = 1;}
+        size_t index;
+        if (!Bitset_Select(&a, i / 3, &index) || index != i / 3 * 3) {flag = 1;}
+    }
+    size_t index = 0;
+    if (Bitset_Select(&a, Bitset_Count(&a), &index) || index != 0) {flag = 1;}
+    if (Bitset_Rank(&a, 10 * NUM_BITS) != Bitset_Count(&a)) {flag = 1;}
+
+    // Iterate over the set bits in order.
+    size_t expected = 0;
+    for (BitsetIterator it = Bitset_First(&a); BitsetIterator_Valid(&it); BitsetIterator_Next(&it)) {
+        if (BitsetIterator_Index(&it) != expected) {flag = 1;}
+        expected += 3;
+    }
+    if (expected != (NUM_BITS + 2) / 3 * 3) {flag = 1;}
+
+    // Combine the sets, checking every integer against its definition.
+    Bitset c;
+    Bitset_Init(&c);
+    for (int op = 0; op < 4; op++) {
+        Bitset_Clear(&c);
+        Bitset_Or(&c, &a);
+        if (op == 0) {Bitset_And(&c, &b);}
+        if (op == 1) {Bitset_Or(&c, &b);}
+        if (op == 2) {Bitset_Xor(&c, &b);}
+        if (op == 3) {Bitset_AndNot(&c, &b);}
+        size_t count = 0;
+        for (size_t i = 0; i < 2 * NUM_BITS + 64; i++) {
+            bool x = i < NUM_BITS && i % 3 == 0;
+            bool y = i < 2 * NUM_BITS && i % 5 == 0;
+            bool z = op == 0 ? x && y : op == 1 ? x || y : op == 2 ? x != y : x && !y;
+            if (Bitset_Get(&c, i) != z) {flag = 1;}
+            count += z;
+        }
+        if (Bitset_Count(&c) != count) {flag = 1;}
+    }
+
+    // Remove integers.
+    Bitset_Unset(&a, 3);
+    Bitset_Unset(&a, 10 * NUM_BITS);
+    if (Bitset_Get(&a, 3) || Bitset_Count(&a) != (NUM_BITS + 2) / 3 - 1) {flag = 1;}
+
+    // An empty set has nothing to visit.
+    Bitset_Clear(&a);
+    BitsetIterator it = Bitset_First(&a);
+    if (Bitset_Count(&a) != 0 || BitsetIterator_Valid(&it)) {flag = 1;}
+
+    Bitset_Free(&a);
+    Bitset_Free(&b);
+    Bitset_Free(&c);
+
+    // Mix dense and sparse ranges in compressed sets, and track them in plain ones.
+    CompressedBitset x;
+    CompressedBitset y;
+    CompressedBitset_Init(&x);
+    CompressedBitset_Init(&y);
+    Bitset_Init(&a);
+    Bitset_Init(&b);
+
+    uint32_t state = 1;
+    for (int i = 0; i < NUM_VALUES; i++) {
+        state = state * 1103515245 + 12345;
+        uint32_t value = i < NUM_VALUES / 2 ? (state >> 8) % 300000 : 4000000 + (state >> 8) % 2000000;
+        if (CompressedBitset_Add(&x, value) == Bitset_Get(&a, value)) {flag = 1;}
+        Bitset_Set(&a, value);
+        if (i % 2 == 0) {
+            value = (state >> 4) % 500000;
+            CompressedBitset_Add(&y, value);
+            Bitset_Set(&b, value);
+        }
+    }
+    if (CompressedBitset_Count(&x) != Bitset_Count(&a) || CompressedBitset_Count(&y) != Bitset_Count(&b)) {flag = 1;}
+
+    // Sparse ranges take much less memory than a bit per integer.
+    if (CompressedBitset_Bytes(&x) > 6000000 / 8) {flag = 1;}
+
+    // Remove enough of a dense range for it to turn back into an array.
+    for (uint32_t value = 0; value < 200000; value++) {
+        if (CompressedBitset_Remove(&x, value) != Bitset_Get(&a, value)) {flag = 1;}
+        Bitset_Unset(&a, value);
+    }
+    if (CompressedBitset_Remove(&x, 4000000 - 1) != 0) {flag = 1;}
+    if (CompressedBitset_Contains(&x, 100) || CompressedBitset_Count(&x) != Bitset_Count(&a)) {flag = 1;}
+
+    // Combine the compressed sets and compare with the plain ones.
+    for (int op = 0; op < 4; op++) {
+        CompressedBitset z;
+        CompressedBitset_Init(&z);
+        CompressedBitset_Or(&z, &x);
+        Bitset_Init(&c);
+        Bitset_Or(&c, &a);
+        if (op == 0) {CompressedBitset_And(&z, &y); Bitset_And(&c, &b);}
+        if (op == 1) {CompressedBitset_Or(&z, &y); Bitset_Or(&c, &b);}
+        if (op == 2) {CompressedBitset_Xor(&z, &y); Bitset_Xor(&c, &b);}
+        if (op == 3) {CompressedBitset_AndNot(&z, &y); Bitset_AndNot(&c, &b);}
+
+        // Both sets visit the same integers in the same order.
+        BitsetIterator i = Bitset_First(&c);
+        CompressedBitsetIterator j = CompressedBitset_First(&z);
+        while (BitsetIterator_Valid(&i) && CompressedBitsetIterator_Valid(&j)) {
+            if (BitsetIterator_Index(&i) != CompressedBitsetIterator_Value(&j)) {flag = 1; break;}
+            if (!CompressedBitset_Contains(&z, CompressedBitsetIterator_Value(&j))) {flag = 1;}
+            BitsetIterator_Next(&i);
+            CompressedBitsetIterator_Next(&j);
+        }
+        if (BitsetIterator_Valid(&i) || CompressedBitsetIterator_Valid(&j)) {flag = 1;}
+        if (CompressedBitset_Count(&z) != Bitset_Count(&c)) {flag = 1;}
+
+        CompressedBitset_Free(&z);
+        Bitset_Free(&c);
+    }
+
+    // The largest integer has its own container.
+    CompressedBitset_Add(&x, UINT32_MAX);
+    if (!CompressedBitset_Contains(&x, UINT32_MAX)) {flag = 1;}
+
+    // Clear a set and use it again.
+    CompressedBitset_Clear(&x);
+    CompressedBitsetIterator j = CompressedBitset_First(&x);
+    if (CompressedBitset_Count(&x) != 0 || CompressedBitsetIterator_Valid(&j)) {flag = 1;}
+    if (CompressedBitset_Add(&x, 7) != 1 || CompressedBitset_Add(&x, 7) != 0) {flag = 1;}
+
+    // Free the set memory
+    CompressedBitset_Free(&x);
+    CompressedBitset_Free(&y);
+    Bitset_Free(&a);
+    Bitset_Free(&b);
+    return flag;
+}
@@ -0,0 +1,77 @@
+#include <stdlib.h>
+#include <stddef.h>
+#include <string.h>
+#include "columnlist.h"
+
+#define NUM_RECORDS 100000
+
+struct Trade {
+    double price;
+    int volume;
+    char symbol[8];
+    char unused;
+};
+
+int main() {
+
+    // Initialise the list with every field but one
+    int flag = 0;
+    ColumnField fields[] = {
+        {offsetof(struct Trade, price), sizeof(double)},
+        {offsetof(struct Trade, volume), sizeof(int)},
+        {offsetof(struct Trade, symbol), 8}
+    };
+    ColumnList c;
+    ColumnList_Init(&c, sizeof(struct Trade), fields, 3);
+    if (ColumnList_Column(&c, 0) != NULL || ColumnList_Column(&c, 3) != NULL) {flag = 1;}
+
+    // Push half the records one at a time, and the rest as an array.
+    struct Trade* trades = malloc(NUM_RECORDS * sizeof(struct Trade));
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        trades[i] = (struct Trade) {i * 0.5, i % 1000, "", 'x'};
+        strcpy(trades[i].symbol, i % 2 == 0 ? "EVEN" : "ODD");
+    }
+    for (int i = 0; i < NUM_RECORDS / 2; i++) {ColumnList_Push(&c, trades + i);}
+    ColumnList_Extend(&c, trades + NUM_RECORDS / 2, NUM_RECORDS - NUM_RECORDS / 2);
+    if (ColumnList_Length(&c) != NUM_RECORDS) {flag = 1;}
+
+    // Every record comes back whole, apart from the field which is not stored.
+    for (int i = 0; i < NUM_RECORDS; i++) {
+        struct Trade trade = {0, 0, "", 'y'};
+        if (!ColumnList_Get(&c, i, &trade)) {flag = 1;}
+        if (trade.price != trades[i].price || trade.volume != trades[i].volume || strcmp(trade.symbol, trades[i].symbol) != 0) {flag = 1;}
+        if (trade.unused != 'y') {flag = 1;}
+    }
+    struct Trade trade;
+    if (ColumnList_Get(&c, NUM_RECORDS, &trade) || ColumnList_Get(&c, -1, &trade)) {flag = 1;}
+
+    // Scan a column on its own.
+    int* volumes = ColumnList_Column(&c, 1);
+    long total = 0;
+    for (int i = 0; i < ColumnList_Length(&c); i++) {total += volumes[i];}
+    if (total != (long) NUM_RECORDS / 1000 * (999 * 1000 / 2)) {flag = 1;}
+
+    // Columns can be written in place, and records replaced whole.
+    double* prices = ColumnList_Column(&c, 0);
+    for (int i = 0; i < NUM_RECORDS; i++) {prices[i] *= 2;}
+    ColumnList_Get(&c, 10, &trade);
+    if (trade.price != 10) {flag = 1;}
+    trade.volume = -1;
+    if (!ColumnList_Set(&c, 10, &trade) || volumes[10] != -1) {flag = 1;}
+    if (ColumnList_Set(&c, NUM_RECORDS, &trade)) {flag = 1;}
+
+    // Pop records off the end.
+    if (!ColumnList_Pop(&c, &trade) || trade.volume != (NUM_RECORDS - 1) % 1000 || strcmp(trade.symbol, "ODD") != 0) {flag = 1;}
+    if (ColumnList_Length(&c) != NUM_RECORDS - 1) {flag = 1;}
+
+    // Clear the list and use it again.
+    ColumnList_Clear(&c);
+    if (ColumnList_Length(&c) != 0 || ColumnList_Pop(&c, NULL)) {flag = 1;}
+    ColumnList_Push(&c, trades);
+    if (!ColumnList_Get(&c, 0, &trade) || trade.volume != 0) {flag = 1;}
+
+    // Free the list memory
+    ColumnList_Free(&c);
+    free(trades);
+    return flag;
+}
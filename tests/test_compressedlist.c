@@ -0,0 +1,149 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "compressedlist.h"
+
+#define NUM_ELEMENTS 100000
+#define NUM_WIDTHS 34
+
+// Returns the index of the first value not less than the given one.
+int lower_bound(uint64_t* values, int length, uint64_t value) {
+    int lo = 0;
+    int hi = length;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (values[mid] < value) {lo = mid + 1;}
+        else {hi = mid;}
+    }
+    return lo;
+}
+
+int main() {
+
+    // Initialise the list
+    int flag = 0;
+    CompressedList c;
+    CompressedList_Init(&c);
+
+    // Append values with runs of equal values, small gaps and the odd gap too wide for 32 bits.
+    uint64_t* values = malloc(NUM_ELEMENTS * sizeof(uint64_t));
+    uint64_t value = 5;
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (i % 5000 == 4999) {value += (uint64_t) 1 << 40;}
+        else if (i % 7 != 0) {value += i % 37;}
+        values[i] = value;
+        if (CompressedList_Append(&c, value) != 1) {flag = 1;}
+    }
+    if (CompressedList_Length(&c) != NUM_ELEMENTS) {flag = 1;}
+
+    // Values must not go down.
+    if (CompressedList_Append(&c, value - 1) != 0 || CompressedList_Length(&c) != NUM_ELEMENTS) {flag = 1;}
+
+    // The list is much smaller than a List of the same values.
+    if (CompressedList_Bytes(&c) > 2 * NUM_ELEMENTS) {flag = 1;}
+
+    // Iterate over every value.
+    int i = 0;
+    CompressedListIterator it = CompressedList_First(&c);
+    while (CompressedListIterator_Valid(&it)) {
+        if (i >= NUM_ELEMENTS || CompressedListIterator_Value(&it) != values[i]) {flag = 1; break;}
+        CompressedListIterator_Next(&it);
+        i++;
+    }
+    if (i != NUM_ELEMENTS) {flag = 1;}
+
+    // Look values up, including ones between, before and after the stored values.
+    for (uint64_t target = 0; target < values[NUM_ELEMENTS - 1] + 2; target = target * 3 / 2 + 1) {
+        int expected = lower_bound(values, NUM_ELEMENTS, target);
+        it = CompressedList_LowerBound(&c, target);
+        if (CompressedListIterator_Valid(&it) != (expected < NUM_ELEMENTS)) {flag = 1;}
+        else if (expected < NUM_ELEMENTS && CompressedListIterator_Value(&it) != values[expected]) {flag = 1;}
+    }
+
+    // Skip forwards through the list by growing steps.
+    it = CompressedList_First(&c);
+    for (int step = 1, index = 0; index < NUM_ELEMENTS; step++, index += step) {
+        CompressedListIterator_SkipTo(&it, values[index]);
+        int expected = lower_bound(values, NUM_ELEMENTS, values[index]);
+        if (!CompressedListIterator_Valid(&it) || CompressedListIterator_Value(&it) != values[expected]) {flag = 1;}
+    }
+    CompressedListIterator_SkipTo(&it, values[NUM_ELEMENTS - 1] + 1);
+    if (CompressedListIterator_Valid(&it)) {flag = 1;}
+
+    // Intersect with the multiples of three up to the first wide gap, skipping through both lists.
+    CompressedList d;
+    CompressedList_Init(&d);
+    for (uint64_t v = 0; v <= values[NUM_ELEMENTS - 1]; v += 3) {
+        if (v > values[NUM_ELEMENTS / 25]) {break;}
+        CompressedList_Append(&d, v);
+    }
+    int common = 0;
+    int expected = 0;
+    for (i = 0; i < NUM_ELEMENTS && values[i] <= values[NUM_ELEMENTS / 25]; i++) {
+        if (values[i] % 3 == 0 && (i == 0 || values[i] != values[i-1])) {expected++;}
+    }
+    CompressedListIterator a = CompressedList_First(&c);
+    CompressedListIterator b = CompressedList_First(&d);
+    while (CompressedListIterator_Valid(&a) && CompressedListIterator_Valid(&b)) {
+        uint64_t x = CompressedListIterator_Value(&a);
+        uint64_t y = CompressedListIterator_Value(&b);
+        if (x < y) {CompressedListIterator_SkipTo(&a, y);}
+        else if (y < x) {CompressedListIterator_SkipTo(&b, x);}
+        else {
+            common++;
+            CompressedListIterator_SkipTo(&a, x + 1);
+            CompressedListIterator_Next(&b);
+        }
+    }
+    if (common != expected) {flag = 1;}
+    CompressedList_Free(&d);
+
+    // Every packing width from 0 to 32 bits, and wider, round trips.
+    CompressedList_Clear(&c);
+    value = 0;
+    for (int width = 0; width < NUM_WIDTHS; width++) {
+        for (int j = 0; j < COMPRESSEDLIST_BLOCK_LENGTH; j++) {
+            value += j % 2 == 0 ? ((uint64_t) 1 << width) - 1 : (uint64_t) (j % 3);
+            values[width * COMPRESSEDLIST_BLOCK_LENGTH + j] = value;
+            CompressedList_Append(&c, value);
+        }
+    }
+    i = 0;
+    for (it = CompressedList_First(&c); CompressedListIterator_Valid(&it); CompressedListIterator_Next(&it), i++) {
+        if (CompressedListIterator_Value(&it) != values[i]) {flag = 1;}
+    }
+    if (i != NUM_WIDTHS * COMPRESSEDLIST_BLOCK_LENGTH) {flag = 1;}
+
+    // Convert to and from a List of 32 bit integers.
+    List l;
+    List_Init(&l, sizeof(uint32_t));
+    for (uint32_t v = 0; v < NUM_ELEMENTS; v += 2) {List_Push(&l, &v);}
+    CompressedList_Free(&c);
+    if (CompressedList_FromList(&c, &l) != 1 || CompressedList_Length(&c) != NUM_ELEMENTS / 2) {flag = 1;}
+
+    List out;
+    if (CompressedList_ToList(&c, &out, 3) != 0) {flag = 1;}
+    if (CompressedList_ToList(&c, &out, sizeof(uint32_t)) != 1 || List_Length(&out) != NUM_ELEMENTS / 2) {flag = 1;}
+    for (i = 0; i < List_Length(&out); i++) {
+        if (*(uint32_t*) List_Elements(&out)[i] != (uint32_t) (2 * i)) {flag = 1;}
+    }
+    List_Free(&out);
+
+    // Lists out of order are refused.
+    uint32_t v = 0;
+    List_Push(&l, &v);
+    CompressedList e;
+    if (CompressedList_FromList(&e, &l) != 0) {flag = 1;}
+    List_Free(&l);
+
+    // An empty list has nothing to iterate over.
+    CompressedList_Clear(&c);
+    it = CompressedList_First(&c);
+    if (CompressedListIterator_Valid(&it)) {flag = 1;}
+    it = CompressedList_LowerBound(&c, 0);
+    if (CompressedListIterator_Valid(&it)) {flag = 1;}
+
+    // Free the list memory
+    CompressedList_Free(&c);
+    free(values);
+    return flag;
+}
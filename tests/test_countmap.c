@@ -0,0 +1,68 @@
+#include <stdlib.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "countmap.h"
+
+#define NUM_ELEMENTS 5000
+#define NUM_THREADS 4
+#define NUM_ADDS 10000
+
+int add(void* arg) {
+    for (int i = 0; i < NUM_ADDS; i++) {atomic_fetch_add((_Atomic int64_t*) arg, 1);}
+    return 0;
+}
+
+int main() {
+
+    // Initialise the map
+    int flag = 0;
+    CountMap c;
+    CountMap_Init(&c, sizeof(int));
+
+    // Count every key below NUM_ELEMENTS once for each of its set bits.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        for (int bit = 0; bit < 16; bit++) {
+            if (i & (1 << bit)) {CountMap_Add(&c, &i, 1);}
+        }
+    }
+
+    // Only keys with set bits were counted.
+    if (CountMap_Size(&c) != NUM_ELEMENTS - 1) {flag = 1;}
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int bits = 0;
+        for (int bit = 0; bit < 16; bit++) {bits += (i >> bit) & 1;}
+        if (CountMap_Get(&c, &i) != bits) {flag = 1;}
+    }
+
+    // Adding returns the new count, and a key stays when it drops to 0.
+    int key = 7;
+    if (CountMap_Add(&c, &key, -3) != 0 || CountMap_Size(&c) != NUM_ELEMENTS - 1) {flag = 1;}
+    if (CountMap_Add(&c, &key, 10) != 10) {flag = 1;}
+
+    // Threads add to a counter while the map grows underneath it.
+    key = -1;
+    _Atomic int64_t* counter = CountMap_Counter(&c, &key);
+    thrd_t threads[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {thrd_create(&threads[i], add, (void*) counter);}
+    for (int i = NUM_ELEMENTS; i < 4 * NUM_ELEMENTS; i++) {CountMap_Add(&c, &i, 1);}
+    for (int i = 0; i < NUM_THREADS; i++) {thrd_join(threads[i], NULL);}
+    if (CountMap_Get(&c, &key) != NUM_THREADS * NUM_ADDS) {flag = 1;}
+    if (CountMap_Counter(&c, &key) != counter) {flag = 1;}
+
+    // Remove a key.
+    if (CountMap_Remove(&c, &key) != 1 || CountMap_Get(&c, &key) != 0) {flag = 1;}
+
+    // The keys are listed in the order they were first counted.
+    int expected = 1;
+    for (KeyValue* e = CountMap_Elements(&c); e != NULL; e = e->next) {
+        if (*(int*) e->key != expected++) {flag = 1;}
+    }
+
+    // Clear the map and use it again.
+    CountMap_Clear(&c);
+    if (CountMap_Size(&c) != 0 || CountMap_Add(&c, &key, 2) != 2) {flag = 1;}
+
+    // Free the map memory
+    CountMap_Free(&c);
+    return flag;
+}
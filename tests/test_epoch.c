@@ -0,0 +1,85 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdatomic.h>
+#include <threads.h>
+#include "epoch.h"
+#include "hashmap.h"
+
+#define NUM_KEYS 2000
+#define NUM_ROUNDS 20
+#define NUM_READERS 3
+
+HashMap h;
+atomic_bool done;
+atomic_int destroyed;
+atomic_int errors;
+
+void destroy(void* memory, size_t size) {
+    (void) size;
+    atomic_fetch_add(&destroyed, 1);
+    free(memory);
+}
+
+// Every value stored for a key is either twice the key or one more than that.
+int reader(void* arg) {
+    (void) arg;
+    while (!atomic_load(&done)) {
+        for (int64_t key = 0; key < NUM_KEYS; key++) {
+            int64_t value;
+            if (HashMap_Get(&h, &key, &value) && value != 2 * key && value != 2 * key + 1) {atomic_fetch_add(&errors, 1);}
+        }
+    }
+    return 0;
+}
+
+int main() {
+
+    int flag = 0;
+
+    // Retired memory is freed once nobody can be reading it.
+    Epoch_Enter();
+    Epoch_Enter();
+    for (int i = 0; i < 10; i++) {Epoch_Retire(malloc(16), 16, destroy);}
+    Epoch_Exit();
+    Epoch_Exit();
+    Epoch_Barrier();
+    if (atomic_load(&destroyed) != 10) {flag = 1;}
+
+    // Readers look up keys while the writer puts, updates, removes and grows a map of each engine.
+    for (int engine = HASHMAP_CUCKOO; engine <= HASHMAP_SWISS; engine++) {
+
+        atomic_store(&done, 0);
+        HashMap_InitEngine(&h, sizeof(int64_t), sizeof(int64_t), engine);
+        HashMap_SetConcurrent(&h, 1);
+
+        thrd_t readers[NUM_READERS];
+        for (int i = 0; i < NUM_READERS; i++) {thrd_create(&readers[i], reader, NULL);}
+
+        for (int round = 0; round < NUM_ROUNDS; round++) {
+            for (int64_t key = 0; key < NUM_KEYS; key++) {
+                int64_t value = 2 * key + (round % 2);
+                HashMap_Put(&h, &key, &value);
+            }
+            for (int64_t key = round % 3; key < NUM_KEYS; key += 3) {HashMap_Remove(&h, &key);}
+            thrd_yield();
+        }
+
+        atomic_store(&done, 1);
+        for (int i = 0; i < NUM_READERS; i++) {thrd_join(readers[i], NULL);}
+        if (atomic_load(&errors) != 0) {flag = 1;}
+
+        // The map is still whole.
+        for (int64_t key = 0; key < NUM_KEYS; key++) {
+            int64_t value;
+            bool removed = key % 3 == (NUM_ROUNDS - 1) % 3;
+            if (HashMap_Get(&h, &key, &value) == removed) {flag = 1;}
+            if (!removed && value != 2 * key + (NUM_ROUNDS - 1) % 2) {flag = 1;}
+        }
+
+        Epoch_Barrier();
+        HashMap_Free(&h);
+
+    }
+
+    return flag;
+}
@@ -0,0 +1,110 @@
+#include <stdlib.h>
+#include "filter.h"
+
+#define NUM_ELEMENTS 10000
+
+int main() {
+
+    int flag = 0;
+    int keys[NUM_ELEMENTS];
+    bool results[NUM_ELEMENTS];
+    for (int i = 0; i < NUM_ELEMENTS; i++) {keys[i] = i;}
+
+    // Initialise the bloom filter
+    BloomFilter b;
+    BloomFilter_Init(&b, sizeof(int), NUM_ELEMENTS, 10);
+
+    // Add the first half one by one, and the second half as a batch.
+    for (int i = 0; i < NUM_ELEMENTS / 2; i++) {BloomFilter_Add(&b, &i);}
+    BloomFilter_AddMany(&b, keys + NUM_ELEMENTS / 2, NUM_ELEMENTS / 2);
+
+    // There are no false negatives.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (BloomFilter_Contains(&b, &i) != 1) {flag = 1;}
+    }
+    if (BloomFilter_ContainsMany(&b, keys, NUM_ELEMENTS, results) != NUM_ELEMENTS) {flag = 1;}
+
+    // The false positive rate should be around 1%.
+    int false_positives = 0;
+    for (int i = NUM_ELEMENTS; i < 2 * NUM_ELEMENTS; i++) {
+        false_positives += BloomFilter_Contains(&b, &i);
+    }
+    if (false_positives > NUM_ELEMENTS / 20) {flag = 1;}
+
+    // Serialize the filter and read it back.
+    size_t length = BloomFilter_SerializedSize(&b);
+    void* buffer = malloc(length);
+    BloomFilter_Serialize(&b, buffer);
+
+    BloomFilter c;
+    if (BloomFilter_Deserialize(&c, buffer, length - 1) != 0) {flag = 1;}
+    if (BloomFilter_Deserialize(&c, buffer, length) != 1) {flag = 1;}
+    for (int i = 0; i < 2 * NUM_ELEMENTS; i++) {
+        if (BloomFilter_Contains(&c, &i) != BloomFilter_Contains(&b, &i)) {flag = 1;}
+    }
+    free(buffer);
+
+    // Clear the filter
+    BloomFilter_Clear(&b);
+    if (BloomFilter_ContainsMany(&b, keys, NUM_ELEMENTS, NULL) != 0) {flag = 1;}
+
+    BloomFilter_Free(&b);
+    BloomFilter_Free(&c);
+
+    // Initialise the cuckoo filter
+    CuckooFilter f;
+    CuckooFilter_Init(&f, sizeof(int), NUM_ELEMENTS);
+
+    for (int i = 0; i < NUM_ELEMENTS / 2; i++) {
+        if (CuckooFilter_Add(&f, &i) != 1) {flag = 1;}
+    }
+    if (CuckooFilter_AddMany(&f, keys + NUM_ELEMENTS / 2, NUM_ELEMENTS / 2) != NUM_ELEMENTS / 2) {flag = 1;}
+    if (CuckooFilter_Size(&f) != NUM_ELEMENTS) {flag = 1;}
+
+    // There are no false negatives.
+    if (CuckooFilter_ContainsMany(&f, keys, NUM_ELEMENTS, results) != NUM_ELEMENTS) {flag = 1;}
+
+    // 16 bit fingerprints give very few false positives.
+    false_positives = 0;
+    for (int i = NUM_ELEMENTS; i < 2 * NUM_ELEMENTS; i++) {
+        false_positives += CuckooFilter_Contains(&f, &i);
+    }
+    if (false_positives > NUM_ELEMENTS / 100) {flag = 1;}
+
+    // Serialize the filter and read it back.
+    length = CuckooFilter_SerializedSize(&f);
+    buffer = malloc(length);
+    CuckooFilter_Serialize(&f, buffer);
+
+    CuckooFilter g;
+    if (CuckooFilter_Deserialize(&g, buffer, length + 1) != 0) {flag = 1;}
+    if (CuckooFilter_Deserialize(&g, buffer, length) != 1) {flag = 1;}
+    if (CuckooFilter_Size(&g) != NUM_ELEMENTS) {flag = 1;}
+    if (CuckooFilter_ContainsMany(&g, keys, NUM_ELEMENTS, NULL) != NUM_ELEMENTS) {flag = 1;}
+    free(buffer);
+
+    // Remove every even key.
+    for (int i = 0; i < NUM_ELEMENTS; i = i + 2) {
+        if (CuckooFilter_Remove(&f, &i) != 1) {flag = 1;}
+    }
+    if (CuckooFilter_Size(&f) != NUM_ELEMENTS / 2) {flag = 1;}
+
+    // The odd keys must all still be there.
+    for (int i = 1; i < NUM_ELEMENTS; i = i + 2) {
+        if (CuckooFilter_Contains(&f, &i) != 1) {flag = 1;}
+    }
+
+    // Most of the even keys should be gone.
+    if (CuckooFilter_ContainsMany(&f, keys, NUM_ELEMENTS, NULL) > NUM_ELEMENTS / 2 + NUM_ELEMENTS / 100) {flag = 1;}
+
+    // Fill a tiny filter until it refuses keys.
+    CuckooFilter_Clear(&g);
+    if (CuckooFilter_Size(&g) != 0) {flag = 1;}
+    CuckooFilter_Free(&g);
+    CuckooFilter_Init(&g, sizeof(int), 8);
+    if (CuckooFilter_AddMany(&g, keys, NUM_ELEMENTS) >= NUM_ELEMENTS) {flag = 1;}
+
+    CuckooFilter_Free(&f);
+    CuckooFilter_Free(&g);
+    return flag;
+}
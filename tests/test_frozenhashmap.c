@@ -0,0 +1,55 @@
+#include <stdlib.h>
+#include "frozenhashmap.h"
+
+#define NUM_ELEMENTS 5000
+
+int main() {
+
+    // Initialise and populate the map
+    int flag = 0;
+    HashMap h;
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int key = i * 7;
+        int value = i * i;
+        HashMap_Put(&h, &key, &value);
+    }
+
+    // Freeze the map, then free the original.
+    FrozenHashMap f;
+    HashMap_Freeze(&h, &f);
+    HashMap_Free(&h);
+    if (FrozenHashMap_Size(&f) != NUM_ELEMENTS) {flag = 1;}
+
+    // Retrieve every element from the frozen map.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int key = i * 7;
+        int buffer = -1;
+        if (FrozenHashMap_Get(&f, &key, &buffer) != 1) {flag = 1;}
+        if (buffer != i * i) {flag = 1;}
+    }
+
+    // Keys which were never added are not found.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int key = i * 7 + 1;
+        int buffer;
+        if (FrozenHashMap_Get(&f, &key, &buffer) != 0) {flag = 1;}
+    }
+
+    int key = 7;
+    if (FrozenHashMap_Get(&f, &key, NULL) != 0) {flag = 1;}
+    FrozenHashMap_Free(&f);
+
+    // Freeze an empty map.
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    HashMap_Freeze(&h, &f);
+    HashMap_Free(&h);
+
+    int buffer;
+    if (FrozenHashMap_Size(&f) != 0) {flag = 1;}
+    if (FrozenHashMap_Get(&f, &key, &buffer) != 0) {flag = 1;}
+    FrozenHashMap_Free(&f);
+
+    return flag;
+}
@@ -1,7 +1,12 @@
 #include <stdlib.h>
 #include "hashmap.h"
+#include "hash.h"
 
 #define NUM_ELEMENTS 500
+#define NUM_BUILT 100000
+#define NUM_SCANNED 5000
+#define NUM_CLONED 5000
+#define NUM_SWISS 3000
 
 int main() {
 
@@ -66,7 +71,274 @@ int main() {
     key = 1;
     if (HashMap_Get(&h, &key, NULL) != 0) {flag = 1;}
 
+    // Change a value in place.
+    key = 1;
+    int* reference = HashMap_Reference(&h, &key);
+    if (reference == NULL || *reference != 1) {flag = 1;}
+    else {*reference = 5;}
+    if (HashMap_Get(&h, &key, &buffer) != 1 || buffer != 5) {flag = 1;}
+    key = 0;
+    if (HashMap_Reference(&h, &key) != NULL) {flag = 1;}
+
     // Free the map memory
     HashMap_Free(&h);
+
+    // A small map updates, removes and grows past its inline capacity.
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    if (HashMap_Get(&h, &key, &buffer) != 0 || HashMap_Remove(&h, &key) != 0) {flag = 1;}
+    for (int i = 0; i < 8; i++) {HashMap_Put(&h, &i, &i);}
+    key = 3;
+    HashMap_Put(&h, &key, &n);
+    if (HashMap_Size(&h) != 8) {flag = 1;}
+    if (HashMap_Get(&h, &key, &buffer) != 1 || buffer != n) {flag = 1;}
+    if (HashMap_Remove(&h, &key) != 1 || HashMap_Get(&h, &key, &buffer) != 0) {flag = 1;}
+    for (int i = 8; i < 20; i++) {HashMap_Put(&h, &i, &i);}
+    if (HashMap_Size(&h) != 19) {flag = 1;}
+    k = 0;
+    for (current = HashMap_Elements(&h); current != NULL; current = current->next) {
+        if (k == 3) {k++;}
+        if (*((int*) current->key) != k || *((int*) current->value) != k) {flag = 1;}
+        k++;
+    }
+    if (k != 20) {flag = 1;}
+    HashMap_Free(&h);
+
+    // An empty map can be freed and cleared without ever being used.
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    HashMap_Clear(&h);
+    HashMap_Free(&h);
+
+    // Pinned seeds give the same tables on every run.
+    uint64_t seeds[2];
+    for (int run = 0; run < 2; run++) {
+        SEED64_Pin(42);
+        HashMap_Init(&h, sizeof(int), sizeof(int));
+        for (int i = 0; i < 20; i++) {HashMap_Put(&h, &i, &i);}
+        seeds[run] = h.left_seed_0 ^ h.right_seed_1;
+        HashMap_Free(&h);
+    }
+    if (seeds[0] != seeds[1]) {flag = 1;}
+    SEED64_Unpin();
+    if (SEED64() == SEED64()) {flag = 1;}
+
+    // Scan a map while removing the odd keys and putting enough new keys to grow it several times.
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    for (int i = 0; i < NUM_SCANNED; i++) {HashMap_Put(&h, &i, &i);}
+
+    char* seen = calloc(NUM_SCANNED, 1);
+    List scanned_keys, scanned_values;
+    List_Init(&scanned_keys, sizeof(int));
+    List_Init(&scanned_values, sizeof(int));
+
+    uint64_t cursor = 0;
+    int calls = 0;
+    key = NUM_SCANNED;
+    do {
+        cursor = HashMap_Scan(&h, cursor, 64, &scanned_keys, &scanned_values);
+        for (int i = 0; i < List_Length(&scanned_keys); i++) {
+            int scanned = *(int*) List_Elements(&scanned_keys)[i];
+            if (*(int*) List_Elements(&scanned_values)[i] != scanned) {flag = 1;}
+            if (scanned < NUM_SCANNED) {seen[scanned] = 1;}
+        }
+        List_Clear(&scanned_keys);
+        List_Clear(&scanned_values);
+
+        int odd = 2 * calls + 1;
+        HashMap_Remove(&h, &odd);
+        for (int i = 0; i < 200; i++, key++) {HashMap_Put(&h, &key, &key);}
+        calls++;
+    } while (cursor != 0);
+
+    for (int i = 0; i < NUM_SCANNED; i += 2) {
+        if (!seen[i]) {flag = 1;}
+    }
+    if (calls < 2) {flag = 1;}
+
+    free(seen);
+    List_Free(&scanned_keys);
+    List_Free(&scanned_values);
+    HashMap_Free(&h);
+
+    // Build a map from arrays, where every tenth key repeats an earlier one.
+    int* keys = malloc(NUM_BUILT * sizeof(int));
+    int* values = malloc(NUM_BUILT * sizeof(int));
+    for (int i = 0; i < NUM_BUILT; i++) {
+        keys[i] = i % 10 == 9 ? i - 9 : i;
+        values[i] = i;
+    }
+
+    HashMap_BuildFrom(&h, sizeof(int), sizeof(int), keys, values, NUM_BUILT, 4);
+    if (HashMap_Size(&h) != NUM_BUILT - NUM_BUILT / 10) {flag = 1;}
+
+    // Repeated keys keep their last value.
+    for (int i = 0; i < NUM_BUILT; i++) {
+        if (HashMap_Get(&h, &keys[i], &buffer) != 1) {flag = 1;}
+        if (buffer != (keys[i] % 10 == 0 ? keys[i] + 9 : keys[i])) {flag = 1;}
+    }
+
+    // Pairs are listed in the order their keys first appeared.
+    k = 0;
+    current = HashMap_Elements(&h);
+    while (current != NULL) {
+        if (k % 10 == 9) {k++;}
+        if (k != *((int*) current->key)) {flag = 1;}
+        current = current->next;
+        k++;
+    }
+
+    // The result behaves like any other map.
+    key = NUM_BUILT;
+    HashMap_Put(&h, &key, &key);
+    if (HashMap_Remove(&h, &keys[0]) != 1) {flag = 1;}
+    if (HashMap_Get(&h, &key, &buffer) != 1 || buffer != NUM_BUILT) {flag = 1;}
+    HashMap_Free(&h);
+
+    // Build an empty map.
+    HashMap_BuildFrom(&h, sizeof(int), sizeof(int), keys, values, 0, 0);
+    if (HashMap_Size(&h) != 0 || HashMap_Elements(&h) != NULL) {flag = 1;}
+    HashMap_Put(&h, &key, &key);
+    if (HashMap_Size(&h) != 1) {flag = 1;}
+    HashMap_Free(&h);
+
+    // Clone a map, then change the original, the clone and a clone of the clone.
+    HashMap clones[2];
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    for (int i = 0; i < NUM_CLONED; i++) {HashMap_Put(&h, &i, &i);}
+
+    HashMap_Clone(&h, &clones[0]);
+    for (int i = 0; i < NUM_CLONED; i += 2) {
+        int value = -i;
+        HashMap_Put(&h, &i, &value);
+    }
+    HashMap_Clone(&clones[0], &clones[1]);
+    key = 1;
+    *(int*) HashMap_Reference(&clones[0], &key) = NUM_CLONED;
+    if (HashMap_Get(&clones[0], &key, &buffer) != 1 || buffer != NUM_CLONED) {flag = 1;}
+    for (int i = 1; i < NUM_CLONED; i += 4) {HashMap_Remove(&clones[0], &i);}
+    for (int i = NUM_CLONED; i < 4 * NUM_CLONED; i++) {HashMap_Put(&clones[1], &i, &i);}
+
+    // Each map only sees its own changes.
+    if (HashMap_Size(&h) != NUM_CLONED || HashMap_Size(&clones[0]) != NUM_CLONED - NUM_CLONED / 4) {flag = 1;}
+    if (HashMap_Size(&clones[1]) != 4 * NUM_CLONED) {flag = 1;}
+    for (int i = 0; i < NUM_CLONED; i++) {
+        if (HashMap_Get(&h, &i, &buffer) != 1 || buffer != (i % 2 == 0 ? -i : i)) {flag = 1;}
+        if (HashMap_Get(&clones[0], &i, &buffer) == (i % 4 == 1)) {flag = 1;}
+        if (i % 4 != 1 && buffer != i) {flag = 1;}
+        if (HashMap_Get(&clones[1], &i, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+
+    // The clones keep the order of the original.
+    k = 0;
+    for (current = HashMap_Elements(&clones[0]); current != NULL; current = current->next, k++) {
+        if (k % 4 == 1) {k++;}
+        if (k != *((int*) current->key)) {flag = 1;}
+    }
+
+    // Freeing the original leaves the clones whole.
+    HashMap_Free(&h);
+    HashMap_Free(&clones[0]);
+    for (int i = 0; i < 4 * NUM_CLONED; i++) {
+        if (HashMap_Get(&clones[1], &i, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+    HashMap_Free(&clones[1]);
+
+    // Small maps are cloned too.
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    for (int i = 0; i < 4; i++) {HashMap_Put(&h, &i, &i);}
+    HashMap_Clone(&h, &clones[0]);
+    key = 0;
+    HashMap_Remove(&h, &key);
+    if (HashMap_Get(&clones[0], &key, &buffer) != 1 || HashMap_Size(&clones[0]) != 4) {flag = 1;}
+    HashMap_Free(&h);
+    HashMap_Free(&clones[0]);
+
+    // A swiss map puts, updates, removes and lists its pairs like a cuckoo map, through
+    // enough removes to leave deleted slots and enough puts to grow it several times.
+    HashMap_InitEngine(&h, sizeof(int), sizeof(int), HASHMAP_SWISS);
+    for (int i = 0; i < NUM_SWISS; i++) {
+        HashMap_Put(&h, &i, &i);
+        if (i % 3 == 0 && HashMap_Remove(&h, &i) != 1) {flag = 1;}
+    }
+    for (int i = 1; i < NUM_SWISS; i += 3) {
+        int value = -i;
+        HashMap_Put(&h, &i, &value);
+    }
+    if (HashMap_Size(&h) != NUM_SWISS - NUM_SWISS / 3) {flag = 1;}
+    for (int i = 0; i < NUM_SWISS; i++) {
+        if (HashMap_Get(&h, &i, &buffer) == (i % 3 == 0)) {flag = 1;}
+        if (i % 3 != 0 && buffer != (i % 3 == 1 ? -i : i)) {flag = 1;}
+    }
+    k = 1;
+    for (current = HashMap_Elements(&h); current != NULL; current = current->next, k++) {
+        if (k % 3 == 0) {k++;}
+        if (k != *((int*) current->key)) {flag = 1;}
+    }
+    if (k != NUM_SWISS) {flag = 1;}
+
+    key = 2;
+    *(int*) HashMap_Reference(&h, &key) = NUM_SWISS;
+    if (HashMap_Get(&h, &key, &buffer) != 1 || buffer != NUM_SWISS) {flag = 1;}
+    key = 3;
+    if (HashMap_Reference(&h, &key) != NULL || HashMap_Remove(&h, &key) != 0) {flag = 1;}
+
+    // A clone is a copy, in the same order.
+    HashMap_Clone(&h, &clones[0]);
+    key = 1;
+    HashMap_Remove(&h, &key);
+    if (HashMap_Get(&clones[0], &key, &buffer) != 1 || buffer != -1) {flag = 1;}
+    if (clones[0].engine != HASHMAP_SWISS || HashMap_Size(&clones[0]) != NUM_SWISS - NUM_SWISS / 3) {flag = 1;}
+    if (*(int*) HashMap_Elements(&clones[0])->key != 1) {flag = 1;}
+    HashMap_Free(&clones[0]);
+
+    // Clearing keeps the engine.
+    HashMap_Clear(&h);
+    if (h.engine != HASHMAP_SWISS || HashMap_Size(&h) != 0 || HashMap_Get(&h, &key, &buffer) != 0) {flag = 1;}
+
+    // Keeping 100 keys while putting and removing many more fills the table with deleted slots, which
+    // rebuilds it at the same size, as 256 slots are enough for 100 keys.
+    for (int i = 0; i < 20 * NUM_SWISS; i++) {
+        int old = i - 100;
+        HashMap_Put(&h, &i, &i);
+        if (i >= 100 && HashMap_Remove(&h, &old) != 1) {flag = 1;}
+    }
+    if (HashMap_Size(&h) != 100 || h.n > 256) {flag = 1;}
+    for (int i = 20 * NUM_SWISS - 100; i < 20 * NUM_SWISS; i++) {
+        if (HashMap_Get(&h, &i, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+    HashMap_Free(&h);
+
+    // Scan a swiss map while removing keys and growing it, as above.
+    HashMap_InitEngine(&h, sizeof(int), sizeof(int), HASHMAP_SWISS);
+    for (int i = 0; i < NUM_SCANNED; i++) {HashMap_Put(&h, &i, &i);}
+    seen = calloc(NUM_SCANNED, 1);
+    List_Init(&scanned_keys, sizeof(int));
+    cursor = 0;
+    calls = 0;
+    key = NUM_SCANNED;
+    do {
+        cursor = HashMap_Scan(&h, cursor, 64, &scanned_keys, NULL);
+        for (int i = 0; i < List_Length(&scanned_keys); i++) {
+            int scanned = *(int*) List_Elements(&scanned_keys)[i];
+            if (scanned < NUM_SCANNED) {seen[scanned] = 1;}
+        }
+        List_Clear(&scanned_keys);
+
+        int odd = 2 * calls + 1;
+        HashMap_Remove(&h, &odd);
+        for (int i = 0; i < 200; i++, key++) {HashMap_Put(&h, &key, &key);}
+        calls++;
+    } while (cursor != 0);
+
+    for (int i = 0; i < NUM_SCANNED; i += 2) {
+        if (!seen[i]) {flag = 1;}
+    }
+    if (calls < 2) {flag = 1;}
+
+    free(seen);
+    List_Free(&scanned_keys);
+    HashMap_Free(&h);
+
+    free(keys);
+    free(values);
     return flag;
 }
\ No newline at end of file
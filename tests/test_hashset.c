@@ -0,0 +1,96 @@
+#include <stdlib.h>
+#include "hashset.h"
+
+#define NUM_ELEMENTS 500
+
+int main() {
+
+    // Initialise the set
+    int flag = 0;
+    HashSet s;
+    HashSet_Init(&s, sizeof(int));
+
+    // Put a lot of keys in the set to test it, adding each one twice.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int key = i;
+        HashSet_Add(&s, &key);
+        HashSet_Add(&s, &key);
+        if (HashSet_Size(&s) != i+1) {flag = 1;}
+    }
+
+    // Check every key is in the set.
+    for (int i = NUM_ELEMENTS - 1; i >= 0; i--) {
+        if (HashSet_Contains(&s, &i) != 1) {flag = 1;}
+    }
+
+    // The keys should be listed in insertion order.
+    int k = 0;
+    SetKey* current = HashSet_Elements(&s);
+    while (current != NULL) {
+        if (k != *((int*) current->key)) {flag = 1;}
+        current = current->next;
+        k++;
+    }
+    if (k != NUM_ELEMENTS) {flag = 1;}
+
+    // Remove every even key from the set.
+    for (int i = 0; i < NUM_ELEMENTS; i = i + 2) {
+        if (HashSet_Remove(&s, &i) != 1) {flag = 1;}
+        if (HashSet_Remove(&s, &i) != 0) {flag = 1;}
+    }
+    if (HashSet_Size(&s) != NUM_ELEMENTS / 2) {flag = 1;}
+
+    // Test contains many against every key that was added.
+    int keys[NUM_ELEMENTS];
+    bool results[NUM_ELEMENTS];
+    for (int i = 0; i < NUM_ELEMENTS; i++) {keys[i] = i;}
+    if (HashSet_ContainsMany(&s, keys, NUM_ELEMENTS, results) != NUM_ELEMENTS / 2) {flag = 1;}
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (results[i] != (i % 2 == 1)) {flag = 1;}
+    }
+
+    // Build a set of multiples of three.
+    HashSet t;
+    HashSet_Init(&t, sizeof(int));
+    for (int i = 0; i < NUM_ELEMENTS; i = i + 3) {HashSet_Add(&t, &i);}
+
+    // Odd numbers minus multiples of three.
+    HashSet d;
+    HashSet_Init(&d, sizeof(int));
+    HashSet_Union(&d, &s);
+    HashSet_Difference(&d, &t);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (HashSet_Contains(&d, &i) != (i % 2 == 1 && i % 3 != 0)) {flag = 1;}
+    }
+
+    // Odd multiples of three.
+    HashSet_Union(&d, &s);
+    HashSet_Intersection(&d, &t);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (HashSet_Contains(&d, &i) != (i % 2 == 1 && i % 3 == 0)) {flag = 1;}
+    }
+
+    // Odd numbers and multiples of three.
+    HashSet_Union(&d, &s);
+    HashSet_Union(&d, &t);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (HashSet_Contains(&d, &i) != (i % 2 == 1 || i % 3 == 0)) {flag = 1;}
+    }
+
+    // The difference of a set with itself is empty.
+    HashSet_Difference(&d, &d);
+    if (HashSet_Size(&d) != 0) {flag = 1;}
+    if (HashSet_Elements(&d) != NULL) {flag = 1;}
+
+    // Clear the set
+    HashSet_Clear(&s);
+    if (HashSet_Size(&s) != 0) {flag = 1;}
+    int key = 1;
+    if (HashSet_Contains(&s, &key) != 0) {flag = 1;}
+
+    // Free the set memory
+    HashSet_Free(&s);
+    HashSet_Free(&t);
+    HashSet_Free(&d);
+    return flag;
+}
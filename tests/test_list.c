@@ -1,7 +1,41 @@
 #include <stdlib.h>
 #include "list.h"
+#include "threadpool.h"
 
 #define NUM_ELEMENTS 500
+#define NUM_SORTED 20000
+#define NUM_CLONED 5000
+
+struct Record {
+    int key;
+    int seq;
+};
+
+int compare_key(const void* a, const void* b) {
+    return ((const struct Record*) a)->key - ((const struct Record*) b)->key;
+}
+
+int compare(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+void twice(void* element, void* arg) {
+    *(int*) element *= 2;
+}
+
+void add(void* total, const void* element, void* arg) {
+    *(int*) total += *(const int*) element;
+}
+
+bool odd(const void* element, void* arg) {
+    return *(const int*) element % 2 != 0;
+}
+
+bool quarter(const void* element, void* arg) {
+    return *(const int*) element % 4 == 0;
+}
 
 int main() {
 
@@ -14,6 +48,7 @@ int main() {
     // Test pop and shift on an empty list
     if (List_Pop(&l, NULL)) {flag = 1;}
     if (List_Shift(&l, NULL)) {flag = 1;}
+    if (List_RemoveRange(&l, 0, 0) != 1 || List_Elements(&l) != NULL) {flag = 1;}
     
     // Put a lot of elements in the map to test it.
     for (int i = 0; i < NUM_ELEMENTS; i++) {
@@ -130,6 +165,149 @@ int main() {
     if (List_Remove(&l, 2) != 0) {flag = 1;}
     if (List_Remove(&l, -100) != 0) {flag = 1;}
 
+    // Test the bulk operations
+    int batch[6] = {0, 1, 2, 3, 4, 5};
+    List_Extend(&l, batch, 6);
+    List_Extend(&l, batch, 0);
+    // [0, 1, 2, 3, 4, 5]
+
+    int middle[3] = {10, 11, 12};
+    if (List_InsertRange(&l, 2, middle, 3) != 1) {flag = 1;}
+    if (List_InsertRange(&l, 10, middle, 3) != 0) {flag = 1;}
+    // [0, 1, 10, 11, 12, 2, 3, 4, 5]
+
+    List slice;
+    if (List_Slice(&l, 1, 4, &slice) != 1) {flag = 1;}
+    if (List_Slice(&l, 4, 10, &slice) != 0) {flag = 1;}
+    if (List_Length(&slice) != 3) {flag = 1;}
+    List_Get(&slice, 0, &buffer);
+    if (buffer != 1) {flag = 1;}
+    List_Get(&slice, 2, &buffer);
+    if (buffer != 11) {flag = 1;}
+    List_Free(&slice);
+
+    if (List_RemoveRange(&l, 2, 5) != 1) {flag = 1;}
+    if (List_RemoveRange(&l, 5, 2) != 0) {flag = 1;}
+    // [0, 1, 2, 3, 4, 5]
+
+    if (List_RemoveIf(&l, odd, NULL) != 3) {flag = 1;}
+    // [0, 2, 4]
+
+    if (List_Length(&l) != 3) {flag = 1;}
+    for (int i = 0; i < 3; i++) {
+        List_Get(&l, i, &buffer);
+        if (buffer != 2 * i) {flag = 1;}
+    }
+    List_RemoveRange(&l, 0, List_Length(&l));
+    if (List_Length(&l) != 0) {flag = 1;}
+
+    // Fill the list with a scrambled sequence long enough to use the thread pool.
+    for (int i = 0; i < NUM_SORTED; i++) {
+        int element = (int) (((long long) i * 7919) % NUM_SORTED) - NUM_SORTED / 2;
+        List_Push(&l, &element);
+    }
+
+    // Test the merge sort
+    List_Sort(&l, compare);
+    for (int i = 0; i < NUM_SORTED; i++) {
+        List_Get(&l, i, &buffer);
+        if (buffer != i - NUM_SORTED / 2) {flag = 1;}
+    }
+
+    // Test the binary search
+    element = 1234;
+    if (List_BinarySearch(&l, &element, compare) != 1234 + NUM_SORTED / 2) {flag = 1;}
+    element = NUM_SORTED;
+    if (List_BinarySearch(&l, &element, compare) != -1) {flag = 1;}
+
+    // Test the map and reduce, the sum of 2i - n over every i is -n.
+    List_Map(&l, twice, NULL);
+    int sum = 0;
+    List_Reduce(&l, add, NULL, &sum);
+    if (sum != -NUM_SORTED) {flag = 1;}
+
+    // Test the filter, keeping the elements which are multiples of four.
+    if (List_Filter(&l, quarter, NULL) != NUM_SORTED / 2) {flag = 1;}
+    if (List_Length(&l) != NUM_SORTED / 2) {flag = 1;}
+    List_Get(&l, 1, &buffer);
+    if (buffer != -NUM_SORTED + 4) {flag = 1;}
+
+    // Test the radix sort on signed integers after scrambling the list again.
+    List_Clear(&l);
+    for (int i = 0; i < NUM_SORTED; i++) {
+        int element = (int) (((long long) i * 104729) % NUM_SORTED) - NUM_SORTED / 2;
+        List_Push(&l, &element);
+    }
+    if (List_SortIntegers(&l, 1) != 1) {flag = 1;}
+    for (int i = 0; i < NUM_SORTED; i++) {
+        List_Get(&l, i, &buffer);
+        if (buffer != i - NUM_SORTED / 2) {flag = 1;}
+    }
+
+    // The radix sort only takes fixed width integers.
+    List d;
+    List_Init(&d, 3);
+    if (List_SortIntegers(&d, 0) != 0) {flag = 1;}
+    List_Free(&d);
+
+    // The merge sort is stable, so records with the same key keep their order.
+    // Several threads are used so the parallel merge rounds are checked too.
+    ThreadPool_SetThreads(4);
+    List records;
+    List_Init(&records, sizeof(struct Record));
+    for (int i = 0; i < NUM_SORTED; i++) {
+        struct Record record = {(int) (((long long) i * 7919) % 13), i};
+        List_Push(&records, &record);
+    }
+    List_Sort(&records, compare_key);
+    struct Record previous = {-1, -1};
+    for (int i = 0; i < NUM_SORTED; i++) {
+        struct Record record;
+        List_Get(&records, i, &record);
+        if (record.key < previous.key) {flag = 1;}
+        if (record.key == previous.key && record.seq < previous.seq) {flag = 1;}
+        previous = record;
+    }
+    List_Free(&records);
+
+    // Clone a list, then change the original, the clone and a clone of the clone.
+    List clones[2];
+    List_Clear(&l);
+    for (int i = 0; i < NUM_CLONED; i++) {List_Push(&l, &i);}
+
+    List_Clone(&l, &clones[0]);
+    for (int i = 0; i < 10; i++) {List_Push(&l, &i);}
+    List_Clone(&clones[0], &clones[1]);
+    List_Pop(&clones[0], NULL);
+    List_RemoveRange(&clones[0], 0, 10);
+    buffer = -1;
+    List_Unshift(&clones[1], &buffer);
+
+    // Each list only sees its own changes.
+    if (List_Length(&l) != NUM_CLONED + 10 || List_Length(&clones[0]) != NUM_CLONED - 11) {flag = 1;}
+    if (List_Length(&clones[1]) != NUM_CLONED + 1) {flag = 1;}
+    for (int i = 0; i < NUM_CLONED; i++) {
+        if (List_Get(&l, i, &buffer) != 1 || buffer != i) {flag = 1;}
+        if (List_Get(&clones[1], i + 1, &buffer) != 1 || buffer != i) {flag = 1;}
+        if (i < NUM_CLONED - 11 && (List_Get(&clones[0], i, &buffer) != 1 || buffer != i + 10)) {flag = 1;}
+    }
+
+    // Freeing the original leaves the clones whole.
+    List_Free(&l);
+    List_Sort(&clones[1], compare);
+    for (int i = 0; i < NUM_CLONED; i++) {
+        if (List_Get(&clones[1], i + 1, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+    List_Free(&clones[0]);
+    List_Free(&clones[1]);
+
+    // Empty lists are cloned too.
+    List_Init(&l, sizeof(int));
+    List_Clone(&l, &clones[0]);
+    List_Push(&clones[0], &buffer);
+    if (List_Length(&l) != 0 || List_Length(&clones[0]) != 1) {flag = 1;}
+    List_Free(&clones[0]);
+
     List_Free(&l);
     return flag;
 }
\ No newline at end of file
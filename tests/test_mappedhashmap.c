@@ -0,0 +1,82 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <stdio.h>
+#include <unistd.h>
+#include "mappedhashmap.h"
+
+#define NUM_ELEMENTS 5000
+
+int main() {
+
+    // Create an empty file to hold the map.
+    int flag = 0;
+    char path[] = "/tmp/test_mappedhashmap_XXXXXX";
+    int fd = mkstemp(path);
+    if (fd < 0) {return 1;}
+    close(fd);
+
+    MappedHashMap m;
+    if (MappedHashMap_Open(&m, path, sizeof(int), sizeof(double)) != 1) {return 1;}
+
+    // Put enough elements to grow the file several times.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        double value = i * 0.5;
+        if (MappedHashMap_Put(&m, &i, &value) != 1) {flag = 1;}
+        if (MappedHashMap_Size(&m) != i+1) {flag = 1;}
+    }
+
+    // Update and remove some of them.
+    for (int i = 0; i < NUM_ELEMENTS; i += 2) {
+        double value = -i;
+        MappedHashMap_Put(&m, &i, &value);
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i += 3) {
+        if (MappedHashMap_Remove(&m, &i) != 1) {flag = 1;}
+        if (MappedHashMap_Remove(&m, &i) != 0) {flag = 1;}
+    }
+
+    int size = MappedHashMap_Size(&m);
+    if (MappedHashMap_Sync(&m) != 1) {flag = 1;}
+    MappedHashMap_Close(&m);
+
+    // A map of other sizes cannot be opened from the file.
+    if (MappedHashMap_Open(&m, path, sizeof(int), sizeof(int)) != 0) {flag = 1;}
+
+    // Reopen the map and check it survived.
+    if (MappedHashMap_Open(&m, path, sizeof(int), sizeof(double)) != 1) {return 1;}
+    if (MappedHashMap_Size(&m) != size) {flag = 1;}
+
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        double buffer;
+        bool found = MappedHashMap_Get(&m, &i, &buffer);
+        if (i % 3 == 0) {
+            if (found) {flag = 1;}
+        } else {
+            if (!found) {flag = 1;}
+            if (buffer != (i % 2 == 0 ? -i : i * 0.5)) {flag = 1;}
+        }
+    }
+
+    int key = NUM_ELEMENTS;
+    double buffer;
+    if (MappedHashMap_Get(&m, &key, &buffer) != 0) {flag = 1;}
+    if (MappedHashMap_Get(&m, &key, NULL) != 0) {flag = 1;}
+
+    // A file left longer than its tables by a failed grow still opens, and grows past the extra space.
+    off_t length = m.length;
+    MappedHashMap_Close(&m);
+    if (truncate(path, length + 4096) != 0) {flag = 1;}
+    if (MappedHashMap_Open(&m, path, sizeof(int), sizeof(double)) != 1) {return 1;}
+    if (MappedHashMap_Size(&m) != size) {flag = 1;}
+    for (int i = NUM_ELEMENTS; i < 4 * NUM_ELEMENTS; i++) {
+        double value = i;
+        if (MappedHashMap_Put(&m, &i, &value) != 1) {flag = 1;}
+    }
+    for (int i = NUM_ELEMENTS; i < 4 * NUM_ELEMENTS; i++) {
+        if (MappedHashMap_Get(&m, &i, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+
+    MappedHashMap_Close(&m);
+    unlink(path);
+    return flag;
+}
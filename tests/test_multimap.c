@@ -0,0 +1,73 @@
+#include <stdlib.h>
+#include "multimap.h"
+
+#define NUM_KEYS 500
+#define NUM_VALUES 5000
+
+int main() {
+
+    // Initialise the map
+    int flag = 0;
+    MultiMap m;
+    MultiMap_Init(&m, sizeof(int), sizeof(int));
+
+    // Give key k every value below NUM_VALUES which is k modulo NUM_KEYS.
+    for (int i = 0; i < NUM_VALUES; i++) {
+        int key = i % NUM_KEYS;
+        MultiMap_Put(&m, &key, &i);
+    }
+    if (MultiMap_Size(&m) != NUM_VALUES || MultiMap_Keys(&m) != NUM_KEYS) {flag = 1;}
+
+    // Every key holds its values in the order they were put.
+    for (int key = 0; key < NUM_KEYS; key++) {
+        int count;
+        int* values = MultiMap_Get(&m, &key, &count);
+        if (values == NULL || count != NUM_VALUES / NUM_KEYS) {flag = 1; continue;}
+        for (int i = 0; i < count; i++) {
+            if (values[i] != key + i * NUM_KEYS) {flag = 1;}
+        }
+    }
+
+    // A key without values gives nothing back.
+    int key = NUM_KEYS;
+    int count = -1;
+    if (MultiMap_Get(&m, &key, &count) != NULL || count != 0) {flag = 1;}
+
+    // Remove a value from the middle of a run, then one which is not there.
+    key = 3;
+    int value = 3 + 4 * NUM_KEYS;
+    if (MultiMap_RemoveValue(&m, &key, &value) != 1) {flag = 1;}
+    if (MultiMap_RemoveValue(&m, &key, &value) != 0) {flag = 1;}
+    int* values = MultiMap_Get(&m, &key, &count);
+    if (count != NUM_VALUES / NUM_KEYS - 1 || values[4] != 3 + 5 * NUM_KEYS) {flag = 1;}
+
+    // Removing the last value of a key removes the key.
+    MultiMap_Put(&m, &(int) {-1}, &value);
+    key = -1;
+    if (MultiMap_RemoveValue(&m, &key, &value) != 1 || MultiMap_Keys(&m) != NUM_KEYS) {flag = 1;}
+
+    // Remove whole keys.
+    key = 0;
+    if (MultiMap_Remove(&m, &key) != 1 || MultiMap_Remove(&m, &key) != 0) {flag = 1;}
+    if (MultiMap_Size(&m) != NUM_VALUES - NUM_VALUES / NUM_KEYS - 1) {flag = 1;}
+
+    // The keys are listed in the order they were first put.
+    int expected = 1;
+    int total = 0;
+    for (KeyValue* e = MultiMap_Elements(&m); e != NULL; e = e->next) {
+        if (*(int*) e->key != expected++) {flag = 1;}
+        MultiMap_Values(e, &count);
+        total += count;
+    }
+    if (total != MultiMap_Size(&m)) {flag = 1;}
+
+    // Clear the map and use it again.
+    MultiMap_Clear(&m);
+    if (MultiMap_Size(&m) != 0 || MultiMap_Elements(&m) != NULL) {flag = 1;}
+    MultiMap_Put(&m, &key, &value);
+    if (MultiMap_Size(&m) != 1) {flag = 1;}
+
+    // Free the map memory
+    MultiMap_Free(&m);
+    return flag;
+}
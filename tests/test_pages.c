@@ -0,0 +1,62 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include "pages.h"
+#include "hashmap.h"
+#include "list.h"
+
+#define NUM_ELEMENTS 300000
+
+int main() {
+
+    int flag = 0;
+    int options[4] = {0, PAGES_HUGE, PAGES_HUGE | PAGES_INTERLEAVE, PAGES_BIND};
+
+    for (int o = 0; o < 4; o++) {
+
+        Pages_SetOptions(options[o], 0);
+
+        // Small allocations behave like malloc.
+        int* small = Pages_Alloc(16 * sizeof(int));
+        for (int i = 0; i < 16; i++) {small[i] = i;}
+        small = Pages_Realloc(small, 16 * sizeof(int), 32 * sizeof(int));
+        for (int i = 0; i < 16; i++) {if (small[i] != i) {flag = 1;}}
+        Pages_Free(small, 32 * sizeof(int));
+
+        // Large allocations start zeroed and keep their contents when resized.
+        size_t length = PAGES_LARGE / sizeof(uint64_t) + 1;
+        uint64_t* large = Pages_Alloc(length * sizeof(uint64_t));
+        if (large == NULL) {return 1;}
+        for (size_t i = 0; i < length; i++) {
+            if (large[i] != 0) {flag = 1;}
+            large[i] = i;
+        }
+        large = Pages_Realloc(large, length * sizeof(uint64_t), 3 * length * sizeof(uint64_t));
+        for (size_t i = 0; i < length; i++) {if (large[i] != i) {flag = 1;}}
+        large = Pages_Realloc(large, 3 * length * sizeof(uint64_t), 16 * sizeof(uint64_t));
+        for (size_t i = 0; i < 16; i++) {if (large[i] != i) {flag = 1;}}
+        Pages_Free(large, 16 * sizeof(uint64_t));
+
+    }
+
+    // Maps and lists with large tables still work with every option on.
+    Pages_SetOptions(PAGES_HUGE | PAGES_INTERLEAVE, 0);
+
+    HashMap h;
+    List l;
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    List_Init(&l, sizeof(int));
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        HashMap_Put(&h, &i, &i);
+        List_Push(&l, &i);
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int buffer;
+        if (HashMap_Get(&h, &i, &buffer) != 1 || buffer != i) {flag = 1;}
+        if (List_Get(&l, i, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+    HashMap_Free(&h);
+    List_Free(&l);
+
+    Pages_SetOptions(0, 0);
+    return flag;
+}
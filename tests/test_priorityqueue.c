@@ -0,0 +1,103 @@
+#include <stdlib.h>
+#include "priorityqueue.h"
+
+#define NUM_ELEMENTS 2000
+
+int compare(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+int main() {
+
+    // Initialise the queue
+    int flag = 0;
+    PriorityQueue pq;
+    PriorityQueue_Init(&pq, sizeof(int), 4, compare);
+    int buffer;
+
+    // Test an empty queue
+    if (PriorityQueue_Peek(&pq, &buffer) != 0) {flag = 1;}
+    if (PriorityQueue_Pop(&pq, &buffer) != 0) {flag = 1;}
+    if (PriorityQueue_Get(&pq, 0, &buffer) != 0) {flag = 1;}
+
+    // Push a scrambled sequence, remembering the handles.
+    int handles[NUM_ELEMENTS];
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int element = (i * 7919) % NUM_ELEMENTS;
+        handles[element] = PriorityQueue_Push(&pq, &element);
+        if (PriorityQueue_Length(&pq) != i+1) {flag = 1;}
+    }
+
+    // Handles refer to the right elements.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (PriorityQueue_Get(&pq, handles[i], &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+
+    // Decrease the key of the largest element so it comes out first.
+    int element = -1;
+    if (PriorityQueue_Update(&pq, handles[NUM_ELEMENTS - 1], &element) != 1) {flag = 1;}
+    if (PriorityQueue_Peek(&pq, &buffer) != 1 || buffer != -1) {flag = 1;}
+
+    // Increase the key of the smallest element so it comes out last.
+    element = NUM_ELEMENTS * 2;
+    if (PriorityQueue_Update(&pq, handles[0], &element) != 1) {flag = 1;}
+
+    // Remove every multiple of ten by handle.
+    int removed = 0;
+    for (int i = 10; i < NUM_ELEMENTS - 1; i += 10) {
+        if (PriorityQueue_Remove(&pq, handles[i]) != 1) {flag = 1;}
+        if (PriorityQueue_Remove(&pq, handles[i]) != 0) {flag = 1;}
+        removed++;
+    }
+    if (PriorityQueue_Length(&pq) != NUM_ELEMENTS - removed) {flag = 1;}
+
+    // Everything comes out in order.
+    int last = -2;
+    int count = 0;
+    while (PriorityQueue_Pop(&pq, &buffer)) {
+        if (buffer < last) {flag = 1;}
+        if (buffer > 0 && buffer < NUM_ELEMENTS && buffer % 10 == 0) {flag = 1;}
+        last = buffer;
+        count++;
+    }
+    if (count != NUM_ELEMENTS - removed) {flag = 1;}
+    if (last != NUM_ELEMENTS * 2) {flag = 1;}
+
+    // Build a binary heap from a list.
+    List l;
+    List_Init(&l, sizeof(int));
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        element = (i * 104729) % NUM_ELEMENTS;
+        List_Push(&l, &element);
+    }
+
+    PriorityQueue_Free(&pq);
+    PriorityQueue_Init(&pq, sizeof(int), 2, compare);
+    if (PriorityQueue_FromList(&pq, &l) != 1) {flag = 1;}
+    if (PriorityQueue_Length(&pq) != NUM_ELEMENTS) {flag = 1;}
+
+    // Handles follow the order of the list.
+    List_Get(&l, 5, &element);
+    if (PriorityQueue_Get(&pq, 5, &buffer) != 1 || buffer != element) {flag = 1;}
+
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        if (PriorityQueue_Pop(&pq, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+
+    // Lists of other element sizes are rejected.
+    List d;
+    List_Init(&d, sizeof(double));
+    if (PriorityQueue_FromList(&pq, &d) != 0) {flag = 1;}
+
+    // Clear the queue
+    PriorityQueue_Push(&pq, &element);
+    PriorityQueue_Clear(&pq);
+    if (PriorityQueue_Length(&pq) != 0) {flag = 1;}
+
+    List_Free(&l);
+    List_Free(&d);
+    PriorityQueue_Free(&pq);
+    return flag;
+}
@@ -0,0 +1,144 @@
+#define _POSIX_C_SOURCE 200809L
+#include <stdlib.h>
+#include <time.h>
+#include <threads.h>
+#include "queue.h"
+
+#define NUM_ELEMENTS 20000
+#define NUM_THREADS 4
+
+Queue q;
+SPSCQueue s;
+atomic_llong total;
+
+int produce(void* arg) {
+    int start = *(int*) arg;
+    for (int i = start; i < NUM_ELEMENTS; i += NUM_THREADS) {Queue_PushWait(&q, &i);}
+    return 0;
+}
+
+int consume(void* arg) {
+    long long sum = 0;
+    int buffer[8];
+    for (int i = 0; i < NUM_ELEMENTS / NUM_THREADS;) {
+        int want = NUM_ELEMENTS / NUM_THREADS - i < 8 ? NUM_ELEMENTS / NUM_THREADS - i : 8;
+        int got = Queue_ShiftMany(&q, buffer, want);
+        if (got == 0) {thrd_yield();}
+        for (int j = 0; j < got; j++) {sum += buffer[j];}
+        i += got;
+    }
+    atomic_fetch_add(&total, sum);
+    return 0;
+}
+
+int produce_single(void* arg) {
+    int batch[3];
+    for (int i = 0; i < NUM_ELEMENTS;) {
+        if (i % 2 == 0) {
+            SPSCQueue_PushWait(&s, &i);
+            i++;
+        } else {
+            int n = NUM_ELEMENTS - i < 3 ? NUM_ELEMENTS - i : 3;
+            for (int j = 0; j < n; j++) {batch[j] = i + j;}
+            int pushed = SPSCQueue_PushMany(&s, batch, n);
+            if (pushed == 0) {thrd_yield();}
+            i += pushed;
+        }
+    }
+    return 0;
+}
+
+// Waits on an empty queue, and records how much processor time the wait took.
+int wait_single(void* arg) {
+    struct timespec start, end;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &start);
+    SPSCQueue_ShiftWait(&s, arg);
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &end);
+    ((int*) arg)[1] = (int) ((end.tv_sec - start.tv_sec) * 1000 + (end.tv_nsec - start.tv_nsec) / 1000000);
+    return 0;
+}
+
+int main() {
+
+    int flag = 0;
+    int buffer;
+
+    // Test an empty and full queue on a single thread.
+    Queue_Init(&q, sizeof(int), 5);
+    if (Queue_Shift(&q, &buffer) != 0) {flag = 1;}
+    for (int i = 0; i < 8; i++) {
+        if (Queue_Push(&q, &i) != 1) {flag = 1;}
+    }
+    if (Queue_Push(&q, &buffer) != 0) {flag = 1;}
+    if (Queue_Length(&q) != 8) {flag = 1;}
+
+    // Elements come out in the order they went in.
+    for (int i = 0; i < 4; i++) {
+        if (Queue_Shift(&q, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+
+    // Batches are cut short by the space available.
+    int elements[6] = {8, 9, 10, 11, 12, 13};
+    if (Queue_PushMany(&q, elements, 6) != 4) {flag = 1;}
+    int shifted[10];
+    if (Queue_ShiftMany(&q, shifted, 10) != 8) {flag = 1;}
+    for (int i = 0; i < 8; i++) {
+        if (shifted[i] != i + 4) {flag = 1;}
+    }
+    if (Queue_ShiftMany(&q, shifted, 10) != 0) {flag = 1;}
+    Queue_Free(&q);
+
+    // Many producers and many consumers, every element arrives exactly once.
+    Queue_Init(&q, sizeof(int), 64);
+    atomic_init(&total, 0);
+    thrd_t producers[NUM_THREADS];
+    thrd_t consumers[NUM_THREADS];
+    int starts[NUM_THREADS];
+    for (int i = 0; i < NUM_THREADS; i++) {
+        starts[i] = i;
+        thrd_create(&producers[i], produce, &starts[i]);
+        thrd_create(&consumers[i], consume, NULL);
+    }
+    for (int i = 0; i < NUM_THREADS; i++) {
+        thrd_join(producers[i], NULL);
+        thrd_join(consumers[i], NULL);
+    }
+    if (atomic_load(&total) != (long long) NUM_ELEMENTS * (NUM_ELEMENTS - 1) / 2) {flag = 1;}
+    if (Queue_Length(&q) != 0) {flag = 1;}
+    Queue_Free(&q);
+
+    // One producer and one consumer, elements arrive in order.
+    SPSCQueue_Init(&s, sizeof(int), 16);
+    if (SPSCQueue_Shift(&s, &buffer) != 0) {flag = 1;}
+    thrd_t producer;
+    thrd_create(&producer, produce_single, NULL);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        SPSCQueue_ShiftWait(&s, &buffer);
+        if (buffer != i) {flag = 1;}
+    }
+    thrd_join(producer, NULL);
+    if (SPSCQueue_Length(&s) != 0) {flag = 1;}
+
+    // Fill the single producer queue to the brim.
+    for (int i = 0; i < 16; i++) {
+        if (SPSCQueue_Push(&s, &i) != 1) {flag = 1;}
+    }
+    if (SPSCQueue_Push(&s, &buffer) != 0) {flag = 1;}
+    if (SPSCQueue_ShiftMany(&s, shifted, 10) != 10) {flag = 1;}
+    if (shifted[9] != 9) {flag = 1;}
+    SPSCQueue_ShiftMany(&s, NULL, 10);
+
+    // A consumer waiting on an empty queue sleeps rather than spins, and wakes for the next push.
+    int waited[2] = {0, -1};
+    thrd_t consumer;
+    thrd_create(&consumer, wait_single, waited);
+    thrd_sleep(&(struct timespec) {.tv_nsec = 100000000}, NULL);
+    int element = 42;
+    SPSCQueue_Push(&s, &element);
+    thrd_join(consumer, NULL);
+    if (waited[0] != 42) {flag = 1;}
+    if (waited[1] < 0 || waited[1] > 50) {flag = 1;}
+    SPSCQueue_Free(&s);
+
+    return flag;
+}
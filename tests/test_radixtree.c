@@ -0,0 +1,171 @@
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "radixtree.h"
+
+#define NUM_KEYS 20000
+#define MAX_LENGTH 12
+
+struct Key {
+    size_t length;
+    uint8_t bytes[MAX_LENGTH];
+};
+
+int compare(const void* a, const void* b) {
+    const struct Key* x = a;
+    const struct Key* y = b;
+    size_t shared = x->length < y->length ? x->length : y->length;
+    int order = memcmp(x->bytes, y->bytes, shared);
+    if (order != 0) {return order;}
+    return (x->length > y->length) - (x->length < y->length);
+}
+
+int main() {
+
+    // Initialise the tree
+    int flag = 0;
+    RadixTree t;
+    RadixTree_Init(&t, sizeof(int));
+
+    // Make keys over a small alphabet so they share long prefixes, with some over every byte so nodes fill up.
+    struct Key* keys = malloc(NUM_KEYS * sizeof(struct Key));
+    uint32_t state = 7;
+    for (int i = 0; i < NUM_KEYS; i++) {
+        state = state * 1103515245 + 12345;
+        keys[i].length = (state >> 16) % (MAX_LENGTH + 1);
+        for (size_t j = 0; j < keys[i].length; j++) {
+            state = state * 1103515245 + 12345;
+            keys[i].bytes[j] = i % 10 == 0 ? (uint8_t) (state >> 16) : "abcd"[(state >> 16) % 4];
+        }
+    }
+
+    // Sort the keys and drop repeats to get the expected order.
+    qsort(keys, NUM_KEYS, sizeof(struct Key), compare);
+    int unique = 0;
+    for (int i = 0; i < NUM_KEYS; i++) {
+        if (unique == 0 || compare(&keys[unique - 1], &keys[i]) != 0) {keys[unique++] = keys[i];}
+    }
+
+    // Put the keys in a scattered order, then put them all again to replace the values.
+    for (int i = 0; i < unique; i++) {
+        int k = (int) ((i * 7919L) % unique);
+        int value = -1;
+        RadixTree_Put(&t, keys[k].bytes, keys[k].length, &value);
+    }
+    if (RadixTree_Size(&t) != (size_t) unique) {flag = 1;}
+    for (int i = 0; i < unique; i++) {RadixTree_Put(&t, keys[i].bytes, keys[i].length, &i);}
+    if (RadixTree_Size(&t) != (size_t) unique) {flag = 1;}
+
+    // Get every key back.
+    for (int i = 0; i < unique; i++) {
+        int value;
+        if (!RadixTree_Get(&t, keys[i].bytes, keys[i].length, &value) || value != i) {flag = 1;}
+    }
+    int value;
+    if (RadixTree_Get(&t, "abcdabcdabcdabcd", 16, &value)) {flag = 1;}
+
+    // Visit the keys in order.
+    int i = 0;
+    for (RadixTreeIterator it = RadixTree_First(&t); RadixTreeIterator_Valid(&it); RadixTreeIterator_Next(&it), i++) {
+        size_t length;
+        const void* key = RadixTreeIterator_Key(&it, &length);
+        if (i >= unique || length != keys[i].length || memcmp(key, keys[i].bytes, length) != 0) {flag = 1; break;}
+        if (*(int*) RadixTreeIterator_Value(&it) != i) {flag = 1;}
+    }
+    if (i != unique) {flag = 1;}
+
+    // Visit the keys with a prefix, which are the ones between two bounds of the sorted keys.
+    const char* prefixes[] = {"", "a", "ab", "dcb", "abcdab", "bbbbbbbbbbbbb"};
+    for (int p = 0; p < 6; p++) {
+        size_t length = strlen(prefixes[p]);
+        int expected = 0;
+        int first = -1;
+        for (int k = 0; k < unique; k++) {
+            if (keys[k].length >= length && memcmp(keys[k].bytes, prefixes[p], length) == 0) {
+                if (first < 0) {first = k;}
+                expected++;
+            }
+        }
+        int count = 0;
+        for (RadixTreeIterator it = RadixTree_Prefix(&t, prefixes[p], length); RadixTreeIterator_Valid(&it); RadixTreeIterator_Next(&it)) {
+            if (*(int*) RadixTreeIterator_Value(&it) != first + count) {flag = 1;}
+            count++;
+        }
+        if (count != expected) {flag = 1;}
+    }
+
+    // Lower bounds land on the next key in order.
+    for (int k = 0; k < unique; k += 13) {
+        struct Key probe = keys[k];
+        probe.bytes[probe.length++ % MAX_LENGTH] = 0xff;
+        struct Key* next = NULL;
+        for (int j = 0; j < unique; j++) {
+            if (compare(&keys[j], &probe) >= 0) {next = &keys[j]; break;}
+        }
+        RadixTreeIterator it = RadixTree_LowerBound(&t, probe.bytes, probe.length);
+        if (RadixTreeIterator_Valid(&it) != (next != NULL)) {flag = 1;}
+        else if (next != NULL && *(int*) RadixTreeIterator_Value(&it) != next - keys) {flag = 1;}
+    }
+
+    // Remove every other key, then check the rest are still there in order.
+    for (int k = 0; k < unique; k += 2) {
+        if (!RadixTree_Remove(&t, keys[k].bytes, keys[k].length)) {flag = 1;}
+        if (RadixTree_Remove(&t, keys[k].bytes, keys[k].length)) {flag = 1;}
+    }
+    if (RadixTree_Size(&t) != (size_t) (unique / 2)) {flag = 1;}
+    i = 1;
+    for (RadixTreeIterator it = RadixTree_First(&t); RadixTreeIterator_Valid(&it); RadixTreeIterator_Next(&it), i += 2) {
+        if (*(int*) RadixTreeIterator_Value(&it) != i) {flag = 1;}
+    }
+    for (int k = 0; k < unique; k++) {
+        if (RadixTree_Get(&t, keys[k].bytes, keys[k].length, &value) != (k % 2 == 1)) {flag = 1;}
+    }
+
+    // Remove the rest, leaving an empty tree.
+    for (int k = 1; k < unique; k += 2) {
+        if (!RadixTree_Remove(&t, keys[k].bytes, keys[k].length)) {flag = 1;}
+    }
+    RadixTreeIterator it = RadixTree_First(&t);
+    if (RadixTree_Size(&t) != 0 || RadixTreeIterator_Valid(&it)) {flag = 1;}
+
+    // Route paths to the handler of their longest prefix.
+    const char* routes[] = {"/", "/api", "/api/v1", "/api/v1/users", "/static/"};
+    for (int r = 0; r < 5; r++) {RadixTree_Put(&t, routes[r], strlen(routes[r]), &r);}
+    const char* paths[] = {"/api/v1/users/42", "/api/v2", "/apix", "/static/a.css", "/", "index"};
+    int handlers[] = {3, 1, 1, 4, 0, -1};
+    for (int p = 0; p < 6; p++) {
+        size_t match = 0;
+        int handler = -1;
+        bool found = RadixTree_LongestPrefix(&t, paths[p], strlen(paths[p]), &match, &handler);
+        if (found != (handlers[p] >= 0) || handler != handlers[p]) {flag = 1;}
+        if (found && match != strlen(routes[handler])) {flag = 1;}
+    }
+
+    // Keys may be empty or hold zero bytes, and prefix nodes longer than the inline bytes split correctly.
+    RadixTree_Clear(&t);
+    const char long_keys[][40] = {"a long shared prefix, then one", "a long shared prefix, then two", "a long shared", "a long"};
+    for (int k = 0; k < 4; k++) {RadixTree_Put(&t, long_keys[k], strlen(long_keys[k]), &k);}
+    RadixTree_Put(&t, "", 0, &(int) {4});
+    RadixTree_Put(&t, "\0\0", 2, &(int) {5});
+    for (int k = 0; k < 4; k++) {
+        if (!RadixTree_Get(&t, long_keys[k], strlen(long_keys[k]), &value) || value != k) {flag = 1;}
+    }
+    if (!RadixTree_Get(&t, "", 0, &value) || value != 4) {flag = 1;}
+    if (!RadixTree_Get(&t, "\0\0", 2, &value) || value != 5 || RadixTree_Get(&t, "\0", 1, &value)) {flag = 1;}
+    if (!RadixTree_Remove(&t, "a long shared", 13) || !RadixTree_Remove(&t, "a long", 6)) {flag = 1;}
+    if (!RadixTree_Get(&t, long_keys[1], strlen(long_keys[1]), &value) || value != 1) {flag = 1;}
+    if (RadixTree_Size(&t) != 4) {flag = 1;}
+
+    // Bounds which part from a long prefix land before or after the whole node.
+    it = RadixTree_LowerBound(&t, "a long s", 8);
+    if (!RadixTreeIterator_Valid(&it) || *(int*) RadixTreeIterator_Value(&it) != 0) {flag = 1;}
+    it = RadixTree_LowerBound(&t, "a long a", 8);
+    if (!RadixTreeIterator_Valid(&it) || *(int*) RadixTreeIterator_Value(&it) != 0) {flag = 1;}
+    it = RadixTree_LowerBound(&t, "a long z", 8);
+    if (RadixTreeIterator_Valid(&it)) {flag = 1;}
+
+    // Free the tree memory
+    RadixTree_Free(&t);
+    free(keys);
+    return flag;
+}
@@ -0,0 +1,156 @@
+#include <stdlib.h>
+#include <string.h>
+#include "rope.h"
+
+#define NUM_ELEMENTS 5000
+#define NUM_LARGE 1000000
+
+int chunks(Rope* r) {
+    int count;
+    int chunks = 0;
+    for (int i = 0; i < Rope_Length(r); i += count) {
+        Rope_Chunk(r, i, &count);
+        chunks++;
+    }
+    return chunks;
+}
+
+int depth(RopeNode* node) {
+    if (node == NULL) {return 0;}
+    int left = depth(node->left);
+    int right = depth(node->right);
+    return 1 + (left > right ? left : right);
+}
+
+int main() {
+
+    // Initialise the rope, with a plain array to check it against.
+    int flag = 0;
+    Rope r;
+    Rope_Init(&r, sizeof(int));
+    int* expected = malloc(2 * NUM_ELEMENTS * sizeof(int));
+    int length = 0;
+    int buffer;
+
+    // Test an empty rope
+    if (Rope_Length(&r) != 0) {flag = 1;}
+    if (Rope_Get(&r, 0, &buffer) != 0) {flag = 1;}
+    if (Rope_Remove(&r, 0) != 0) {flag = 1;}
+    if (Rope_Add(&r, 1, &buffer) != 0) {flag = 1;}
+
+    // Push, then insert in the middle over and over.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        Rope_Push(&r, &i);
+        expected[length++] = i;
+    }
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int index = (i * 7919) % (length + 1);
+        int element = -i;
+        if (Rope_Add(&r, index, &element) != 1) {flag = 1;}
+        memmove(expected + index + 1, expected + index, (length - index) * sizeof(int));
+        expected[index] = element;
+        length++;
+    }
+    if (Rope_Length(&r) != length) {flag = 1;}
+
+    // Check the contents element by element.
+    for (int i = 0; i < length; i++) {
+        if (Rope_Get(&r, i, &buffer) != 1 || buffer != expected[i]) {flag = 1;}
+    }
+    if (Rope_Get(&r, length, &buffer) != 0) {flag = 1;}
+    if (Rope_Get(&r, -1, &buffer) != 0) {flag = 1;}
+    if (Rope_Get(&r, 0, NULL) != 0) {flag = 1;}
+
+    // Check the contents chunk by chunk.
+    int count;
+    int seen = 0;
+    for (int i = 0; i < length; i += count) {
+        int* elements = Rope_Chunk(&r, i, &count);
+        if (count < 1 || memcmp(elements, expected + i, count * sizeof(int)) != 0) {flag = 1;}
+        seen += count;
+    }
+    if (seen != length) {flag = 1;}
+    if (Rope_Chunk(&r, length, &count) != NULL || count != 0) {flag = 1;}
+
+    // Full chunks are split in half, so the chunks stay at least half full.
+    if (length < chunks(&r) * r.chunk / 2) {flag = 1;}
+
+    // Remove from scattered positions.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int index = (i * 104729) % length;
+        if (Rope_Remove(&r, index) != 1) {flag = 1;}
+        memmove(expected + index, expected + index + 1, (length - index - 1) * sizeof(int));
+        length--;
+    }
+    if (Rope_Length(&r) != length) {flag = 1;}
+    for (int i = 0; i < length; i++) {
+        if (Rope_Get(&r, i, &buffer) != 1 || buffer != expected[i]) {flag = 1;}
+    }
+
+    // Chunks which run low are joined with their neighbours.
+    if (length < chunks(&r) * r.chunk / 4) {flag = 1;}
+
+    // Overwrite every element.
+    for (int i = 0; i < length; i++) {
+        int element = i * 3;
+        if (Rope_Set(&r, i, &element) != 1) {flag = 1;}
+        expected[i] = element;
+    }
+    if (Rope_Set(&r, length, &buffer) != 0) {flag = 1;}
+
+    // Split the rope in three and join it back up in a different order.
+    Rope middle;
+    Rope right;
+    if (Rope_Split(&r, length + 1, &right) != 0) {flag = 1;}
+    if (Rope_Split(&r, 2000, &right) != 1) {flag = 1;}
+    if (Rope_Split(&r, 1000, &middle) != 1) {flag = 1;}
+    if (Rope_Length(&r) != 1000 || Rope_Length(&middle) != 1000 || Rope_Length(&right) != length - 2000) {flag = 1;}
+
+    if (Rope_Concat(&right, &r) != 1) {flag = 1;}
+    if (Rope_Concat(&right, &middle) != 1) {flag = 1;}
+    if (Rope_Length(&r) != 0 || Rope_Length(&middle) != 0) {flag = 1;}
+    if (Rope_Length(&right) != length) {flag = 1;}
+
+    for (int i = 0; i < length; i++) {
+        int index = i < length - 2000 ? i + 2000 : i - (length - 2000);
+        if (Rope_Get(&right, i, &buffer) != 1 || buffer != expected[index]) {flag = 1;}
+    }
+
+    // Ropes of different element sizes cannot be joined.
+    Rope other;
+    Rope_Init(&other, sizeof(double));
+    if (Rope_Concat(&right, &other) != 0) {flag = 1;}
+
+    // Clear the rope
+    Rope_Clear(&right);
+    if (Rope_Length(&right) != 0) {flag = 1;}
+
+    Rope_Free(&r);
+    Rope_Free(&middle);
+    Rope_Free(&right);
+    Rope_Free(&other);
+
+    // A large rope stays balanced, however it was filled: its depth is a small multiple of log2 of its chunks.
+    Rope_Init(&r, sizeof(int));
+    for (int i = 0; i < NUM_LARGE; i++) {Rope_Push(&r, &i);}
+    for (int i = 0; i < NUM_LARGE / 10; i++) {
+        int element = -1;
+        Rope_Add(&r, (int) ((i * 7919LL) % (Rope_Length(&r) + 1)), &element);
+    }
+    if (Rope_Length(&r) != NUM_LARGE + NUM_LARGE / 10) {flag = 1;}
+
+    int log2 = 0;
+    while ((1 << log2) < chunks(&r)) {log2++;}
+    if (depth(r.root) > 4 * log2) {flag = 1;}
+
+    int previous = -1;
+    for (int i = 0; i < Rope_Length(&r); i += 997) {
+        if (Rope_Get(&r, i, &buffer) != 1) {flag = 1;}
+        if (buffer >= 0 && buffer <= previous) {flag = 1;}
+        if (buffer >= 0) {previous = buffer;}
+    }
+    Rope_Free(&r);
+
+    free(expected);
+    return flag;
+}
@@ -0,0 +1,87 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdatomic.h>
+#include "threadpool.h"
+#include "list.h"
+
+#define NUM_TASKS 1000
+#define NUM_ELEMENTS 200000
+#define SHIFT (1LL << 20)
+
+atomic_int calls;
+int results[NUM_TASKS];
+
+void square(int index, void* arg) {
+    results[index] = index * index;
+    atomic_fetch_add(&calls, 1);
+}
+
+void nested(int index, void* arg) {
+    ThreadPool_ParallelFor(4, square, NULL);
+}
+
+int compare(const void* a, const void* b) {
+    long long x = *(const long long*) a;
+    long long y = *(const long long*) b;
+    return (x > y) - (x < y);
+}
+
+int main() {
+
+    int flag = 0;
+
+    // Test the thread count
+    ThreadPool_SetThreads(4);
+    if (ThreadPool_Threads() != 4) {flag = 1;}
+
+    // Every task runs exactly once.
+    atomic_init(&calls, 0);
+    ThreadPool_ParallelFor(NUM_TASKS, square, NULL);
+    if (atomic_load(&calls) != NUM_TASKS) {flag = 1;}
+    for (int i = 0; i < NUM_TASKS; i++) {
+        if (results[i] != i * i) {flag = 1;}
+    }
+
+    // The pool can be reused, and nested calls run in place.
+    atomic_store(&calls, 0);
+    ThreadPool_ParallelFor(8, nested, NULL);
+    if (atomic_load(&calls) != 32) {flag = 1;}
+
+    // Sort a list across the pool with both sorts.
+    List l;
+    List_Init(&l, sizeof(long long));
+    for (long long i = 0; i < NUM_ELEMENTS; i++) {
+        long long element = ((i * 7919) % NUM_ELEMENTS) * SHIFT;
+        List_Push(&l, &element);
+    }
+
+    List_Sort(&l, compare);
+    long long buffer;
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        List_Get(&l, i, &buffer);
+        if (buffer != (long long) i * SHIFT) {flag = 1;}
+    }
+
+    // Resizing the pool restarts the workers.
+    ThreadPool_SetThreads(3);
+    if (ThreadPool_Threads() != 3) {flag = 1;}
+
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        long long element = -(long long) i * SHIFT;
+        memcpy(List_Elements(&l)[i], &element, sizeof(long long));
+    }
+    List_SortIntegers(&l, 1);
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        List_Get(&l, i, &buffer);
+        if (buffer != (long long) (i - NUM_ELEMENTS + 1) * SHIFT) {flag = 1;}
+    }
+
+    // A single thread runs everything on the caller.
+    ThreadPool_SetThreads(1);
+    atomic_store(&calls, 0);
+    ThreadPool_ParallelFor(NUM_TASKS, square, NULL);
+    if (atomic_load(&calls) != NUM_TASKS) {flag = 1;}
+
+    List_Free(&l);
+    return flag;
+}
@@ -0,0 +1,66 @@
+#include <stdlib.h>
+#include "trace.h"
+#include "hashmap.h"
+#include "list.h"
+
+#define NUM_ELEMENTS 100000
+#define NUM_MOVES 100
+
+struct Counts {
+    int events[TRACE_EVENTS];
+    int bad;
+};
+
+void count(const TraceRecord* record, void* arg) {
+    struct Counts* counts = arg;
+    counts->events[record->event]++;
+    if (record->object == NULL) {counts->bad = 1;}
+    if (record->event == TRACE_HASHMAP_GROW && record->after <= record->before) {counts->bad = 1;}
+    if (record->event == TRACE_LIST_REALLOC && (record->after <= record->before || record->size > record->after)) {counts->bad = 1;}
+    if (record->event == TRACE_LIST_MEMMOVE && record->size < TRACE_MEMMOVE_BYTES) {counts->bad = 1;}
+}
+
+int main() {
+
+    // Watch every event
+    int flag = 0;
+    struct Counts counts = {{0}, 0};
+    for (int event = 0; event < TRACE_EVENTS; event++) {Trace_Register(event, count, &counts);}
+
+    // Grow a map and a list, and move the list's pointers around.
+    HashMap h;
+    HashMap_Init(&h, sizeof(int), sizeof(int));
+    List l;
+    List_Init(&l, sizeof(int));
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        HashMap_Put(&h, &i, &i);
+        List_Push(&l, &i);
+    }
+    for (int i = 0; i < NUM_MOVES; i++) {
+        List_Shift(&l, NULL);
+        List_Add(&l, 1, &i);
+    }
+
+    // Events only fire when they are compiled in.
+    if (Trace_Enabled()) {
+        if (counts.events[TRACE_HASHMAP_GROW] == 0 || counts.events[TRACE_LIST_REALLOC] == 0) {flag = 1;}
+        if (counts.events[TRACE_LIST_MEMMOVE] != 2 * NUM_MOVES) {flag = 1;}
+    }
+    else {
+        for (int event = 0; event < TRACE_EVENTS; event++) {
+            if (counts.events[event] != 0) {flag = 1;}
+        }
+    }
+    if (counts.bad) {flag = 1;}
+
+    // Nothing is counted once the functions are removed.
+    for (int event = 0; event < TRACE_EVENTS; event++) {Trace_Register(event, NULL, NULL);}
+    int grows = counts.events[TRACE_HASHMAP_GROW];
+    for (int i = NUM_ELEMENTS; i < 4 * NUM_ELEMENTS; i++) {HashMap_Put(&h, &i, &i);}
+    if (counts.events[TRACE_HASHMAP_GROW] != grows) {flag = 1;}
+
+    // Free the memory
+    HashMap_Free(&h);
+    List_Free(&l);
+    return flag;
+}
@@ -0,0 +1,140 @@
+#include <stdlib.h>
+#include "treemap.h"
+
+#define NUM_ELEMENTS 5000
+
+int compare(const void* a, const void* b) {
+    int x = *(const int*) a;
+    int y = *(const int*) b;
+    return (x > y) - (x < y);
+}
+
+int main() {
+
+    // Initialise the map
+    int flag = 0;
+    TreeMap t;
+    TreeMap_Init(&t, sizeof(int), sizeof(int), compare);
+
+    // Empty maps have no elements to iterate.
+    TreeMapIterator it = TreeMap_First(&t);
+    if (TreeMapIterator_Valid(&it)) {flag = 1;}
+
+    // Put the even keys in a scrambled order.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int key = ((i * 7919) % NUM_ELEMENTS) * 2;
+        int value = key * 3;
+        TreeMap_Put(&t, &key, &value);
+        if (TreeMap_Size(&t) != i+1) {flag = 1;}
+    }
+
+    // Update a value in place.
+    int key = 10;
+    int value = -1;
+    TreeMap_Put(&t, &key, &value);
+    if (TreeMap_Size(&t) != NUM_ELEMENTS) {flag = 1;}
+    if (TreeMap_Get(&t, &key, &value) != 1 || value != -1) {flag = 1;}
+    value = 30;
+    TreeMap_Put(&t, &key, &value);
+
+    // Iterate the whole map, which should be in order.
+    int k = 0;
+    for (it = TreeMap_First(&t); TreeMapIterator_Valid(&it); TreeMapIterator_Next(&it)) {
+        if (*(int*) TreeMapIterator_Key(&it) != k) {flag = 1;}
+        if (*(int*) TreeMapIterator_Value(&it) != k * 3) {flag = 1;}
+        k += 2;
+    }
+    if (k != NUM_ELEMENTS * 2) {flag = 1;}
+
+    // Odd keys are not in the map.
+    for (int i = 1; i < NUM_ELEMENTS * 2; i += 2) {
+        int buffer;
+        if (TreeMap_Get(&t, &i, &buffer) != 0) {flag = 1;}
+    }
+    if (TreeMap_Get(&t, &key, NULL) != 0) {flag = 1;}
+
+    // Test the bounds.
+    key = 101;
+    it = TreeMap_LowerBound(&t, &key);
+    if (!TreeMapIterator_Valid(&it) || *(int*) TreeMapIterator_Key(&it) != 102) {flag = 1;}
+    key = 102;
+    it = TreeMap_LowerBound(&t, &key);
+    if (!TreeMapIterator_Valid(&it) || *(int*) TreeMapIterator_Key(&it) != 102) {flag = 1;}
+    it = TreeMap_UpperBound(&t, &key);
+    if (!TreeMapIterator_Valid(&it) || *(int*) TreeMapIterator_Key(&it) != 104) {flag = 1;}
+    key = NUM_ELEMENTS * 2 - 2;
+    it = TreeMap_UpperBound(&t, &key);
+    if (TreeMapIterator_Valid(&it)) {flag = 1;}
+    key = -5;
+    it = TreeMap_LowerBound(&t, &key);
+    if (!TreeMapIterator_Valid(&it) || *(int*) TreeMapIterator_Key(&it) != 0) {flag = 1;}
+
+    // Count the keys in the range [1000, 2000).
+    int low = 1000;
+    int count = 0;
+    for (it = TreeMap_LowerBound(&t, &low); TreeMapIterator_Valid(&it) && *(int*) TreeMapIterator_Key(&it) < 2000; TreeMapIterator_Next(&it)) {count++;}
+    if (count != 500) {flag = 1;}
+
+    // Remove every key which is a multiple of four.
+    for (int i = 0; i < NUM_ELEMENTS * 2; i += 4) {
+        if (TreeMap_Remove(&t, &i) != 1) {flag = 1;}
+        if (TreeMap_Remove(&t, &i) != 0) {flag = 1;}
+    }
+    if (TreeMap_Size(&t) != NUM_ELEMENTS / 2) {flag = 1;}
+
+    k = 2;
+    for (it = TreeMap_First(&t); TreeMapIterator_Valid(&it); TreeMapIterator_Next(&it)) {
+        if (*(int*) TreeMapIterator_Key(&it) != k) {flag = 1;}
+        k += 4;
+    }
+
+    // Remove everything that is left, in reverse.
+    for (int i = NUM_ELEMENTS * 2 - 2; i >= 0; i -= 4) {
+        if (TreeMap_Remove(&t, &i) != 1) {flag = 1;}
+    }
+    if (TreeMap_Size(&t) != 0) {flag = 1;}
+    it = TreeMap_First(&t);
+    if (TreeMapIterator_Valid(&it)) {flag = 1;}
+
+    // Bulk load sorted arrays.
+    int keys[NUM_ELEMENTS];
+    int values[NUM_ELEMENTS];
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        keys[i] = i * 3;
+        values[i] = i;
+    }
+
+    TreeMap_Clear(&t);
+    if (TreeMap_Load(&t, keys, values, NUM_ELEMENTS) != 1) {flag = 1;}
+    if (TreeMap_Load(&t, keys, values, NUM_ELEMENTS) != 0) {flag = 1;}
+    if (TreeMap_Size(&t) != NUM_ELEMENTS) {flag = 1;}
+
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        int buffer;
+        key = i * 3;
+        if (TreeMap_Get(&t, &key, &buffer) != 1 || buffer != i) {flag = 1;}
+    }
+
+    // The loaded tree must keep working after further changes.
+    for (int i = 0; i < NUM_ELEMENTS; i++) {
+        key = i * 3 + 1;
+        TreeMap_Put(&t, &key, &i);
+        key = i * 3;
+        TreeMap_Remove(&t, &key);
+    }
+    k = 1;
+    for (it = TreeMap_First(&t); TreeMapIterator_Valid(&it); TreeMapIterator_Next(&it)) {
+        if (*(int*) TreeMapIterator_Key(&it) != k) {flag = 1;}
+        k += 3;
+    }
+    if (k != NUM_ELEMENTS * 3 + 1) {flag = 1;}
+
+    // Unsorted input is rejected.
+    TreeMap_Clear(&t);
+    keys[10] = keys[9];
+    if (TreeMap_Load(&t, keys, values, NUM_ELEMENTS) != 0) {flag = 1;}
+    if (TreeMap_Size(&t) != 0) {flag = 1;}
+
+    TreeMap_Free(&t);
+    return flag;
+}